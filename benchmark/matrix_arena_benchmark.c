@@ -0,0 +1,130 @@
+/**
+ * @file matrix_arena_benchmark.c
+ *
+ * @brief Compares the cost of Matrix churn (creating and destroying
+ * many temporary matrices per request) between the heap path
+ * (matrix_create_with() / matrix_free()) and the Arena path
+ * (matrix_create_with_arena() / arena_reset()).
+ *
+ * @details
+ * Each request creates <Temporaries> zero matrices of dimension
+ * <Dimension_Size> x <Dimension_Size>, touches one element in each and
+ * then releases them. The output is a CSV line per path with the
+ * average time per request, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_arena.h"
+#include "../src/shared/matrix_utils.h"
+
+/**
+ * @brief Run the requests using matrix_create_with() and matrix_free().
+ *
+ * @return The average time per request in seconds, or -1 if an error occured.
+ */
+double run_heap(size_t NUM_REQUESTS, size_t NUM_TEMPORARIES, size_t dim) {
+
+    Matrix* temporaries[NUM_TEMPORARIES];
+    double checksum = 0.0;
+
+    double start = now_seconds();
+    for (size_t r = 0; r < NUM_REQUESTS; r++) {
+        for (size_t t = 0; t < NUM_TEMPORARIES; t++) {
+            temporaries[t] = matrix_create_with(pattern_zero, NULL, dim, dim);
+            if (!temporaries[t]) {
+                return -1;
+            }
+            temporaries[t]->values[0] = t;
+        }
+        for (size_t t = 0; t < NUM_TEMPORARIES; t++) {
+            checksum += temporaries[t]->values[0];
+            matrix_free(temporaries[t]);
+        }
+    }
+    double end = now_seconds();
+
+    // Prevent the compiler from removing the work
+    if (checksum < 0) { printf("%f\n", checksum); }
+
+    return (end - start) / NUM_REQUESTS;
+}
+
+/**
+ * @brief Run the requests using matrix_create_with_arena() and a
+ * single arena_reset() at the end of each request.
+ *
+ * @return The average time per request in seconds, or -1 if an error occured.
+ */
+double run_arena(size_t NUM_REQUESTS, size_t NUM_TEMPORARIES, size_t dim) {
+
+    Matrix* temporaries[NUM_TEMPORARIES];
+    double checksum = 0.0;
+
+    // Size the first slab for a whole request
+    Arena* a = arena_create(NUM_TEMPORARIES * (sizeof(double) * dim * dim + 2 * ARENA_ALIGNMENT));
+    if (!a) {
+        return -1;
+    }
+
+    double start = now_seconds();
+    for (size_t r = 0; r < NUM_REQUESTS; r++) {
+        for (size_t t = 0; t < NUM_TEMPORARIES; t++) {
+            temporaries[t] = matrix_create_with_arena(a, pattern_zero, NULL, dim, dim);
+            if (!temporaries[t]) {
+                arena_free(a);
+                return -1;
+            }
+            temporaries[t]->values[0] = t;
+        }
+        for (size_t t = 0; t < NUM_TEMPORARIES; t++) {
+            checksum += temporaries[t]->values[0];
+        }
+        arena_reset(a);
+    }
+    double end = now_seconds();
+
+    arena_free(a);
+
+    // Prevent the compiler from removing the work
+    if (checksum < 0) { printf("%f\n", checksum); }
+
+    return (end - start) / NUM_REQUESTS;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Temporaries> <Requests>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t DIMENSION_SIZE = atoi(argv[1]);
+    const size_t NUM_TEMPORARIES = atoi(argv[2]);
+    const size_t NUM_REQUESTS = atoi(argv[3]);
+    if (DIMENSION_SIZE == 0 || NUM_TEMPORARIES == 0 || NUM_REQUESTS == 0) {
+        fprintf(stderr, "%s\n", "Error: All arguments have to be non-zero integers");
+        return 1;
+    }
+
+    // Warm-up both paths before measuring
+    run_heap(1, NUM_TEMPORARIES, DIMENSION_SIZE);
+    run_arena(1, NUM_TEMPORARIES, DIMENSION_SIZE);
+
+    double heap_time = run_heap(NUM_REQUESTS, NUM_TEMPORARIES, DIMENSION_SIZE);
+    double arena_time = run_arena(NUM_REQUESTS, NUM_TEMPORARIES, DIMENSION_SIZE);
+    if (heap_time < 0 || arena_time < 0) {
+        fprintf(stderr, "%s\n", "Error: Matrix allocation failed during benchmark");
+        return 1;
+    }
+
+    printf("Path,Dimension,Temporaries,Average Time per Request (seconds)\n");
+    printf("HEAP,%zu,%zu,%.10f\n", DIMENSION_SIZE, NUM_TEMPORARIES, heap_time);
+    printf("ARENA,%zu,%zu,%.10f\n", DIMENSION_SIZE, NUM_TEMPORARIES, arena_time);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file matrix_bit_benchmark.c
+ *
+ * @brief Compares the bit-packed boolean products against the double
+ * path on equivalent inputs (0.0 / 1.0 matrices of the same pattern):
+ * - OR_AND: matrix_multithread_mult_bit() against
+ *   matrix_multithread_mult_semiring() with SEMIRING_OR_AND.
+ * - COUNT: matrix_multithread_count_bit() against the MULTITHREAD_9AVX
+ *   kernel (the counts are the usual product of the 0/1 matrices).
+ *
+ * @details
+ * Each time is of a single multiplication after a warm-up run, the
+ * conversions are not included. The memory of the three matrices is
+ * reported for both paths. The output is CSV, which makes it easy to
+ * append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_bit.h"
+#include "../src/shared/matrix_quant.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_bit.h"
+#include "../src/cpu/matrix_multithread_semiring.h"
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 6) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Density_Percent> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int density = atoi(argv[2]);
+    const int seed = atoi(argv[3]);
+    const size_t BLOCK_SIZE = atoi(argv[4]);
+    const size_t NUM_THREADS = atoi(argv[5]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    // 0/1 matrices with about density percent ones
+    Matrix* A = matrix_create_with(pattern_zero, NULL, n, n);
+    Matrix* B = matrix_create_with(pattern_zero, NULL, n, n);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A->values[i * A->stride + j] = (rand() % 100 < density);
+            B->values[i * B->stride + j] = (rand() % 100 < density);
+        }
+    }
+
+    MatrixBit* A_bit = matrix_to_bit(A);
+    MatrixBit* B_bit = matrix_to_bit(B);
+    MatrixBit* C_bit = matrix_bit_create(n, n);
+    MatrixInt32* C_count = matrix_int32_create(n, n);
+    if (!A_bit || !B_bit || !C_bit || !C_count) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the bit matrices failed");
+        return 1;
+    }
+
+    size_t double_bytes = 3 * sizeof(double) * n * C->stride;
+    size_t bit_bytes = 3 * sizeof(uint64_t) * n * C_bit->stride;
+    size_t count_bytes = 2 * sizeof(uint64_t) * n * C_bit->stride + sizeof(int32_t) * n * n;
+    Semiring or_and = semiring_get(SEMIRING_OR_AND);
+
+    printf("Product,Dimension,Density (%%),Threads,Double Time (seconds),Bit Time (seconds),Speedup,Double Bytes,Bit Bytes\n");
+    for (int product = 0; product < 2; product++) {
+
+        // Warm-up and measured run of the double path
+        double double_time = 0.0;
+        for (int run = 0; run < 2; run++) {
+            for (size_t i = 0; i < n * C->stride; i++) {
+                C->values[i] = 0.0;
+            }
+            double start = now_seconds();
+            if (product == 0) {
+                matrix_multithread_mult_semiring(A, B, C, or_and, BLOCK_SIZE, NUM_THREADS);
+            } else {
+                matrix_multithread_mult_9avx(A, B, C, BLOCK_SIZE, NUM_THREADS);
+            }
+            double_time = now_seconds() - start;
+        }
+
+        // Warm-up and measured run of the bit path
+        double bit_time = 0.0;
+        for (int run = 0; run < 2; run++) {
+            for (size_t i = 0; i < n * C_bit->stride; i++) {
+                C_bit->words[i] = 0;
+            }
+            double start = now_seconds();
+            if (product == 0) {
+                matrix_multithread_mult_bit(A_bit, B_bit, C_bit, BLOCK_SIZE, NUM_THREADS);
+            } else {
+                matrix_multithread_count_bit(A_bit, B_bit, C_count, BLOCK_SIZE, NUM_THREADS);
+            }
+            bit_time = now_seconds() - start;
+        }
+
+        printf("%s,%zu,%d,%zu,%.10f,%.10f,%.4f,%zu,%zu\n", product == 0 ? "OR_AND" : "COUNT", n, density,
+               NUM_THREADS, double_time, bit_time, double_time / bit_time, double_bytes,
+               product == 0 ? bit_bytes : count_bytes);
+    }
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+    matrix_bit_free(A_bit);
+    matrix_bit_free(B_bit);
+    matrix_bit_free(C_bit);
+    matrix_int32_free(C_count);
+
+    return 0;
+}
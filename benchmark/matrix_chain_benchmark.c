@@ -0,0 +1,130 @@
+/**
+ * @file matrix_chain_benchmark.c
+ *
+ * @brief Compares a chain of mixed shapes, A1 (n x n), A2 (n x 8),
+ * A3 (8 x n) and A4 (n x 8), multiplied from left to right against the
+ * orders planned by matrix_chain_plan() with FLOPs and with the
+ * throughput measured by matrix_chain_calibrate() as the cost.
+ *
+ * @details
+ * The left to right order forms the n x n intermediate (A1 A2) A3 and
+ * takes about three times the operations of A1 (A2 (A3 A4)), which only
+ * forms thin intermediates. Each time is the minimum over NUM_RUNS runs
+ * after a warm-up run, with the Arena reset between the runs. The output
+ * is CSV, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_arena.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_chain.h"
+
+// The number of measured runs per order
+#define NUM_RUNS 3
+
+// The number of matrices in the chain and their thin dimension
+#define NUM_MATRICES 4
+#define THIN_SIZE 8
+
+/**
+ * @brief Time the chain into a zeroed C in the order of the plan, the
+ * minimum over NUM_RUNS runs after a warm-up run.
+ *
+ * @return The time in seconds.
+ */
+double time_chain(Matrix** matrices, Matrix* C, ChainPlan* plan, Arena* workspace, size_t block_size,
+                  size_t NUM_THREADS) {
+
+    double best = -1.0;
+    for (int run = 0; run <= NUM_RUNS; run++) {
+        memset(C->values, 0, sizeof(double) * C->num_rows * C->stride);
+        double start = now_seconds();
+        matrix_multithread_mult_chain(matrices, NUM_MATRICES, C, plan, workspace, block_size, NUM_THREADS);
+        double time = now_seconds() - start;
+        arena_reset(workspace);
+
+        // The first run is the warm-up
+        if (run > 0 && (best < 0.0 || time < best)) {
+            best = time;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* matrices[NUM_MATRICES] = {
+        generate_matrix(-10.0, 10.0, n, n),
+        generate_matrix(-10.0, 10.0, n, THIN_SIZE),
+        generate_matrix(-10.0, 10.0, THIN_SIZE, n),
+        generate_matrix(-10.0, 10.0, n, THIN_SIZE),
+    };
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, THIN_SIZE);
+    Arena* workspace = arena_create(1 << 20);
+    ChainThroughput throughput;
+    if (!matrices[0] || !matrices[1] || !matrices[2] || !matrices[3] || !C || !workspace ||
+        matrix_chain_calibrate(&throughput, BLOCK_SIZE, NUM_THREADS) != 0) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices or the calibration failed");
+        return 1;
+    }
+
+    // The left to right order is the plan that always splits off the last Matrix
+    ChainPlan* naive = matrix_chain_plan(matrices, NUM_MATRICES, NULL);
+    for (size_t j = 1; j < NUM_MATRICES; j++) {
+        naive->split[0 * NUM_MATRICES + j] = j - 1;
+    }
+    ChainPlan* flops_plan = matrix_chain_plan(matrices, NUM_MATRICES, NULL);
+    ChainPlan* measured_plan = matrix_chain_plan(matrices, NUM_MATRICES, &throughput);
+
+    matrix_chain_plan_print(flops_plan);
+    matrix_chain_plan_print(measured_plan);
+
+    const char* names[3] = {"Left to right", "FLOPs plan", "Measured plan"};
+    ChainPlan* plans[3] = {naive, flops_plan, measured_plan};
+    double naive_time = 0.0;
+
+    printf("Order,Dimension,Block Size,Threads,FLOPs,Time (seconds),Speedup\n");
+    for (size_t o = 0; o < 3; o++) {
+        double time = time_chain(matrices, C, plans[o], workspace, BLOCK_SIZE, NUM_THREADS);
+        if (o == 0) {
+            naive_time = time;
+        }
+        double flops = (o == 0) ? plans[o]->naive_flops : plans[o]->planned_flops;
+        printf("%s,%zu,%zu,%zu,%.0f,%.10f,%.4f\n", names[o], n, BLOCK_SIZE, NUM_THREADS, flops, time,
+               naive_time / time);
+    }
+
+    for (size_t o = 0; o < 3; o++) {
+        matrix_chain_plan_free(plans[o]);
+    }
+    for (size_t i = 0; i < NUM_MATRICES; i++) {
+        matrix_free(matrices[i]);
+    }
+    matrix_free(C);
+    arena_free(workspace);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file matrix_expr_benchmark.c
+ *
+ * @brief Compares expressions of n x n matrices evaluated step by step
+ * (a new Matrix from matrix_create_with(pattern_zero, ...) per operation)
+ * against the lazy evaluation of matrix_multithread_eval_expr():
+ * - alpha * (A x B) + C x D + bias (fused into a single pass)
+ * - (A x B) x (C x D) (independent products)
+ * - (((A x B) x C) x D) x A (a reused intermediate Matrix)
+ *
+ * @details
+ * Both evaluations use the MULTITHREAD_9AVX kernel for the products.
+ * Each time is the minimum over NUM_RUNS runs after a warm-up run. The
+ * allocations and memory passes are the ones counted by the ExprGraph.
+ * The output is CSV, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_arena.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_expr.h"
+
+// The number of measured runs per evaluation
+#define NUM_RUNS 3
+
+// The number of expressions
+#define NUM_EXPRESSIONS 3
+
+/**
+ * @brief Evaluate a node step by step, each operation into a new Matrix.
+ *
+ * @return The value of the node (the Matrix itself for an input).
+ */
+Matrix* eval_step_by_step(ExprNode* node, size_t block_size, size_t NUM_THREADS) {
+
+    if (node->op == EXPR_INPUT) {
+        return node->value;
+    }
+
+    Matrix* left = eval_step_by_step(node->left, block_size, NUM_THREADS);
+    Matrix* right = node->right ? eval_step_by_step(node->right, block_size, NUM_THREADS) : NULL;
+    Matrix* R = matrix_create_with(pattern_zero, NULL, node->num_rows, node->num_cols);
+
+    if (node->op == EXPR_MULT) {
+        matrix_multithread_mult_9avx(left, right, R, block_size, NUM_THREADS);
+    } else {
+        for (size_t i = 0; i < R->num_rows; i++) {
+            for (size_t j = 0; j < R->num_cols; j++) {
+                double value = left->values[i * left->stride + j];
+                if (node->op == EXPR_ADD) {
+                    value += right->values[i * right->stride + j];
+                } else if (node->op == EXPR_ADD_ROW) {
+                    value += right->values[j];
+                } else {
+                    value *= node->scalar;
+                }
+                R->values[i * R->stride + j] = value;
+            }
+        }
+    }
+
+    if (node->left->op != EXPR_INPUT) {
+        matrix_free(left);
+    }
+    if (right && node->right->op != EXPR_INPUT) {
+        matrix_free(right);
+    }
+    return R;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* B = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* C = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* D = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* bias = generate_matrix(-10.0, 10.0, 1, n);
+    Matrix* result = matrix_create_with(pattern_zero, NULL, n, n);
+    Arena* workspace = arena_create(1 << 20);
+    ExprGraph* g = expr_graph_create();
+    if (!A || !B || !C || !D || !bias || !result || !workspace || !g) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    ExprNode* a = expr_input(g, A);
+    ExprNode* b = expr_input(g, B);
+    ExprNode* c = expr_input(g, C);
+    ExprNode* d = expr_input(g, D);
+    ExprNode* r = expr_input(g, bias);
+
+    const char* names[NUM_EXPRESSIONS] = {"alpha*(A*B)+C*D+bias", "(A*B)*(C*D)", "(((A*B)*C)*D)*A"};
+    ExprNode* roots[NUM_EXPRESSIONS] = {
+        expr_add_row(g, expr_add(g, expr_scale(g, 0.5, expr_mult(g, a, b)), expr_mult(g, c, d)), r),
+        expr_mult(g, expr_mult(g, a, b), expr_mult(g, c, d)),
+        expr_mult(g, expr_mult(g, expr_mult(g, expr_mult(g, a, b), c), d), a),
+    };
+
+    printf("Expression,Dimension,Block Size,Threads,Step Allocations,Step Passes,Lazy Allocations,"
+           "Lazy Reused,Lazy Passes,Levels,Step Time (seconds),Lazy Time (seconds),Speedup\n");
+    for (size_t e = 0; e < NUM_EXPRESSIONS; e++) {
+
+        double step_time = -1.0;
+        double lazy_time = -1.0;
+        for (int run = 0; run <= NUM_RUNS; run++) {
+            double start = now_seconds();
+            Matrix* step = eval_step_by_step(roots[e], BLOCK_SIZE, NUM_THREADS);
+            double time = now_seconds() - start;
+            matrix_free(step);
+
+            // The first run is the warm-up
+            if (run > 0 && (step_time < 0.0 || time < step_time)) {
+                step_time = time;
+            }
+
+            memset(result->values, 0, sizeof(double) * n * result->stride);
+            start = now_seconds();
+            matrix_multithread_eval_expr(g, roots[e], result, workspace, BLOCK_SIZE, NUM_THREADS);
+            time = now_seconds() - start;
+            arena_reset(workspace);
+
+            if (run > 0 && (lazy_time < 0.0 || time < lazy_time)) {
+                lazy_time = time;
+            }
+        }
+
+        printf("%s,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%.10f,%.10f,%.4f\n", names[e], n, BLOCK_SIZE, NUM_THREADS,
+               g->eager_allocations, g->eager_passes, g->allocations, g->reused, g->passes, g->levels,
+               step_time, lazy_time, step_time / lazy_time);
+    }
+
+    expr_graph_free(g);
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+    matrix_free(D);
+    matrix_free(bias);
+    matrix_free(result);
+    arena_free(workspace);
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file matrix_factor_benchmark.c
+ *
+ * @brief Reports the GFLOP/s of matrix_multithread_lu() and
+ * matrix_multithread_cholesky() next to the plain MULTITHREAD_9AVX
+ * multiply on the same n x n shape.
+ *
+ * @details
+ * The operations are counted as 2 * n^3 for the multiply, 2/3 * n^3
+ * for LU and 1/3 * n^3 for Cholesky. Each routine runs once on a fresh
+ * copy of its input (no warm-up, the factorizations overwrite their
+ * input). The output is CSV, see run_factor_benchmark.sh for the sweep
+ * over n.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_factor.h"
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads> [Print_Header]\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    const int print_header = (argc > 5) ? atoi(argv[5]) : 1;
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+2;
+    const double VALUES_MAX = 1e+2;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    size_t* pivots = malloc(n * sizeof(size_t));
+    if (!A || !B || !C || !pivots) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    if (print_header) {
+        printf("Routine,Dimension,Threads,Time (seconds),GFLOP/s\n");
+    }
+
+    // Plain multiply
+    double start = now_seconds();
+    matrix_multithread_mult_9avx(A, B, C, BLOCK_SIZE, NUM_THREADS);
+    double time = now_seconds() - start;
+    printf("MULTITHREAD_9AVX,%zu,%zu,%.10f,%.6f\n", n, NUM_THREADS, time, 2.0 * n * n * n / time * 1e-9);
+
+    // LU of A (overwritten)
+    start = now_seconds();
+    int result = matrix_multithread_lu(A, pivots, BLOCK_SIZE, NUM_THREADS);
+    time = now_seconds() - start;
+    if (result < 0) {
+        fprintf(stderr, "%s\n", "Error: LU failed");
+        return 1;
+    }
+    printf("LU,%zu,%zu,%.10f,%.6f\n", n, NUM_THREADS, time, 2.0 / 3.0 * n * n * n / time * 1e-9);
+
+    // Cholesky of the symmetric positive definite C = B + B^T + 2 * n * max|B| * I
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            C->values[i * C->stride + j] = B->values[i * B->stride + j] + B->values[j * B->stride + i];
+        }
+        C->values[i * C->stride + i] += 2.0 * n * VALUES_MAX;
+    }
+    start = now_seconds();
+    result = matrix_multithread_cholesky(C, BLOCK_SIZE, NUM_THREADS);
+    time = now_seconds() - start;
+    if (result != 0) {
+        fprintf(stderr, "%s\n", "Error: Cholesky failed");
+        return 1;
+    }
+    printf("CHOLESKY,%zu,%zu,%.10f,%.6f\n", n, NUM_THREADS, time, 1.0 / 3.0 * n * n * n / time * 1e-9);
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+    free(pivots);
+
+    return 0;
+}
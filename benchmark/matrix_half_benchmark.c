@@ -0,0 +1,140 @@
+/**
+ * @file matrix_half_benchmark.c
+ *
+ * @brief Compares the Matrix multiplication of 16-bit floating-point
+ * matrices (matrix_multithread_mult_half()) against the double
+ * MULTITHREAD_9AVX kernel on the same square shape.
+ *
+ * @details
+ * For each combination of format (bf16, fp16) and accumulation (fp32,
+ * fp64) the time of a single multiplication (after a warm-up run), the
+ * GFLOP/s, the bytes of A and B, the time to convert the inputs from
+ * double, and the largest error relative to the largest absolute value
+ * of the double product are reported. The output is CSV, which makes it
+ * easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_half.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_half.h"
+
+/**
+ * @brief Run the 16-bit kernel for one format and accumulation and
+ * print the CSV line.
+ *
+ * @return 0 for success, 1 if an error occured.
+ */
+int run_half(const char* name, Matrix* A, Matrix* B, Matrix* C_ref,
+             HalfFormat format, HalfAccumulation accumulation,
+             size_t BLOCK_SIZE, size_t NUM_THREADS) {
+
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+
+    double convert_start = now_seconds();
+    MatrixHalf* A_h = matrix_to_half(A, format);
+    MatrixHalf* B_h = matrix_to_half(B, format);
+    double convert_time = now_seconds() - convert_start;
+
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+    if (!A_h || !B_h || !C) {
+        fprintf(stderr, "Error: Allocation failed for %s\n", name);
+        return 1;
+    }
+
+    // Warm-up and measured run
+    matrix_multithread_mult_half(A_h, B_h, C, accumulation, BLOCK_SIZE, NUM_THREADS);
+    double mult_start = now_seconds();
+    matrix_multithread_mult_half(A_h, B_h, C, accumulation, BLOCK_SIZE, NUM_THREADS);
+    double mult_time = now_seconds() - mult_start;
+
+    // Largest error relative to the largest absolute value of the reference
+    double max_error = 0.0;
+    double max_value = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            double ref = C_ref->values[i * C_ref->stride + j];
+            double error = fabs(C->values[i * C->stride + j] - ref);
+            if (error > max_error) { max_error = error; }
+            if (fabs(ref) > max_value) { max_value = fabs(ref); }
+        }
+    }
+
+    size_t input_bytes = sizeof(uint16_t) * (A_h->num_rows * A_h->stride + B_h->num_rows * B_h->stride);
+    printf("%s,%zu,%zu,%.10f,%.6f,%zu,%.10f,%.6e\n", name, n, NUM_THREADS, mult_time,
+           2.0 * n * m * p / mult_time * 1e-9, input_bytes, convert_time,
+           (max_value > 0) ? max_error / max_value : 0.0);
+
+    matrix_half_free(A_h);
+    matrix_half_free(B_h);
+    matrix_free(C);
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t DIMENSION_SIZE = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (DIMENSION_SIZE == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const size_t n = DIMENSION_SIZE;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* C_ref = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C_ref) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    printf("Kernel,Dimension,Threads,Mult Time (seconds),GFLOP/s,Input Bytes,Convert Time (seconds),Max Relative Error\n");
+
+    // Double reference (also used for the error of the 16-bit kernels)
+    matrix_multithread_mult_9avx(A, B, C_ref, BLOCK_SIZE, NUM_THREADS);
+    for (size_t i = 0; i < n * C_ref->stride; i++) {
+        C_ref->values[i] = 0.0;
+    }
+    double mult_start = now_seconds();
+    matrix_multithread_mult_9avx(A, B, C_ref, BLOCK_SIZE, NUM_THREADS);
+    double mult_time = now_seconds() - mult_start;
+    printf("MULTITHREAD_9AVX,%zu,%zu,%.10f,%.6f,%zu,0,0\n", n, NUM_THREADS, mult_time,
+           2.0 * n * n * n / mult_time * 1e-9, sizeof(double) * (A->num_rows * A->stride + B->num_rows * B->stride));
+
+    if (run_half("HALF_BF16_FP32", A, B, C_ref, HALF_BF16, HALF_ACCUMULATE_FP32, BLOCK_SIZE, NUM_THREADS) != 0 ||
+        run_half("HALF_BF16_FP64", A, B, C_ref, HALF_BF16, HALF_ACCUMULATE_FP64, BLOCK_SIZE, NUM_THREADS) != 0 ||
+        run_half("HALF_FP16_FP32", A, B, C_ref, HALF_FP16, HALF_ACCUMULATE_FP32, BLOCK_SIZE, NUM_THREADS) != 0 ||
+        run_half("HALF_FP16_FP64", A, B, C_ref, HALF_FP16, HALF_ACCUMULATE_FP64, BLOCK_SIZE, NUM_THREADS) != 0) {
+        return 1;
+    }
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C_ref);
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file matrix_int_benchmark.c
+ *
+ * @brief Compares the integer Matrix multiplication of quantized
+ * matrices (matrix_multithread_mult_int()) against the double
+ * MULTITHREAD_9AVX kernel on the same square shape.
+ *
+ * @details
+ * For each kernel the time of a single multiplication (after a warm-up
+ * run) and the operations per second (2 * n^3 multiply-adds counted as
+ * two operations) are reported. For the integer kernels, the time to
+ * quantize the inputs and to dequantize the product is reported
+ * separately, together with the largest error of the dequantized
+ * product relative to the largest absolute value of the double product.
+ * The output is CSV, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_quant.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_int.h"
+
+/**
+ * @brief Determine the largest number of bits for QUANT_INT16 such that
+ * the int32 accumulators cannot overflow for the inner dimension m.
+ *
+ * @param m The inner dimension.
+ * @return The number of bits (2-16).
+ */
+int int16_safe_bits(size_t m) {
+
+    int bits = 16;
+    while (bits > 2) {
+        double max_value = (double)((1 << (bits - 1)) - 1);
+        if (max_value * max_value * m < 2147483647.0) {
+            break;
+        }
+        bits--;
+    }
+    return bits;
+}
+
+/**
+ * @brief Run the integer kernel for one type combination and print the
+ * CSV line.
+ *
+ * @return 0 for success, 1 if an error occured.
+ */
+int run_int(const char* name, Matrix* A, Matrix* B, Matrix* C_ref,
+            QuantType a_type, QuantType b_type, int bits,
+            size_t BLOCK_SIZE, size_t NUM_THREADS) {
+
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+
+    // Quantize (A per row, B per column)
+    double quantize_start = now_seconds();
+    QuantMatrix* A_q = matrix_quantize(A, a_type, QUANT_PER_ROW, (a_type == QUANT_UINT8) ? 7 : bits);
+    QuantMatrix* B_q = matrix_quantize(B, b_type, QUANT_PER_COL, (b_type == QUANT_INT8) ? 8 : bits);
+    double quantize_time = now_seconds() - quantize_start;
+
+    MatrixInt32* C_int = matrix_int32_create(n, p);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+    if (!A_q || !B_q || !C_int || !C) {
+        fprintf(stderr, "Error: Allocation failed for %s\n", name);
+        return 1;
+    }
+
+    // Warm-up and measured run
+    matrix_multithread_mult_int(A_q, B_q, C_int, BLOCK_SIZE, NUM_THREADS);
+    double mult_start = now_seconds();
+    matrix_multithread_mult_int(A_q, B_q, C_int, BLOCK_SIZE, NUM_THREADS);
+    double mult_time = now_seconds() - mult_start;
+
+    double dequantize_start = now_seconds();
+    matrix_dequantize_product(A_q, B_q, C_int, C);
+    double dequantize_time = now_seconds() - dequantize_start;
+
+    // Largest error relative to the largest absolute value of the reference
+    double max_error = 0.0;
+    double max_value = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            double ref = C_ref->values[i * C_ref->stride + j];
+            double error = fabs(C->values[i * C->stride + j] - ref);
+            if (error > max_error) { max_error = error; }
+            if (fabs(ref) > max_value) { max_value = fabs(ref); }
+        }
+    }
+
+    printf("%s,%zu,%zu,%.10f,%.6e,%.10f,%.10f,%.6e\n", name, n, NUM_THREADS, mult_time,
+           2.0 * n * m * p / mult_time, quantize_time, dequantize_time,
+           (max_value > 0) ? max_error / max_value : 0.0);
+
+    quant_matrix_free(A_q);
+    quant_matrix_free(B_q);
+    matrix_int32_free(C_int);
+    matrix_free(C);
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t DIMENSION_SIZE = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (DIMENSION_SIZE == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const size_t n = DIMENSION_SIZE;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* C_ref = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C_ref) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    printf("Kernel,Dimension,Threads,Mult Time (seconds),Ops/s,Quantize Time (seconds),Dequantize Time (seconds),Max Relative Error\n");
+
+    // Double reference (also used for the error of the integer kernels)
+    matrix_multithread_mult_9avx(A, B, C_ref, BLOCK_SIZE, NUM_THREADS);
+    for (size_t i = 0; i < n * C_ref->stride; i++) {
+        C_ref->values[i] = 0.0;
+    }
+    double mult_start = now_seconds();
+    matrix_multithread_mult_9avx(A, B, C_ref, BLOCK_SIZE, NUM_THREADS);
+    double mult_time = now_seconds() - mult_start;
+    printf("MULTITHREAD_9AVX,%zu,%zu,%.10f,%.6e,0,0,0\n", n, NUM_THREADS, mult_time,
+           2.0 * n * n * n / mult_time);
+
+    int bits = int16_safe_bits(n);
+    if (run_int("INT_U8_S8", A, B, C_ref, QUANT_UINT8, QUANT_INT8, 8, BLOCK_SIZE, NUM_THREADS) != 0 ||
+        run_int("INT_S16_S16", A, B, C_ref, QUANT_INT16, QUANT_INT16, bits, BLOCK_SIZE, NUM_THREADS) != 0) {
+        return 1;
+    }
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C_ref);
+
+    return 0;
+}
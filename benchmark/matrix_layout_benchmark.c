@@ -0,0 +1,127 @@
+/**
+ * @file matrix_layout_benchmark.c
+ *
+ * @brief Compares the MULTITHREAD_9AVX kernel on column-major operands
+ * against first copying them to row-major, for the four combinations of
+ * the layouts of A and B.
+ *
+ * @details
+ * The copy time (of the column-major operands to row-major) is included
+ * in the time of the copying path, since that is the cost the native
+ * access patterns avoid. Each time is the minimum over NUM_RUNS runs
+ * after a warm-up run. The output is CSV, which makes it easy to append
+ * to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+
+// The number of measured runs per path
+#define NUM_RUNS 3
+
+/**
+ * @brief Copy a Matrix of any of the two layouts into a new row-major Matrix.
+ */
+Matrix* copy_to_row_major(Matrix* M) {
+
+    Matrix* R = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    for (size_t j = 0; j < M->num_cols; j++) {
+        for (size_t i = 0; i < M->num_rows; i++) {
+            R->values[i * R->stride + j] = M->values[matrix_index(M, i, j)];
+        }
+    }
+    return R;
+}
+
+/**
+ * @brief Time a multiplication into a zeroed C, the minimum over
+ * NUM_RUNS runs after a warm-up run.
+ *
+ * @param copy true to copy the column-major operands to row-major first.
+ * @return The time in seconds.
+ */
+double time_mult(Matrix* A, Matrix* B, Matrix* C, bool copy, size_t block_size, size_t NUM_THREADS) {
+
+    double best = -1.0;
+    for (int run = 0; run <= NUM_RUNS; run++) {
+        memset(C->values, 0, sizeof(double) * C->num_rows * C->stride);
+        double start = now_seconds();
+        if (copy && (A->layout == MATRIX_COL_MAJOR || B->layout == MATRIX_COL_MAJOR)) {
+            Matrix* A_row = (A->layout == MATRIX_COL_MAJOR) ? copy_to_row_major(A) : A;
+            Matrix* B_row = (B->layout == MATRIX_COL_MAJOR) ? copy_to_row_major(B) : B;
+            matrix_multithread_mult_9avx(A_row, B_row, C, block_size, NUM_THREADS);
+            if (A_row != A) {
+                matrix_free(A_row);
+            }
+            if (B_row != B) {
+                matrix_free(B_row);
+            }
+        } else {
+            matrix_multithread_mult_9avx(A, B, C, block_size, NUM_THREADS);
+        }
+        double time = now_seconds() - start;
+
+        // The first run is the warm-up
+        if (run > 0 && (best < 0.0 || time < best)) {
+            best = time;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* B = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* A_col = matrix_to_col_major(A);
+    Matrix* B_col = matrix_to_col_major(B);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !A_col || !B_col || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    printf("Layout A,Layout B,Dimension,Block Size,Threads,Native Time (seconds),Copy Time (seconds),Speedup\n");
+    for (size_t combination = 0; combination < 4; combination++) {
+        Matrix* A_used = (combination & 1) ? A_col : A;
+        Matrix* B_used = (combination & 2) ? B_col : B;
+
+        double native_time = time_mult(A_used, B_used, C, false, BLOCK_SIZE, NUM_THREADS);
+        double copy_time = time_mult(A_used, B_used, C, true, BLOCK_SIZE, NUM_THREADS);
+
+        printf("%s,%s,%zu,%zu,%zu,%.10f,%.10f,%.4f\n", (combination & 1) ? "COL_MAJOR" : "ROW_MAJOR",
+               (combination & 2) ? "COL_MAJOR" : "ROW_MAJOR", n, BLOCK_SIZE, NUM_THREADS,
+               native_time, copy_time, copy_time / native_time);
+    }
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(A_col);
+    matrix_free(B_col);
+    matrix_free(C);
+
+    return 0;
+}
@@ -2,14 +2,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <unistd.h>
 #include "../src/shared/matrix.h"
 #include "../src/cpu/matrix_mult_naive.h"
 #include "../src/cpu/matrix_multithread.h"
 #include "../src/cpu/matrix_multithread_3avx.h"
 #include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_9avx_prefetch.h"
 #include "../src/cpu/matrix_singlethread.h"
 #include "../src/shared/matrix_utils.h"
+#include "../src/shared/perf_counter.h"
+#include "../src/shared/trace.h"
 
 // Algorithms to be tested
 typedef enum {
@@ -18,7 +21,11 @@ typedef enum {
     SINGLETHREAD,
     MULTITHREAD,
     MULTITHREAD_3AVX,
-    MULTITHREAD_9AVX
+    MULTITHREAD_9AVX,
+    MULTITHREAD_9AVX_CHECKED,
+    MULTITHREAD_9AVX_PREFETCH,
+    MULTITHREAD_9AVX_STREAM,
+    MULTITHREAD_9AVX_PREFETCH_STREAM
 } Algorithm;
 
 /**
@@ -39,13 +46,15 @@ typedef enum {
  * algorithm.
  * @param NUM_THREADS The number of threads to use with the
  * MULTITHREAD, MULTITHREAD_3AVX and MULTITHREAD_9AVX algorithm
+ * @param PREFETCH_DISTANCE The prefetch distance (in doubles) used by
+ * the MULTITHREAD_9AVX_PREFETCH variants.
  * @param n The number of rows in A.
  * @param m The number of columns in A.
  * @param p The number of columns in B.
  */
 void run_algorithm(Algorithm algo, Matrix* A, Matrix* B, Matrix* C,
                       double* C_blas, const size_t BLOCK_SIZE,
-                      const size_t NUM_THREADS,
+                      const size_t NUM_THREADS, const size_t PREFETCH_DISTANCE,
                       const size_t n, const size_t m, const size_t p) {
 
     switch (algo) {
@@ -67,6 +76,19 @@ void run_algorithm(Algorithm algo, Matrix* A, Matrix* B, Matrix* C,
         case MULTITHREAD_9AVX:
             matrix_multithread_mult_9avx(A, B, C, BLOCK_SIZE, NUM_THREADS);
             break;
+        case MULTITHREAD_9AVX_CHECKED:
+            // A single Freivalds trial to measure the guard overhead
+            matrix_multithread_mult_9avx_checked(A, B, C, BLOCK_SIZE, NUM_THREADS, 1);
+            break;
+        case MULTITHREAD_9AVX_PREFETCH:
+            matrix_multithread_mult_9avx_prefetch(A, B, C, BLOCK_SIZE, NUM_THREADS, PREFETCH_DISTANCE, false);
+            break;
+        case MULTITHREAD_9AVX_STREAM:
+            matrix_multithread_mult_9avx_prefetch(A, B, C, BLOCK_SIZE, NUM_THREADS, 0, true);
+            break;
+        case MULTITHREAD_9AVX_PREFETCH_STREAM:
+            matrix_multithread_mult_9avx_prefetch(A, B, C, BLOCK_SIZE, NUM_THREADS, PREFETCH_DISTANCE, true);
+            break;
     }
 }
 
@@ -86,6 +108,8 @@ void run_algorithm(Algorithm algo, Matrix* A, Matrix* B, Matrix* C,
  * algorithm.
  * @param NUM_THREADS The number of threads to use with the
  * MULTITHREAD, MULTITHREAD_3AVX and MULTITHREAD_9AVX algorithm.
+ * @param PREFETCH_DISTANCE The prefetch distance (in doubles) used by
+ * the MULTITHREAD_9AVX_PREFETCH variants.
  * @param n The number of rows in A.
  * @param m The number of columns in A.
  * @param p The number of columns in B.
@@ -93,7 +117,8 @@ void run_algorithm(Algorithm algo, Matrix* A, Matrix* B, Matrix* C,
 int warm_up(size_t WARM_UP_COUNT, Algorithm algo,
              const size_t DIMENSIONS_MIN, const size_t DIMENSIONS_MAX,
              const double VALUES_MIN, const double VALUES_MAX,
-             const size_t BLOCK_SIZE, const size_t NUM_THREADS) {
+             const size_t BLOCK_SIZE, const size_t NUM_THREADS,
+             const size_t PREFETCH_DISTANCE) {
 
     Matrix* C = NULL;
     double* C_blas = NULL;
@@ -138,7 +163,7 @@ int warm_up(size_t WARM_UP_COUNT, Algorithm algo,
         }
 
         // Run Matrix multiplication with the desired algorithm
-        run_algorithm(algo, A, B, C, C_blas, BLOCK_SIZE, NUM_THREADS, n, m, p);
+        run_algorithm(algo, A, B, C, C_blas, BLOCK_SIZE, NUM_THREADS, PREFETCH_DISTANCE, n, m, p);
 
         // Free the allocated data corresponding the run
         matrix_free(A);
@@ -153,6 +178,169 @@ int warm_up(size_t WARM_UP_COUNT, Algorithm algo,
     return 0;
 }
 
+// Maximum number of RAPL package and DRAM domains that are read
+#define RAPL_MAX_DOMAINS 16
+
+// A RAPL energy counter of the Linux powercap interface
+typedef struct {
+
+    // Path of the energy_uj file of the domain
+    char energy_path[128];
+
+    // true for a DRAM domain, false for a package domain
+    bool is_dram;
+
+    // The value at which the counter wraps around (in microjoules)
+    unsigned long long max_energy_uj;
+
+    // The counter value at rapl_counters_start()
+    unsigned long long start_uj;
+
+} RaplDomain;
+
+typedef struct {
+
+    RaplDomain domains[RAPL_MAX_DOMAINS];
+    size_t num_domains;
+
+} RaplCounters;
+
+/**
+ * @brief Read an unsigned integer from a sysfs file.
+ *
+ * @param path The path of the file.
+ * @param value Pointer to store the value in.
+ * @return 0 for success, -1 if the file could not be read.
+ */
+int rapl_read_value(const char* path, unsigned long long* value) {
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    int result = (fscanf(file, "%llu", value) == 1) ? 0 : -1;
+    fclose(file);
+    return result;
+}
+
+/**
+ * @brief Helper function to add the RAPL domain in directory dir if it is
+ * a package or DRAM domain with a readable energy counter.
+ *
+ * @param counters Pointer to the RaplCounters to add the domain to.
+ * @param dir The powercap directory of the domain.
+ */
+void rapl_add_domain(RaplCounters* counters, const char* dir) {
+
+    if (counters->num_domains == RAPL_MAX_DOMAINS) {
+        return;
+    }
+
+    // Package domains are called "package-N" and DRAM domains "dram"
+    char path[128];
+    char name[64] = "";
+    snprintf(path, sizeof(path), "%s/name", dir);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return;
+    }
+    int has_name = fscanf(file, "%63s", name) == 1;
+    fclose(file);
+    bool is_package = has_name && strncmp(name, "package", 7) == 0;
+    bool is_dram = has_name && strcmp(name, "dram") == 0;
+    if (!is_package && !is_dram) {
+        return;
+    }
+
+    RaplDomain* d = &counters->domains[counters->num_domains];
+    unsigned long long energy_uj;
+    snprintf(d->energy_path, sizeof(d->energy_path), "%s/energy_uj", dir);
+    snprintf(path, sizeof(path), "%s/max_energy_range_uj", dir);
+    // energy_uj is only readable by root on recent kernels
+    if (rapl_read_value(d->energy_path, &energy_uj) != 0 ||
+        rapl_read_value(path, &d->max_energy_uj) != 0) {
+        return;
+    }
+    d->is_dram = is_dram;
+    counters->num_domains++;
+}
+
+/**
+ * @brief Find the package and DRAM energy counters of the Linux powercap
+ * RAPL interface (/sys/class/powercap/intel-rapl:N and their
+ * subdomains intel-rapl:N:M).
+ *
+ * @param counters Pointer to the RaplCounters to fill.
+ * @return The number of readable domains, 0 if RAPL is not available.
+ */
+size_t rapl_counters_open(RaplCounters* counters) {
+
+    counters->num_domains = 0;
+
+    char dir[128];
+    for (int package = 0; package < RAPL_MAX_DOMAINS; package++) {
+
+        snprintf(dir, sizeof(dir), "/sys/class/powercap/intel-rapl:%d", package);
+        if (access(dir, F_OK) != 0) {
+            break;
+        }
+        rapl_add_domain(counters, dir);
+
+        // The DRAM domain is a subdomain of the package
+        for (int sub = 0; sub < RAPL_MAX_DOMAINS; sub++) {
+            snprintf(dir, sizeof(dir), "/sys/class/powercap/intel-rapl:%d:%d", package, sub);
+            if (access(dir, F_OK) != 0) {
+                break;
+            }
+            rapl_add_domain(counters, dir);
+        }
+    }
+
+    return counters->num_domains;
+}
+
+/**
+ * @brief Record the current value of every RAPL counter.
+ *
+ * @param counters Pointer to the RaplCounters.
+ */
+void rapl_counters_start(RaplCounters* counters) {
+
+    for (size_t i = 0; i < counters->num_domains; i++) {
+        rapl_read_value(counters->domains[i].energy_path, &counters->domains[i].start_uj);
+    }
+}
+
+/**
+ * @brief Compute the energy consumed since rapl_counters_start(),
+ * taking a single wrap around of each counter into account.
+ *
+ * @param counters Pointer to the RaplCounters.
+ * @param package_joules Pointer to store the package energy in.
+ * @param dram_joules Pointer to store the DRAM energy in.
+ */
+void rapl_counters_stop(RaplCounters* counters, double* package_joules, double* dram_joules) {
+
+    *package_joules = 0.0;
+    *dram_joules = 0.0;
+
+    for (size_t i = 0; i < counters->num_domains; i++) {
+
+        RaplDomain* d = &counters->domains[i];
+        unsigned long long end_uj = d->start_uj;
+        rapl_read_value(d->energy_path, &end_uj);
+
+        unsigned long long delta_uj = (end_uj >= d->start_uj) ?
+            end_uj - d->start_uj : d->max_energy_uj - d->start_uj + end_uj;
+
+        if (d->is_dram) {
+            *dram_joules += delta_uj * 1e-6;
+        } else {
+            *package_joules += delta_uj * 1e-6;
+        }
+    }
+}
+
 /**
  * @brief Determine if the input string str is a digit.
  *
@@ -183,7 +371,7 @@ int main(int argc, char* argv[]) {
 
     // Check for input algorithm existence
     if (argc < 6) {
-        fprintf(stderr, "Usage: %s <Algorithm> <Dimension_Size> <Seed> <Block_Size> <Warm-up>\n%s\n", argv[0], "Algorithm Options:\nBLAS\nNAIVE\nSINGLETHREAD\nMULTITHREAD\nMULTITHREAD_9AVX\nContent is stored in benchmark_time.txt");
+        fprintf(stderr, "Usage: %s <Algorithm> <Dimension_Size> <Seed> <Block_Size> <Warm-up> [Prefetch_Distance] [Huge_Pages] [Padded_Stride] [Trace_File] [Num_Threads]\n%s\n", argv[0], "Algorithm Options:\nBLAS\nNAIVE\nSINGLETHREAD\nMULTITHREAD\nMULTITHREAD_3AVX\nMULTITHREAD_9AVX\nMULTITHREAD_9AVX_CHECKED\nMULTITHREAD_9AVX_PREFETCH\nMULTITHREAD_9AVX_STREAM\nMULTITHREAD_9AVX_PREFETCH_STREAM\nContent is stored in benchmark_time.txt");
         return 1;
     }
 
@@ -201,6 +389,14 @@ int main(int argc, char* argv[]) {
         algo = MULTITHREAD_3AVX;
     } else if (strcmp(argv[1], "MULTITHREAD_9AVX") == 0) {
         algo = MULTITHREAD_9AVX;
+    } else if (strcmp(argv[1], "MULTITHREAD_9AVX_CHECKED") == 0) {
+        algo = MULTITHREAD_9AVX_CHECKED;
+    } else if (strcmp(argv[1], "MULTITHREAD_9AVX_PREFETCH") == 0) {
+        algo = MULTITHREAD_9AVX_PREFETCH;
+    } else if (strcmp(argv[1], "MULTITHREAD_9AVX_STREAM") == 0) {
+        algo = MULTITHREAD_9AVX_STREAM;
+    } else if (strcmp(argv[1], "MULTITHREAD_9AVX_PREFETCH_STREAM") == 0) {
+        algo = MULTITHREAD_9AVX_PREFETCH_STREAM;
     } else {
         // No valid algorithm was given as input
         fprintf(stderr, "Invalid algorithm inputted\n");
@@ -231,10 +427,58 @@ int main(int argc, char* argv[]) {
     // Convert input <Warm-up> to bool
     const bool use_warm_up = atoi(argv[5]) != 0;
 
+    // Retrieve the optional [Prefetch_Distance] (in doubles)
+    size_t INPUT_PREFETCH_DISTANCE = 64;
+    if (argc > 6) {
+        if (is_integer(argv[6]) != 0) {
+            fprintf(stderr, "%s\n", "Error: Input [Prefetch_Distance] is not a valid integer string");
+            return 1;
+        }
+        INPUT_PREFETCH_DISTANCE = atoi(argv[6]);
+    }
+
+    // Retrieve the optional [Huge_Pages] (1 for true or 0 for false)
+    bool use_huge_pages = false;
+    if (argc > 7) {
+        if (is_integer(argv[7]) != 0) {
+            fprintf(stderr, "%s\n", "Error: Input [Huge_Pages] has to be either 1 for true or 0 for false");
+            return 1;
+        }
+        use_huge_pages = atoi(argv[7]) != 0;
+    }
+    matrix_set_huge_pages(use_huge_pages);
+
+    // Retrieve the optional [Padded_Stride] (1 for true or 0 for false)
+    bool use_padded_stride = false;
+    if (argc > 8) {
+        if (is_integer(argv[8]) != 0) {
+            fprintf(stderr, "%s\n", "Error: Input [Padded_Stride] has to be either 1 for true or 0 for false");
+            return 1;
+        }
+        use_padded_stride = atoi(argv[8]) != 0;
+    }
+
+    // The BLAS wrapper assumes unpadded rows, so padding is not used for BLAS
+    matrix_set_padded_stride(use_padded_stride && algo != BLAS);
+
+    // Retrieve the optional [Trace_File] to dump a Chrome trace into
+    const char* trace_file = (argc > 9 && argv[9][0] != '\0') ? argv[9] : NULL;
+
+    // Retrieve the optional [Num_Threads] (used by the scaling study)
+    size_t INPUT_NUM_THREADS = 16;
+    if (argc > 10) {
+        if (is_integer(argv[10]) != 0 || atoi(argv[10]) <= 0) {
+            fprintf(stderr, "%s\n", "Error: Input [Num_Threads] has to be a positive integer");
+            return 1;
+        }
+        INPUT_NUM_THREADS = atoi(argv[10]);
+    }
+
     // Benchmark parameters
     const size_t WARM_UP_COUNT = 10;
     const size_t BLOCK_SIZE = INPUT_BLOCK_SIZE;
-    const size_t NUM_THREADS = 16;
+    const size_t NUM_THREADS = INPUT_NUM_THREADS;
+    const size_t PREFETCH_DISTANCE = INPUT_PREFETCH_DISTANCE;
     const char filename[] = "benchmark_time.txt";
 
     // Matrix generation parameters
@@ -254,7 +498,7 @@ int main(int argc, char* argv[]) {
     if (use_warm_up) {
 
         // Perform the warm-up
-        int result = warm_up(WARM_UP_COUNT, algo, DIMENSIONS_MIN, DIMENSIONS_MAX, VALUES_MIN, VALUES_MAX, BLOCK_SIZE, NUM_THREADS);
+        int result = warm_up(WARM_UP_COUNT, algo, DIMENSIONS_MIN, DIMENSIONS_MAX, VALUES_MIN, VALUES_MAX, BLOCK_SIZE, NUM_THREADS, PREFETCH_DISTANCE);
         if (result != 0) {
             fprintf(stderr, "Warm-up has failed\n");
             return 1;
@@ -297,8 +541,62 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Perform the Matrix multiplication
-    run_algorithm(algo, A, B, C, C_blas, BLOCK_SIZE, NUM_THREADS, n, m, p);
+    // Measure the energy of the multiplication only (if RAPL is available)
+    RaplCounters rapl;
+    size_t num_rapl_domains = rapl_counters_open(&rapl);
+
+    // Count the dTLB misses of the multiplication only
+    int dtlb_load_fd = perf_counter_open_cache_misses(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ);
+    int dtlb_store_fd = perf_counter_open_cache_misses(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_WRITE);
+
+    // Trace only the measured run (not the warm-up)
+    if (trace_file) {
+        trace_start(1 << 16);
+    }
+
+    // Perform the Matrix multiplication, the dTLB counters enclose nothing else
+    rapl_counters_start(&rapl);
+    perf_counter_start(dtlb_load_fd);
+    perf_counter_start(dtlb_store_fd);
+    double mult_start = now_seconds();
+    run_algorithm(algo, A, B, C, C_blas, BLOCK_SIZE, NUM_THREADS, PREFETCH_DISTANCE, n, m, p);
+    double mult_seconds = now_seconds() - mult_start;
+    long long dtlb_load_misses = perf_counter_stop(dtlb_load_fd);
+    long long dtlb_store_misses = perf_counter_stop(dtlb_store_fd);
+    double package_joules, dram_joules;
+    rapl_counters_stop(&rapl, &package_joules, &dram_joules);
+
+    if (trace_file) {
+        trace_stop();
+        trace_dump_chrome_json(trace_file);
+        trace_free();
+    }
+
+    // Report the time of the multiplication only (without Matrix generation)
+    printf("Threads             : %zu\n", NUM_THREADS);
+    printf("Mult Time (seconds) : %.9f\n", mult_seconds);
+
+    // Report the energy (n/a if RAPL is absent or not readable)
+    if (num_rapl_domains > 0) {
+        double joules = package_joules + dram_joules;
+        double gflop = 2.0 * n * m * p * 1e-9;
+        printf("Package Energy (J)  : %.6f\n", package_joules);
+        printf("DRAM Energy (J)     : %.6f\n", dram_joules);
+        printf("Energy (J)          : %.6f\n", joules);
+        printf("Average Power (W)   : %.6f\n", (mult_seconds > 0) ? joules / mult_seconds : 0.0);
+        printf("GFLOP/J             : %.6f\n", (joules > 0) ? gflop / joules : 0.0);
+    } else {
+        printf("Energy (J)          : n/a\n");
+        printf("Average Power (W)   : n/a\n");
+        printf("GFLOP/J             : n/a\n");
+    }
+
+    // Report the dTLB misses (-1 if the counter is not available)
+    printf("Huge Pages          : %d\n", use_huge_pages);
+    printf("dTLB-load-misses    : %lld\n", dtlb_load_misses);
+    printf("dTLB-store-misses   : %lld\n", dtlb_store_misses);
+    perf_counter_close(dtlb_load_fd);
+    perf_counter_close(dtlb_store_fd);
 
     // Free the generated matrices
     matrix_free(A);
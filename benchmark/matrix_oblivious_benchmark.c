@@ -0,0 +1,114 @@
+/**
+ * @file matrix_oblivious_benchmark.c
+ *
+ * @brief Compares matrix_multithread_mult_oblivious() against the
+ * MULTITHREAD_9AVX kernel with its best block size for the dimension.
+ *
+ * @details
+ * The block sizes of run_block_size_benchmark.sh are tried for
+ * MULTITHREAD_9AVX and the fastest is kept, which is the best case for
+ * the blocked kernel (a tuned block size). The cache-oblivious kernel
+ * has no block size. Each time is the minimum over NUM_RUNS runs after a
+ * warm-up run. The output is CSV, which makes it easy to append to a
+ * file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_oblivious.h"
+
+// The number of measured runs per kernel and block size
+#define NUM_RUNS 3
+
+/**
+ * @brief Time a multiplication into a zeroed C, the minimum over
+ * NUM_RUNS runs after a warm-up run.
+ *
+ * @param block_size The block size of MULTITHREAD_9AVX, 0 for the
+ * cache-oblivious kernel.
+ * @return The time in seconds.
+ */
+double time_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size, size_t NUM_THREADS) {
+
+    double best = -1.0;
+    for (int run = 0; run <= NUM_RUNS; run++) {
+        memset(C->values, 0, sizeof(double) * C->num_rows * C->stride);
+        double start = now_seconds();
+        if (block_size == 0) {
+            matrix_multithread_mult_oblivious(A, B, C, NUM_THREADS);
+        } else {
+            matrix_multithread_mult_9avx(A, B, C, block_size, NUM_THREADS);
+        }
+        double time = now_seconds() - start;
+
+        // The first run is the warm-up
+        if (run > 0 && (best < 0.0 || time < best)) {
+            best = time;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Num_Threads> [Print_Header]\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t NUM_THREADS = atoi(argv[3]);
+    const int print_header = (argc > 4) ? atoi(argv[4]) : 1;
+    if (n == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // The block sizes of run_block_size_benchmark.sh
+    const size_t block_sizes[] = {8, 16, 32, 64, 128, 200, 256};
+    const size_t num_block_sizes = sizeof(block_sizes) / sizeof(block_sizes[0]);
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* B = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    // The best block size of MULTITHREAD_9AVX
+    size_t best_block_size = 0;
+    double best_time = -1.0;
+    for (size_t b = 0; b < num_block_sizes; b++) {
+        double time = time_mult(A, B, C, block_sizes[b], NUM_THREADS);
+        if (best_time < 0.0 || time < best_time) {
+            best_time = time;
+            best_block_size = block_sizes[b];
+        }
+    }
+
+    double oblivious_time = time_mult(A, B, C, 0, NUM_THREADS);
+    double gflops = 2.0 * n * n * n * 1e-9;
+
+    if (print_header) {
+        printf("Dimension,Threads,Best 9AVX Block Size,9AVX Time (seconds),Oblivious Time (seconds),Speedup,9AVX GFLOP/s,Oblivious GFLOP/s\n");
+    }
+    printf("%zu,%zu,%zu,%.10f,%.10f,%.4f,%.4f,%.4f\n", n, NUM_THREADS, best_block_size, best_time,
+           oblivious_time, best_time / oblivious_time, gflops / best_time, gflops / oblivious_time);
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file matrix_semiring_benchmark.c
+ *
+ * @brief Compares matrix_multithread_mult_semiring() against the naive
+ * triple loop for the min-plus (shortest paths), max-times (most
+ * reliable paths) and or-and (reachability) semirings.
+ *
+ * @details
+ * The naive loop is the hand-rolled i, j, k loop with the scalar
+ * operations written out (no function pointers), compiled with the same
+ * flags. A quarter of the elements of A and B are the zero of the
+ * semiring (missing edges). Each time is of a single multiplication
+ * after a warm-up run (the naive loop is not warmed up). The output is
+ * CSV, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_semiring.h"
+
+/**
+ * @brief The naive triple loop C = C (+) A (x) B for the given semiring.
+ */
+void naive_semiring(SemiringType type, Matrix* A, Matrix* B, Matrix* C) {
+
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            double c_value = C->values[i * C->stride + j];
+            for (size_t k = 0; k < m; k++) {
+                double a = A->values[i * A->stride + k];
+                double b = B->values[k * B->stride + j];
+                if (type == SEMIRING_MIN_PLUS) {
+                    c_value = (a + b < c_value) ? a + b : c_value;
+                } else if (type == SEMIRING_MAX_TIMES) {
+                    c_value = (a * b > c_value) ? a * b : c_value;
+                } else {
+                    c_value = (c_value != 0.0 || (a != 0.0 && b != 0.0)) ? 1.0 : 0.0;
+                }
+            }
+            C->values[i * C->stride + j] = c_value;
+        }
+    }
+}
+
+/**
+ * @brief Set every element of M to value.
+ */
+void fill(Matrix* M, double value) {
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            M->values[i * M->stride + j] = value;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    const SemiringType types[] = {SEMIRING_MIN_PLUS, SEMIRING_MAX_TIMES, SEMIRING_OR_AND};
+    const char* names[] = {"MIN_PLUS", "MAX_TIMES", "OR_AND"};
+
+    printf("Semiring,Dimension,Threads,Naive Time (seconds),Kernel Time (seconds),Speedup\n");
+    for (size_t s = 0; s < 3; s++) {
+
+        Semiring semiring = semiring_get(types[s]);
+
+        // Random values in [1, 100] with a quarter of zeros (missing edges)
+        Matrix* A = generate_matrix(1, 100, n, n);
+        Matrix* B = generate_matrix(1, 100, n, n);
+        Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+        if (!A || !B || !C) {
+            fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+            return 1;
+        }
+        for (size_t i = 0; i < n * n; i++) {
+            if (rand() % 4 == 0) {
+                A->values[(i / n) * A->stride + i % n] = semiring.zero;
+            }
+            if (rand() % 4 == 0) {
+                B->values[(i / n) * B->stride + i % n] = semiring.zero;
+            }
+        }
+
+        fill(C, semiring.zero);
+        double start = now_seconds();
+        naive_semiring(types[s], A, B, C);
+        double naive_time = now_seconds() - start;
+
+        // Warm-up and measured run
+        fill(C, semiring.zero);
+        matrix_multithread_mult_semiring(A, B, C, semiring, BLOCK_SIZE, NUM_THREADS);
+        fill(C, semiring.zero);
+        start = now_seconds();
+        matrix_multithread_mult_semiring(A, B, C, semiring, BLOCK_SIZE, NUM_THREADS);
+        double kernel_time = now_seconds() - start;
+
+        printf("%s,%zu,%zu,%.10f,%.10f,%.4f\n", names[s], n, NUM_THREADS,
+               naive_time, kernel_time, naive_time / kernel_time);
+
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file matrix_spgemm_benchmark.c
+ *
+ * @brief Compares the accumulators of matrix_multithread_spgemm() on the
+ * square A * A of a synthetic power-law sparse Matrix, which mimics the
+ * adjacency Matrix of a graph with a few hubs.
+ *
+ * @details
+ * The degree (nonzeros) of a row follows a Pareto distribution with the
+ * given minimum degree, capped at the number of columns, so most rows
+ * are short and a few are very long. The columns are drawn with a bias
+ * towards the low indices (the hubs), duplicates are merged. Each time
+ * is of a single multiplication after a warm-up run and includes both
+ * the symbolic and the numeric phase. The MFLOP/s are counted with two
+ * operations per multiply-add. The output is CSV, which makes it easy
+ * to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../src/shared/matrix_csr.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_spgemm.h"
+
+/**
+ * @brief Comparison of two columns for qsort().
+ */
+int compare_columns(const void* a, const void* b) {
+
+    size_t x = *(const size_t*)a;
+    size_t y = *(const size_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Generate an n x n power-law MatrixCSR (see the file description).
+ *
+ * @param n The dimension.
+ * @param min_degree The minimum number of nonzeros drawn per row.
+ * @return A pointer to the MatrixCSR, or NULL if an error occured.
+ */
+MatrixCSR* generate_power_law(size_t n, size_t min_degree) {
+
+    // Pareto distributed degrees: min_degree / u for a uniform u in (0, 1]
+    size_t* degrees = (size_t*)malloc(sizeof(size_t) * n);
+    if (!degrees) {
+        return NULL;
+    }
+    size_t max_nnz = 0;
+    for (size_t i = 0; i < n; i++) {
+        double u = ((double)rand() + 1.0) / ((double)RAND_MAX + 1.0);
+        double degree = min_degree / u;
+        degrees[i] = (degree < n) ? (size_t)degree : n;
+        max_nnz += degrees[i];
+    }
+
+    MatrixCSR* M = matrix_csr_create(n, n, max_nnz);
+    if (!M) {
+        free(degrees);
+        return NULL;
+    }
+
+    size_t index = 0;
+    for (size_t i = 0; i < n; i++) {
+
+        // Columns biased towards the hubs (u^3 for a uniform u in [0, 1))
+        size_t* row = &M->col_indices[index];
+        for (size_t d = 0; d < degrees[i]; d++) {
+            double u = (double)rand() / ((double)RAND_MAX + 1.0);
+            row[d] = (size_t)(u * u * u * n);
+        }
+
+        // Sort and merge the duplicates
+        qsort(row, degrees[i], sizeof(size_t), compare_columns);
+        size_t count = 0;
+        for (size_t d = 0; d < degrees[i]; d++) {
+            if (count == 0 || row[count - 1] != row[d]) {
+                row[count++] = row[d];
+            }
+        }
+        for (size_t d = 0; d < count; d++) {
+            M->values[index + d] = random_between(1, 1000) * ((rand() % 2) ? 1.0 : -1.0);
+        }
+
+        index += count;
+        M->row_ptr[i + 1] = index;
+    }
+    M->nnz = index;
+
+    free(degrees);
+    return M;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Min_Degree> <Seed> <Num_Threads> [Print_Header]\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const size_t min_degree = atoi(argv[2]);
+    const int seed = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    const int print_header = (argc > 5) ? atoi(argv[5]) : 1;
+    if (n == 0 || min_degree == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, degree and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    MatrixCSR* A = generate_power_law(n, min_degree);
+    if (!A) {
+        fprintf(stderr, "%s\n", "Error: Generation of the Matrix failed");
+        return 1;
+    }
+
+    // The multiply-adds of A * A
+    size_t multiply_adds = 0;
+    size_t max_row_nnz = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t row_nnz = A->row_ptr[i + 1] - A->row_ptr[i];
+        if (row_nnz > max_row_nnz) {
+            max_row_nnz = row_nnz;
+        }
+        for (size_t nz = A->row_ptr[i]; nz < A->row_ptr[i + 1]; nz++) {
+            size_t k = A->col_indices[nz];
+            multiply_adds += A->row_ptr[k + 1] - A->row_ptr[k];
+        }
+    }
+
+    const char* names[] = {"HASH", "DENSE"};
+
+    if (print_header) {
+        printf("Accumulator,Dimension,Threads,Nonzeros A,Max Row Nonzeros A,Nonzeros C,Multiply-Adds,Time (seconds),MFLOP/s\n");
+    }
+    for (SpgemmAccumulator accumulator = 0; accumulator < SPGEMM_NUM_ACCUMULATORS; accumulator++) {
+
+        // Warm-up and measured run
+        MatrixCSR* C = matrix_multithread_spgemm(A, A, accumulator, NUM_THREADS);
+        if (!C) {
+            fprintf(stderr, "%s\n", "Error: matrix_multithread_spgemm() failed");
+            return 1;
+        }
+        matrix_csr_free(C);
+
+        double start = now_seconds();
+        C = matrix_multithread_spgemm(A, A, accumulator, NUM_THREADS);
+        double time = now_seconds() - start;
+        if (!C) {
+            fprintf(stderr, "%s\n", "Error: matrix_multithread_spgemm() failed");
+            return 1;
+        }
+
+        printf("%s,%zu,%zu,%zu,%zu,%zu,%zu,%.10f,%.4f\n", names[accumulator], n, NUM_THREADS, A->nnz, max_row_nnz,
+               C->nnz, multiply_adds, time, 2.0 * multiply_adds / time * 1e-6);
+
+        matrix_csr_free(C);
+    }
+
+    matrix_csr_free(A);
+
+    return 0;
+}
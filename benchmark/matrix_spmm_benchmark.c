@@ -0,0 +1,121 @@
+/**
+ * @file matrix_spmm_benchmark.c
+ *
+ * @brief Sweeps the density of A to find the crossover between the
+ * sparse matrix_multithread_spmm() and the dense MULTITHREAD_9AVX kernel
+ * for the square product A * B.
+ *
+ * @details
+ * For each density a fresh A is generated where each element is nonzero
+ * with the given probability. The dense time includes the transposition
+ * of B that the 9avx kernel needs, the sparse time excludes the
+ * conversion of A to CSR, which is reported on its own (it is a one-off
+ * cost when A is reused). Each time is of a single multiplication after
+ * a warm-up run. A speedup above 1 means the sparse kernel is faster.
+ * The output is CSV, which makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_csr.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_spmm.h"
+
+/**
+ * @brief Compute A * B with the dense kernel (including the transposition of B).
+ */
+void run_dense(Matrix* A, Matrix* B, Matrix* C, size_t BLOCK_SIZE, size_t NUM_THREADS) {
+
+    Matrix* B_trans = matrix_create_with(pattern_zero, NULL, B->num_cols, B->num_rows);
+    for (size_t i = 0; i < B->num_rows; i++) {
+        for (size_t j = 0; j < B->num_cols; j++) {
+            B_trans->values[j * B_trans->stride + i] = B->values[i * B->stride + j];
+        }
+    }
+    matrix_multithread_mult_9avx(A, B_trans, C, BLOCK_SIZE, NUM_THREADS);
+    matrix_free(B_trans);
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const int seed = atoi(argv[2]);
+    const size_t BLOCK_SIZE = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimension, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+
+    // The densities (fraction of nonzeros in A) to sweep
+    const double densities[] = {0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.3, 0.5};
+    const size_t num_densities = sizeof(densities) / sizeof(densities[0]);
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    // The dense time does not depend on the density
+    run_dense(A, B, C, BLOCK_SIZE, NUM_THREADS);
+    double start = now_seconds();
+    run_dense(A, B, C, BLOCK_SIZE, NUM_THREADS);
+    double dense_time = now_seconds() - start;
+
+    printf("Density,Dimension,Threads,Nonzeros,Dense Time (seconds),Sparse Time (seconds),Conversion Time (seconds),Speedup\n");
+    for (size_t d = 0; d < num_densities; d++) {
+
+        // Generate the sparse A (values of zero are dropped by the conversion)
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                bool keep = rand() < densities[d] * ((double)RAND_MAX + 1.0);
+                A->values[i * A->stride + j] = keep ? random_between(VALUES_MIN, VALUES_MAX) : 0.0;
+            }
+        }
+
+        start = now_seconds();
+        MatrixCSR* A_csr = matrix_to_csr(A);
+        double conversion_time = now_seconds() - start;
+        if (!A_csr) {
+            fprintf(stderr, "%s\n", "Error: Conversion to CSR failed");
+            return 1;
+        }
+
+        // Warm-up and measured run
+        matrix_multithread_spmm(A_csr, B, C, NUM_THREADS);
+        start = now_seconds();
+        matrix_multithread_spmm(A_csr, B, C, NUM_THREADS);
+        double sparse_time = now_seconds() - start;
+
+        printf("%g,%zu,%zu,%zu,%.10f,%.10f,%.10f,%.4f\n", densities[d], n, NUM_THREADS, A_csr->nnz,
+               dense_time, sparse_time, conversion_time, dense_time / sparse_time);
+
+        matrix_csr_free(A_csr);
+    }
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+
+    return 0;
+}
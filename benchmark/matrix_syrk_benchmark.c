@@ -0,0 +1,107 @@
+/**
+ * @file matrix_syrk_benchmark.c
+ *
+ * @brief Compares the Gram Matrix A * A^T computed with
+ * matrix_multithread_syrk() (with and without mirroring) against the
+ * full-multiply path: materializing A^T and passing A and A^T to the
+ * MULTITHREAD_9AVX kernel.
+ *
+ * @details
+ * For each path the time of a single computation (after a warm-up run)
+ * is reported, together with the GFLOP/s counted with the 2 * n * n * m
+ * operations of the full product (so the rates are comparable) and the
+ * speedup over the full-multiply path. The time of the full path
+ * includes the transposition of A. The output is CSV, which makes it
+ * easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_syrk.h"
+
+/**
+ * @brief Compute A * A^T with the given path into the zeroed C.
+ *
+ * @param path 0 for the full multiply, 1 for SYRK, 2 for mirrored SYRK.
+ */
+void run_path(int path, Matrix* A, Matrix* C, size_t BLOCK_SIZE, size_t NUM_THREADS) {
+
+    for (size_t i = 0; i < C->num_rows * C->stride; i++) {
+        C->values[i] = 0.0;
+    }
+
+    if (path == 0) {
+        Matrix* A_trans = matrix_create_with(pattern_zero, NULL, A->num_cols, A->num_rows);
+        for (size_t i = 0; i < A->num_rows; i++) {
+            for (size_t j = 0; j < A->num_cols; j++) {
+                A_trans->values[j * A_trans->stride + i] = A->values[i * A->stride + j];
+            }
+        }
+        matrix_multithread_mult_9avx(A, A_trans, C, BLOCK_SIZE, NUM_THREADS);
+        matrix_free(A_trans);
+    } else {
+        matrix_multithread_syrk(A, C, path == 2, BLOCK_SIZE, NUM_THREADS);
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 6) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Inner_Dimension> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const size_t m = atoi(argv[2]);
+    const int seed = atoi(argv[3]);
+    const size_t BLOCK_SIZE = atoi(argv[4]);
+    const size_t NUM_THREADS = atoi(argv[5]);
+    if (n == 0 || m == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimensions, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    const char* names[] = {"FULL_9AVX", "SYRK", "SYRK_MIRRORED"};
+    double full_time = 0.0;
+
+    printf("Path,Dimension,Inner Dimension,Threads,Time (seconds),GFLOP/s,Speedup\n");
+    for (int path = 0; path < 3; path++) {
+
+        // Warm-up and measured run
+        run_path(path, A, C, BLOCK_SIZE, NUM_THREADS);
+        double start = now_seconds();
+        run_path(path, A, C, BLOCK_SIZE, NUM_THREADS);
+        double time = now_seconds() - start;
+        if (path == 0) {
+            full_time = time;
+        }
+
+        printf("%s,%zu,%zu,%zu,%.10f,%.6f,%.4f\n", names[path], n, m, NUM_THREADS, time,
+               2.0 * n * n * m / time * 1e-9, full_time / time);
+    }
+
+    matrix_free(A);
+    matrix_free(C);
+
+    return 0;
+}
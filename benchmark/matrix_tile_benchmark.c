@@ -0,0 +1,128 @@
+/**
+ * @file matrix_tile_benchmark.c
+ *
+ * @brief Compares the row-major MULTITHREAD_9AVX kernel against
+ * matrix_multithread_mult_tile() on tile-major copies of the same
+ * matrices, with the block size equal to the tile size.
+ *
+ * @details
+ * Besides the time of a single multiplication (after a warm-up run),
+ * the last-level cache misses and the dTLB load misses of the
+ * multiplication are counted with perf_event_open(). The counters are
+ * inherited by the threads created during the measurement. If a counter
+ * is not available (no PMU in a virtual machine, or a restrictive
+ * /proc/sys/kernel/perf_event_paranoid), -1 is printed instead. The
+ * times of the parallel conversions to and from tile-major are printed
+ * as well, since they are paid once per Matrix. The output is CSV, which
+ * makes it easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_tile.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/shared/perf_counter.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_tile.h"
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Tile_Size> <Seed> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const size_t TILE_SIZE = atoi(argv[2]);
+    const int seed = atoi(argv[3]);
+    const size_t NUM_THREADS = atoi(argv[4]);
+    if (n == 0 || NUM_THREADS == 0 || TILE_SIZE == 0 || TILE_SIZE % TILE_SIZE_ALIGNMENT != 0) {
+        fprintf(stderr, "Error: Dimension and threads have to be non-zero, the tile size a multiple of %d\n",
+                TILE_SIZE_ALIGNMENT);
+        return 1;
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Matrix* A = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* B = generate_matrix(-10.0, 10.0, n, n);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!A || !B || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+
+    double start = now_seconds();
+    Matrix* A_tile = matrix_to_tile_major(A, TILE_SIZE, NUM_THREADS);
+    Matrix* B_tile = matrix_to_tile_major(B, TILE_SIZE, NUM_THREADS);
+    double to_tile_time = (now_seconds() - start) / 2;
+    Matrix* C_tile = matrix_tile_create(n, n, TILE_SIZE);
+    if (!A_tile || !B_tile || !C_tile) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the tile-major matrices failed");
+        return 1;
+    }
+
+    // Last-level cache misses and dTLB load misses
+    int cache_fd = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    int tlb_fd = perf_counter_open_cache_misses(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ);
+
+    printf("Layout,Dimension,Tile Size,Threads,Time (seconds),Cache Misses,dTLB Load Misses,Conversion Time (seconds)\n");
+    for (int layout = MATRIX_ROW_MAJOR; layout <= MATRIX_TILE_MAJOR; layout++) {
+
+        double time = 0.0;
+        long long cache_misses = -1;
+        long long tlb_misses = -1;
+
+        // Warm-up and measured run
+        for (int run = 0; run < 2; run++) {
+            Matrix* D = (layout == MATRIX_ROW_MAJOR) ? C : C_tile;
+            size_t num_values = (layout == MATRIX_ROW_MAJOR) ? n * C->stride :
+                (n + TILE_SIZE - 1) / TILE_SIZE * matrix_tile_num_cols(C_tile) * TILE_SIZE * TILE_SIZE;
+            memset(D->values, 0, sizeof(double) * num_values);
+
+            perf_counter_start(cache_fd);
+            perf_counter_start(tlb_fd);
+            start = now_seconds();
+            if (layout == MATRIX_ROW_MAJOR) {
+                matrix_multithread_mult_9avx(A, B, C, TILE_SIZE, NUM_THREADS);
+            } else {
+                matrix_multithread_mult_tile(A_tile, B_tile, C_tile, NUM_THREADS);
+            }
+            time = now_seconds() - start;
+            cache_misses = perf_counter_stop(cache_fd);
+            tlb_misses = perf_counter_stop(tlb_fd);
+        }
+
+        // The conversion from tile-major (of C) is the cost of reading the result row-major
+        double conversion_time = 0.0;
+        if (layout == MATRIX_TILE_MAJOR) {
+            start = now_seconds();
+            Matrix* C_back = matrix_from_tile_major(C_tile, NUM_THREADS);
+            conversion_time = to_tile_time + now_seconds() - start;
+            matrix_free(C_back);
+        }
+
+        printf("%s,%zu,%zu,%zu,%.10f,%lld,%lld,%.10f\n", layout == MATRIX_ROW_MAJOR ? "ROW_MAJOR" : "TILE_MAJOR",
+               n, TILE_SIZE, NUM_THREADS, time, cache_misses, tlb_misses, conversion_time);
+    }
+
+    perf_counter_close(cache_fd);
+    perf_counter_close(tlb_fd);
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+    matrix_free(A_tile);
+    matrix_free(B_tile);
+    matrix_free(C_tile);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file matrix_triangular_benchmark.c
+ *
+ * @brief Benchmarks matrix_multithread_trmm() and
+ * matrix_multithread_trsm() for a lower triangular n x n Matrix L and an
+ * n x p Matrix B, against the dense MULTITHREAD_9AVX kernel on the same
+ * L (which also multiplies the zeros) and against OpenBLAS.
+ *
+ * @details
+ * For each routine the time of a single call (after a warm-up run) and
+ * the GFLOP/s counted with the n * n * p operations of a triangular
+ * multiply or solve are reported. The output is CSV, which makes it
+ * easy to append to a file.
+ *
+ * To compile, set TEST_FILE in the 'manfile' to this file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "../src/shared/matrix.h"
+#include "../src/shared/matrix_utils.h"
+#include "../src/cpu/matrix_multithread_9avx.h"
+#include "../src/cpu/matrix_multithread_triangular.h"
+
+// The routines that are compared
+#define NUM_ROUTINES 5
+
+/**
+ * @brief Run one routine on a fresh copy of B_source.
+ *
+ * @param routine The index into the names in main().
+ * @return The time of the call in seconds.
+ */
+double run_routine(int routine, Matrix* L, Matrix* B_source, Matrix* B, Matrix* C,
+                   size_t BLOCK_SIZE, size_t NUM_THREADS) {
+
+    size_t n = B->num_rows;
+    size_t p = B->num_cols;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            B->values[i * B->stride + j] = B_source->values[i * B_source->stride + j];
+            C->values[i * C->stride + j] = 0.0;
+        }
+    }
+
+    double start = now_seconds();
+    switch (routine) {
+        case 0: matrix_multithread_mult_9avx(L, B, C, BLOCK_SIZE, NUM_THREADS); break;
+        case 1: matrix_multithread_trmm(L, B, TRIANGLE_LOWER, false, BLOCK_SIZE, NUM_THREADS); break;
+        case 2: cblas_dtrmm(CblasRowMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit,
+                            n, p, 1.0, L->values, L->stride, B->values, B->stride); break;
+        case 3: matrix_multithread_trsm(L, B, TRIANGLE_LOWER, false, BLOCK_SIZE, NUM_THREADS); break;
+        case 4: cblas_dtrsm(CblasRowMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit,
+                            n, p, 1.0, L->values, L->stride, B->values, B->stride); break;
+    }
+    return now_seconds() - start;
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 6) {
+        fprintf(stderr, "Usage: %s <Dimension_Size> <Num_Columns_B> <Seed> <Block_Size> <Num_Threads>\n", argv[0]);
+        return 1;
+    }
+
+    const size_t n = atoi(argv[1]);
+    const size_t p = atoi(argv[2]);
+    const int seed = atoi(argv[3]);
+    const size_t BLOCK_SIZE = atoi(argv[4]);
+    const size_t NUM_THREADS = atoi(argv[5]);
+    if (n == 0 || p == 0 || BLOCK_SIZE == 0 || NUM_THREADS == 0) {
+        fprintf(stderr, "%s\n", "Error: Dimensions, block size and threads have to be non-zero integers");
+        return 1;
+    }
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+1;
+    const double VALUES_MAX = 1e+1;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    // Lower triangular with a dominant diagonal (zeros above for the dense kernel)
+    Matrix* L = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+    Matrix* B_source = generate_matrix(VALUES_MIN, VALUES_MAX, n, p);
+    Matrix* B = matrix_create_with(pattern_zero, NULL, n, p);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+    if (!L || !B_source || !B || !C) {
+        fprintf(stderr, "%s\n", "Error: Allocation of the matrices failed");
+        return 1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            L->values[i * L->stride + j] = 0.0;
+        }
+        L->values[i * L->stride + i] = VALUES_MAX * n + 1.0;
+    }
+
+    const char* names[NUM_ROUTINES] = {"DENSE_9AVX", "TRMM", "OPENBLAS_DTRMM", "TRSM", "OPENBLAS_DTRSM"};
+
+    printf("Routine,Dimension,Columns B,Threads,Time (seconds),GFLOP/s\n");
+    for (int routine = 0; routine < NUM_ROUTINES; routine++) {
+
+        // Warm-up and measured run
+        run_routine(routine, L, B_source, B, C, BLOCK_SIZE, NUM_THREADS);
+        double time = run_routine(routine, L, B_source, B, C, BLOCK_SIZE, NUM_THREADS);
+
+        printf("%s,%zu,%zu,%zu,%.10f,%.6f\n", names[routine], n, p, NUM_THREADS, time,
+               1.0 * n * n * p / time * 1e-9);
+    }
+
+    matrix_free(L);
+    matrix_free(B_source);
+    matrix_free(B);
+    matrix_free(C);
+
+    return 0;
+}
@@ -3,6 +3,7 @@ import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 import math
+import os
 import seaborn as sns
 from scipy import stats # Perform stat analysis
 
@@ -169,6 +170,48 @@ def create_graph_execution_time(data, NUM_RUNS, filename):
     plt.tight_layout()
     plt.savefig(filename)
 
+def create_scaling_plot(data, png_name):
+
+    # One column per scaling mode, speedup on top and efficiency below
+    modes = ["strong", "weak"]
+
+    # Set the style and font figure size
+    sns.set_theme(style="whitegrid", font_scale=1.1)
+
+    fig, axes = plt.subplots(2, len(modes), figsize=(16, 10), squeeze=False)
+
+    for col, mode in enumerate(modes):
+        mode_data = data[data["Mode"] == mode].copy()
+        if mode_data.empty:
+            continue
+
+        # Label each line with the algorithm and whether SMT was used
+        mode_data["Configuration"] = mode_data["Algorithm"] + " (SMT " + mode_data["SMT"].map({1: "on", 0: "off"}) + ")"
+
+        # Speedup with the ideal linear speedup as reference
+        ax = axes[0][col]
+        sns.lineplot(data=mode_data, x="Threads", y="Speedup", hue="Configuration",
+                     marker="o", linewidth=3, ax=ax)
+        max_threads = mode_data["Threads"].max()
+        ax.plot([1, max_threads], [1, max_threads], color="black", linestyle="dashed", label="Ideal")
+        ax.set_title(f"{mode.capitalize()} Scaling: Speedup")
+        ax.set_xlabel("Threads")
+        ax.set_ylabel("Speedup")
+        ax.legend(title="Configuration", fontsize="small")
+
+        # Parallel efficiency (Karp-Flatt is kept in the CSV)
+        ax = axes[1][col]
+        sns.lineplot(data=mode_data, x="Threads", y="Parallel Efficiency", hue="Configuration",
+                     marker="o", linewidth=3, ax=ax)
+        ax.axhline(y=1.0, color="black", linestyle="dashed")
+        ax.set_title(f"{mode.capitalize()} Scaling: Parallel Efficiency")
+        ax.set_xlabel("Threads")
+        ax.set_ylabel("Parallel Efficiency")
+        ax.legend(title="Configuration", fontsize="small")
+
+    plt.tight_layout()
+    plt.savefig(png_name)
+
 # Two sided welchs t test function
 def welchs_t_test_two_sided(xbar, ybar, s1, s2, n, m, delta0=0):
 
@@ -391,6 +434,11 @@ def main():
     create_heatmap_with(filtered_data['Algorithm'], filtered_data['Dimension'], filtered_data['Average Execution Time (seconds)'],
                         "Average Execution Time (seconds)", "Algorithm", "Dimension", "plots/competing_algorithms_execution_time_heatmap.png")
 
+    # ----- SCALING: STRONG AND WEAK SCALING STUDY (see run_scaling_benchmark.sh)
+    if os.path.exists('data/scaling_results.csv'):
+        scaling_data = pd.read_csv('data/scaling_results.csv')
+        create_scaling_plot(scaling_data, "plots/scaling_plot.png")
+
 # Execute main if this file is called as a script
 if __name__ == "__main__":
     main()
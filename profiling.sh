@@ -16,6 +16,7 @@ run_program() {
     instructions=$(cat rep.txt | grep "instructions" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
     cache_misses=$(cat rep.txt | grep "cache-misses" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
     cache_references=$(cat rep.txt | grep "cache-references" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
+    dtlb_load_misses=$(cat rep.txt | grep "dTLB-load-misses" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
 
     # Calculate the Cycles per Instruction (CPI) and cache-miss rate
     cpi=0
@@ -37,10 +38,11 @@ run_program() {
     echo "Cache References   : $cache_references"
     echo "CPI (Cycles/Instr) : $cpi"
     echo "Cache Miss Rate    : $cache_miss_rate"
+    echo "dTLB Load Misses   : $dtlb_load_misses"
 }
 
 # Data for perf to collect
-metrics="cycles,instructions,cache-misses,cache-references"
+metrics="cycles,instructions,cache-misses,cache-references,dTLB-load-misses"
 
 SEED=42
 
@@ -38,7 +38,7 @@ filename="benchmark/data/benchmark_results.csv"
 # Add the headers / categories into the start of the CSV file.
 # Use double quotes around $filename as safety practice to ensure
 # interpretation as a single argument.
-echo "Algorithm,Dimension,Average Execution Time (seconds),Cycles,Instructions,Cycles per Instruction (CPI),Cache-Misses,Cache-References,Cache-Miss-Rate,Execution Time Variance,Cycles Variance,Instructions Variance,CPI Variance,Cache-Misses Variance,Cache-References Variance,Cache-Miss-Rate Variance" > "$filename"
+echo "Algorithm,Dimension,Average Execution Time (seconds),Cycles,Instructions,Cycles per Instruction (CPI),Cache-Misses,Cache-References,Cache-Miss-Rate,Execution Time Variance,Cycles Variance,Instructions Variance,CPI Variance,Cache-Misses Variance,Cache-References Variance,Cache-Miss-Rate Variance,Energy (joules),Average Power (watts),GFLOP/J" > "$filename"
 
 # Create array of algorithms to benchmark
 algorithms=("BLAS" "NAIVE" "SINGLETHREAD" "MULTITHREAD" "MULTITHREAD_3AVX" "MULTITHREAD_9AVX")
@@ -82,13 +82,16 @@ for algo in "${algorithms[@]}"; do
         record_cache_misses=()
         record_cache_references=()
         record_cache_miss_rate=()
+        record_energy=()
+        record_power=()
+        record_gflop_per_joule=()
 
         # Perform a single run and collect data using perf
         for (( run=0; run<NUM_RUNS; run++ )); do
 
             # Run perf and generate perf_report.txt file
             echo "Performing run $run..."
-            perf stat -o perf_report.txt -e $metrics ./program $algo $dimension $SEED $BLOCK_SIZE 0 > /dev/null
+            perf stat -o perf_report.txt -e $metrics ./program $algo $dimension $SEED $BLOCK_SIZE 0 > program_report.txt
 
             # Extract the metrics from perf report
             time=$(cat perf_report.txt | grep "elapsed" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
@@ -97,6 +100,11 @@ for algo in "${algorithms[@]}"; do
             cache_misses=$(cat perf_report.txt | grep "cache-misses" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
             cache_references=$(cat perf_report.txt | grep "cache-references" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
 
+            # Extract the RAPL energy reported by the program (n/a if RAPL is not available)
+            energy=$(cat program_report.txt | grep "^Energy (J)" | awk -F ':' '{print $2}' | tr -d ' ')
+            power=$(cat program_report.txt | grep "^Average Power (W)" | awk -F ':' '{print $2}' | tr -d ' ')
+            gflop_per_joule=$(cat program_report.txt | grep "^GFLOP/J" | awk -F ':' '{print $2}' | tr -d ' ')
+
             # Calculate the Cycles per Instruction (CPI) and cache-miss rate
             cpi=0
             cache_miss_rate=0
@@ -115,6 +123,11 @@ for algo in "${algorithms[@]}"; do
             record_cache_references+=("$cache_references")
             record_cpi+=("$cpi")
             record_cache_miss_rate+=("$cache_miss_rate")
+            if [ "$energy" != "n/a" ] && [ -n "$energy" ]; then
+                record_energy+=("$energy")
+                record_power+=("$power")
+                record_gflop_per_joule+=("$gflop_per_joule")
+            fi
         done
 
         # Calculate the total sum of each recorded data
@@ -135,6 +148,16 @@ for algo in "${algorithms[@]}"; do
         avg_cache_references=$(echo "scale=10; $total_cache_references / $NUM_RUNS" | bc)
         avg_cache_miss_rate=$(echo "scale=10; $total_cache_miss_rate / $NUM_RUNS" | bc)
 
+        # Mean energy, power and GFLOP/J (NA if RAPL was not available)
+        avg_energy="NA"
+        avg_power="NA"
+        avg_gflop_per_joule="NA"
+        if [ ${#record_energy[@]} -gt 0 ]; then
+            avg_energy=$(echo "scale=10; $(sum_array "${record_energy[@]}") / ${#record_energy[@]}" | bc)
+            avg_power=$(echo "scale=10; $(sum_array "${record_power[@]}") / ${#record_power[@]}" | bc)
+            avg_gflop_per_joule=$(echo "scale=10; $(sum_array "${record_gflop_per_joule[@]}") / ${#record_gflop_per_joule[@]}" | bc)
+        fi
+
         # Data to calculate the sample variance from benchmark runs
         variance_time=$(calculate_sample_variance "$avg_time" "$NUM_RUNS" "${record_time[@]}")
         variance_cycles=$(calculate_sample_variance "$avg_cycles" "$NUM_RUNS" "${record_cycles[@]}")
@@ -145,12 +168,12 @@ for algo in "${algorithms[@]}"; do
         variance_cache_miss_rate=$(calculate_sample_variance "$avg_cache_miss_rate" "$NUM_RUNS" "${record_cache_miss_rate[@]}")
 
         # Write the result into the CSV file
-        echo "$algo,$dimension,$avg_time,$avg_cycles,$avg_instructions,$avg_cpi,$avg_cache_misses,$avg_cache_references,$avg_cache_miss_rate,$variance_time,$variance_cycles,$variance_instructions,$variance_cpi,$variance_cache_misses,$variance_cache_references,$variance_cache_miss_rate" >> "$filename"
+        echo "$algo,$dimension,$avg_time,$avg_cycles,$avg_instructions,$avg_cpi,$avg_cache_misses,$avg_cache_references,$avg_cache_miss_rate,$variance_time,$variance_cycles,$variance_instructions,$variance_cpi,$variance_cache_misses,$variance_cache_references,$variance_cache_miss_rate,$avg_energy,$avg_power,$avg_gflop_per_joule" >> "$filename"
     done
 done
 
 # Clean-up
-rm perf_report.txt
+rm perf_report.txt program_report.txt
 
 # Print the final result
 cat "$filename"
@@ -0,0 +1,27 @@
+#!/bin/bash
+# Note: Make sure to run the manfile in the root directory with
+# benchmark/matrix_factor_benchmark.c as TEST_FILE to get the correct
+# program when compiling using manfile.
+
+# Dimensions to benchmark
+dimensions=(1000 2000 3000 4000 6000 8000)
+
+# Seed for reproducability when running benchmark
+SEED=43
+
+# Block size (panel width of the factorizations)
+BLOCK_SIZE=64
+
+# Number of threads, defaults to the number of online CPUs
+NUM_THREADS=${NUM_THREADS:-$(nproc)}
+
+# Filename to store the benchmark data in
+filename="benchmark/data/factor_results.csv"
+
+# Add the headers / categories into the start of the CSV file
+echo "Routine,Dimension,Threads,Time (seconds),GFLOP/s" > "$filename"
+
+for dimension in "${dimensions[@]}"; do
+    echo "Working on dimension $dimension..."
+    ./program $dimension $SEED $BLOCK_SIZE $NUM_THREADS 0 >> "$filename"
+done
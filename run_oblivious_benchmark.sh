@@ -0,0 +1,24 @@
+#!/bin/bash
+# Note: Make sure to run the manfile in the root directory with
+# benchmark/matrix_oblivious_benchmark.c as TEST_FILE to get the correct
+# program when compiling using manfile.
+
+# Dimensions to benchmark (those of run_block_size_benchmark.sh)
+dimensions=(50 100 200 500 750 1000 1500 2000)
+
+# Seed for reproducability when running benchmark
+SEED=43
+
+# Number of threads, defaults to the number of online CPUs
+NUM_THREADS=${NUM_THREADS:-$(nproc)}
+
+# Filename to store the benchmark data in
+filename="benchmark/data/oblivious_results.csv"
+
+# Add the headers / categories into the start of the CSV file
+echo "Dimension,Threads,Best 9AVX Block Size,9AVX Time (seconds),Oblivious Time (seconds),Speedup,9AVX GFLOP/s,Oblivious GFLOP/s" > "$filename"
+
+for dimension in "${dimensions[@]}"; do
+    echo "Working on dimension $dimension..."
+    ./program $dimension $SEED $NUM_THREADS 0 >> "$filename"
+done
@@ -0,0 +1,167 @@
+#!/bin/bash
+# Note: Make sure to run the manfile in the root directory with matrix_mult_benchmark.c
+# to get the correct program when compiling using manfile.
+#
+# Strong- and weak-scaling study of the multithreaded algorithms.
+#
+# Strong scaling: the dimension is fixed and the number of threads grows.
+# Weak scaling: the work per thread is constant, i.e. the dimension grows
+# with the cube root of the number of threads (the work is 2 * n^3).
+#
+# Each sweep is run with SMT on (threads pinned to every logical CPU) and
+# with SMT off (threads pinned to one logical CPU per physical core).
+# For p threads the following is reported relative to the 1 thread run:
+#   Speedup S(p)       = T(1) / T(p) * W(p) / W(1)  (W = work, W(p) = W(1) for strong)
+#   Efficiency E(p)    = S(p) / p
+#   Karp-Flatt e(p)    = (1 / S(p) - 1 / p) / (1 - 1 / p)  (empty for p = 1)
+# The point where the efficiency drops while e(p) stays flat usually marks
+# the saturation of the memory bandwidth rather than serial work.
+
+sum_array() {
+    local arr=("$@")
+    local total=0
+    for val in "${arr[@]}"; do
+        total=$(echo "scale=10; $total + $val" | bc)
+    done
+
+    echo "$total"
+}
+
+# Assumes NUM_RUNS > 1.
+calculate_sample_variance() {
+    # First argument
+    local mean=$1
+    # Shift drops the first argument and shifts so that arg $n -> arg $n-1
+    shift
+    local NUM_RUNS=$1
+    shift
+    # Rest of arguments are the array elements
+    local arr=("$@")
+    local sse=0
+    for val in "${arr[@]}"; do
+        sse=$(echo "scale=10; $sse + ($mean - $val) * ($mean - $val)" | bc)
+    done
+
+    local_sample_variance=$(echo "scale=10; $sse / ($NUM_RUNS - 1)" | bc)
+
+    echo "$local_sample_variance"
+}
+
+# Logical CPUs with SMT on (all) and off (first sibling of every core)
+smt_on_cpus=$(seq -s, 0 $(( $(nproc --all) - 1 )))
+smt_off_cpus=$(cat /sys/devices/system/cpu/cpu*/topology/thread_siblings_list 2>/dev/null \
+               | awk -F '[,-]' '{print $1}' | sort -n -u | paste -s -d, -)
+if [ -z "$smt_off_cpus" ]; then
+    smt_off_cpus=$smt_on_cpus
+fi
+
+# Build the thread counts 1, 2, 4, ... up to max_threads (always including max_threads)
+thread_counts() {
+    local max_threads=$1
+    local counts=()
+    local t=1
+    while [ $t -lt $max_threads ]; do
+        counts+=($t)
+        t=$(( t * 2 ))
+    done
+    counts+=($max_threads)
+    echo "${counts[@]}"
+}
+
+# Algorithms to study
+algorithms=("MULTITHREAD_3AVX" "MULTITHREAD_9AVX")
+
+# Strong scaling dimension and weak scaling dimension for 1 thread
+STRONG_DIMENSION=2000
+WEAK_BASE_DIMENSION=1000
+
+# Using previously found optimal block size (see run_block_size_benchmark.sh)
+BLOCK_SIZE=128
+
+# Default prefetch distance, no huge pages, no padding and no trace
+PREFETCH_DISTANCE=64
+HUGE_PAGES=0
+PADDED_STRIDE=0
+TRACE_FILE=""
+
+# Number of runs for each (mode, smt, algorithm, threads) benchmark
+NUM_RUNS=10
+
+# Seed for reproducability when running benchmark
+SEED=42
+
+# Filename to store the benchmark data in
+filename="benchmark/data/scaling_results.csv"
+
+# Add the headers / categories into the start of the CSV file.
+echo "Mode,SMT,Algorithm,Threads,Dimension,Average Execution Time (seconds),Execution Time Variance,GFLOP/s,Speedup,Parallel Efficiency,Karp-Flatt Serial Fraction" > "$filename"
+
+# Compile and link the code to create benchmark program
+echo "Compiling and linking..."
+./manfile > /dev/null 2>&1
+
+for mode in strong weak; do
+    for smt in 1 0; do
+
+        if [ $smt -eq 1 ]; then
+            cpus=$smt_on_cpus
+        else
+            cpus=$smt_off_cpus
+        fi
+        max_threads=$(echo "$cpus" | tr ',' '\n' | wc -l)
+
+        for algo in "${algorithms[@]}"; do
+
+            # Time and work of the 1 thread run, the reference for this sweep
+            base_time=0
+            base_work=0
+
+            for threads in $(thread_counts $max_threads); do
+
+                # The dimension that keeps the work per thread constant
+                if [ "$mode" = "strong" ]; then
+                    dimension=$STRONG_DIMENSION
+                else
+                    dimension=$(echo "scale=10; $WEAK_BASE_DIMENSION * e(l($threads) / 3) + 0.5" | bc -l | cut -d '.' -f 1)
+                fi
+                work=$(echo "2 * $dimension ^ 3" | bc)
+
+                # Perform warm-up
+                echo "Warm-up $algo ($mode, SMT $smt) with $threads threads and dimension size of $dimension..."
+                taskset -c $cpus ./program $algo $dimension $SEED $BLOCK_SIZE 1 $PREFETCH_DISTANCE $HUGE_PAGES $PADDED_STRIDE "$TRACE_FILE" $threads > /dev/null
+
+                record_time=()
+                for (( run=0; run<NUM_RUNS; run++ )); do
+
+                    echo "Performing run $run..."
+                    time=$(taskset -c $cpus ./program $algo $dimension $SEED $BLOCK_SIZE 0 $PREFETCH_DISTANCE $HUGE_PAGES $PADDED_STRIDE "$TRACE_FILE" $threads \
+                           | grep "Mult Time" | awk -F ':' '{print $2}' | tr -d ' ')
+                    record_time+=("$time")
+                done
+
+                avg_time=$(echo "scale=10; $(sum_array "${record_time[@]}") / $NUM_RUNS" | bc)
+                variance_time=$(calculate_sample_variance "$avg_time" "$NUM_RUNS" "${record_time[@]}")
+                gflops=$(echo "scale=10; $work / $avg_time / 1000000000" | bc)
+
+                if [ $threads -eq 1 ]; then
+                    base_time=$avg_time
+                    base_work=$work
+                fi
+
+                # Speedup, efficiency and Karp-Flatt metric relative to 1 thread
+                speedup=$(echo "scale=10; ($base_time / $avg_time) * ($work / $base_work)" | bc)
+                efficiency=$(echo "scale=10; $speedup / $threads" | bc)
+                karp_flatt=""
+                if [ $threads -gt 1 ]; then
+                    karp_flatt=$(echo "scale=10; (1 / $speedup - 1 / $threads) / (1 - 1 / $threads)" | bc)
+                fi
+
+                # Write the result into the CSV file
+                echo "$mode,$smt,$algo,$threads,$dimension,$avg_time,$variance_time,$gflops,$speedup,$efficiency,$karp_flatt" >> "$filename"
+            done
+        done
+    done
+done
+
+# Print the final result
+cat "$filename"
@@ -0,0 +1,27 @@
+#!/bin/bash
+# Note: Make sure to run the manfile in the root directory with
+# benchmark/matrix_spgemm_benchmark.c as TEST_FILE to get the correct
+# program when compiling using manfile.
+
+# Dimensions to benchmark
+dimensions=(10000 100000 1000000)
+
+# Minimum degree (nonzeros per row) of the power-law matrices
+MIN_DEGREE=4
+
+# Seed for reproducability when running benchmark
+SEED=43
+
+# Number of threads, defaults to the number of online CPUs
+NUM_THREADS=${NUM_THREADS:-$(nproc)}
+
+# Filename to store the benchmark data in
+filename="benchmark/data/spgemm_results.csv"
+
+# Add the headers / categories into the start of the CSV file
+echo "Accumulator,Dimension,Threads,Nonzeros A,Max Row Nonzeros A,Nonzeros C,Multiply-Adds,Time (seconds),MFLOP/s" > "$filename"
+
+for dimension in "${dimensions[@]}"; do
+    echo "Working on dimension $dimension..."
+    ./program $dimension $MIN_DEGREE $SEED $NUM_THREADS 0 >> "$filename"
+done
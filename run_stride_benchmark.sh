@@ -0,0 +1,126 @@
+#!/bin/bash
+# Note: Make sure to run the manfile in the root directory with matrix_mult_benchmark.c
+# to get the correct program when compiling using manfile.
+#
+# Compares power-of-two dimensions (1024, 2048, 4096) against nearby
+# non-power-of-two dimensions (1000, 2000, 4000) with and without padded
+# rows (see matrix_set_padded_stride() in src/shared/matrix.h).
+
+sum_array() {
+    local arr=("$@")
+    local total=0
+    for val in "${arr[@]}"; do
+        total=$(echo "scale=10; $total + $val" | bc)
+    done
+
+    echo "$total"
+}
+
+# Assumes NUM_RUNS > 1.
+calculate_sample_variance() {
+    # First argument
+    local mean=$1
+    # Shift drops the first argument and shifts so that arg $n -> arg $n-1
+    shift
+    local NUM_RUNS=$1
+    shift
+    # Rest of arguments are the array elements
+    local arr=("$@")
+    local sse=0
+    for val in "${arr[@]}"; do
+        sse=$(echo "scale=10; $sse + ($mean - $val) * ($mean - $val)" | bc)
+    done
+
+    local_sample_variance=$(echo "scale=10; $sse / ($NUM_RUNS - 1)" | bc)
+
+    echo "$local_sample_variance"
+}
+
+# Algorithm to benchmark the padded stride with
+algo=MULTITHREAD_9AVX
+
+# Filename to store the benchmark data in
+filename="benchmark/data/${algo}_stride_results.csv"
+
+# Add the headers / categories into the start of the CSV file.
+echo "Padded Stride,Dimension,Average Execution Time (seconds),Cache-Misses,Cache-References,Cache-Miss-Rate,Execution Time Variance,Cache-Miss-Rate Variance" > "$filename"
+
+# Power-of-two dimensions next to their non-power-of-two neighbours
+dimensions=(1000 1024 2000 2048 4000 4096)
+
+# 0 = rows of exactly num_cols doubles (before), 1 = padded rows (after)
+padded_options=(0 1)
+
+# Using previously found optimal block size (see run_block_size_benchmark.sh)
+BLOCK_SIZE=128
+
+# Default prefetch distance and no huge pages (see matrix_mult_benchmark.c)
+PREFETCH_DISTANCE=64
+HUGE_PAGES=0
+
+# Number of runs for each (padded, dimension) benchmark
+NUM_RUNS=10
+
+# Seed for reproducability when running benchmark
+SEED=42
+
+# Data for perf to collect
+metrics="cache-misses,cache-references"
+
+# Compile and link the code to create benchmark program
+echo "Compiling and linking $algo..."
+./manfile > /dev/null 2>&1
+
+for padded in "${padded_options[@]}"; do
+    for dimension in "${dimensions[@]}"; do
+
+        # Perform warm-up
+        echo "Warm-up $algo (padded $padded) with dimension size of $dimension..."
+        ./program $algo $dimension $SEED $BLOCK_SIZE 1 $PREFETCH_DISTANCE $HUGE_PAGES $padded > /dev/null
+
+        record_time=()
+        record_cache_misses=()
+        record_cache_references=()
+        record_cache_miss_rate=()
+
+        for (( run=0; run<NUM_RUNS; run++ )); do
+
+            echo "Performing run $run..."
+            perf stat -o perf_report.txt -e $metrics ./program $algo $dimension $SEED $BLOCK_SIZE 0 $PREFETCH_DISTANCE $HUGE_PAGES $padded > /dev/null
+
+            # Extract the metrics from perf report
+            time=$(cat perf_report.txt | grep "elapsed" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
+            cache_misses=$(cat perf_report.txt | grep "cache-misses" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
+            cache_references=$(cat perf_report.txt | grep "cache-references" | awk -F ' ' '{print $1}' | tr -d ',' | tr -d ' ')
+
+            cache_miss_rate=0
+            if [ "$cache_references" -ne 0 ] 2>/dev/null; then
+                cache_miss_rate=$(echo "scale=10; $cache_misses / $cache_references" | bc)
+            fi
+
+            record_time+=("$time")
+            record_cache_misses+=("$cache_misses")
+            record_cache_references+=("$cache_references")
+            record_cache_miss_rate+=("$cache_miss_rate")
+        done
+
+        # Calculate the mean of each recorded data
+        avg_time=$(echo "scale=10; $(sum_array "${record_time[@]}") / $NUM_RUNS" | bc)
+        avg_cache_misses=$(echo "scale=10; $(sum_array "${record_cache_misses[@]}") / $NUM_RUNS" | bc)
+        avg_cache_references=$(echo "scale=10; $(sum_array "${record_cache_references[@]}") / $NUM_RUNS" | bc)
+        avg_cache_miss_rate=$(echo "scale=10; $(sum_array "${record_cache_miss_rate[@]}") / $NUM_RUNS" | bc)
+
+        # Sample variance of the execution time and cache-miss rate
+        variance_time=$(calculate_sample_variance "$avg_time" "$NUM_RUNS" "${record_time[@]}")
+        variance_cache_miss_rate=$(calculate_sample_variance "$avg_cache_miss_rate" "$NUM_RUNS" "${record_cache_miss_rate[@]}")
+
+        # Write the result into the CSV file
+        echo "$padded,$dimension,$avg_time,$avg_cache_misses,$avg_cache_references,$avg_cache_miss_rate,$variance_time,$variance_cache_miss_rate" >> "$filename"
+    done
+done
+
+# Clean-up
+rm perf_report.txt
+
+# Print the final result
+cat "$filename"
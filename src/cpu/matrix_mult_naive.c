@@ -31,17 +31,28 @@ void matrix_mult_naive(Matrix* A, Matrix* B, Matrix* C) {
         return;
     }
 
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return;
+    }
+
     // retrieve internal Matrix arrays
     double* A_arr = A->values;
     double* B_arr = B->values;
     double* C_arr = C->values;
 
+    // Extract the row strides (equal to the number of columns if not padded)
+    size_t a_stride = A->stride;
+    size_t b_stride = B->stride;
+    size_t c_stride = C->stride;
+
     for (size_t i = 0; i < n; i++) {
         for (size_t j = 0; j < p; j++) {
 
             // Calculate the dot product for this cell in C
             for (size_t k = 0; k < m; k++) {
-                C_arr[i * p + j] += A_arr[i * m + k] * B_arr[k * p + j];
+                C_arr[i * c_stride + j] += A_arr[i * a_stride + k] * B_arr[k * b_stride + j];
             }
         }
     }
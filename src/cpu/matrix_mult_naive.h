@@ -16,7 +16,8 @@
  * @brief Performs naive matrix multiplication on matrices A and B,
  * storing the result in matrix C.
  *
- * @note Matrix C must be pre-allocated by the caller.
+ * @note Matrix C must be pre-allocated by the caller. All three
+ * matrices have to be row-major.
  *
  * @param A Pointer to the first input Matrix (dimensions n x m).
  * @param B Pointer to the second input Matrix (dimensions m x p).
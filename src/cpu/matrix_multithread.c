@@ -6,6 +6,7 @@
 #include "../shared/matrix.h"
 #include "../shared/queue.h"
 #include "../shared/matrix_utils.h"
+#include "../shared/stats.h"
 
 /**
  * @brief Helper function for matrix_multithread_mult(). It allocates a
@@ -23,20 +24,22 @@
 Queue* preprocessing(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
 
     // Create a new Matrix that is the transpose of Matrix B
-    double* B_trans_arr = NULL;
-    int result = posix_memalign((void**)&B_trans_arr, 64, sizeof(double) * B->num_rows * B->num_cols);
-    if (result != 0) {
-        perror("Error: Allocation of B transposed array failed");
+    size_t B_trans_stride = matrix_row_stride(B->num_rows);
+    size_t mapped_size = 0;
+    double* B_trans_arr = matrix_alloc_values(B->num_cols * B_trans_stride, &mapped_size);
+    if (!B_trans_arr) {
         return NULL;
     }
 
     // Insert transposed values and Allocate Matrix
     for (size_t i = 0; i < B->num_rows; i++) {
         for (size_t j = 0; j < B->num_cols; j++) {
-            B_trans_arr[j * B->num_rows + i] = B->values[i * B->num_cols + j];
+            B_trans_arr[j * B_trans_stride + i] = B->values[i * B->stride + j];
         }
     }
     Matrix* B_trans = matrix_create_from_pointers(B->num_cols, B->num_rows, B_trans_arr);
+    B_trans->stride = B_trans_stride;
+    B_trans->mapped_size = mapped_size;
 
     // Extract Matrix dimensions for C
     size_t n = A->num_rows;
@@ -108,7 +111,11 @@ void thread_mult(Task t) {
 
     // Extract Matrix dimensions
     size_t m = A->num_cols;
-    size_t p = B_trans->num_rows;
+
+    // Extract the row strides (equal to the number of columns if not padded)
+    size_t a_stride = A->stride;
+    size_t b_trans_stride = B_trans->stride;
+    size_t c_stride = C->stride;
 
     // retrieve internal Matrix arrays
     double* A_arr = A->values;
@@ -130,13 +137,13 @@ void thread_mult(Task t) {
 
         // These two loops let us consider a single element in C
         for (size_t ii = C_row_start; ii < C_row_end; ii++) {
-            size_t a_row_offset = ii * m;
+            size_t a_row_offset = ii * a_stride;
             for (size_t jj = C_col_start; jj < C_col_end; jj++) {
 
                 // This loop handles the dot product (using SIMD)
                 size_t kk = k;
-                size_t c_index = ii * p + jj;
-                size_t b_row_offset = jj * m;
+                size_t c_index = ii * c_stride + jj;
+                size_t b_row_offset = jj * b_trans_stride;
                 double c_value = C_arr[c_index];
                 for (; kk + 3 < k_min; kk += 4) {
                     c_value += A_arr[a_row_offset + kk] * B_trans_arr[b_row_offset + kk];
@@ -175,6 +182,7 @@ void* process_tasks(void* arg) {
 
     // Extract argument
     Queue* q = (Queue*) arg;
+    uint64_t busy_ns = 0;
 
     // Keep going until the Queue is empty (true due to mutex for Queue)
     while (true) {
@@ -205,10 +213,15 @@ void* process_tasks(void* arg) {
             break;
         } else {
             // Perform Matrix multiplication with the Task
+            uint64_t busy_start = now_ns();
             thread_mult(t);
+            busy_ns += now_ns() - busy_start;
         }
     }
 
+    // Add the busy time of this thread once it runs out of Tasks
+    stats_record_busy(STATS_MULTITHREAD, busy_ns);
+
     return NULL;
 }
 
@@ -240,6 +253,12 @@ void matrix_multithread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size,
         return;
     }
 
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return;
+    }
+
     size_t min_nm = min(n, m);
     if (block_size == 0) {
         errno = EINVAL;
@@ -252,10 +271,13 @@ void matrix_multithread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size,
     block_size = (block_size > smallest_dimension) ? smallest_dimension : block_size;
 
     // Create a Queue filled with all the tasks / blocks to calculate in C
+    uint64_t stats_start = now_ns();
     Queue* q = preprocessing(A, B, C, block_size);
 
     // Retrieve a pointer to B_transposed so that it can be later freed
     Matrix* B_trans = queue_peek(q).B_trans;
+    stats_record_bytes(STATS_MULTITHREAD, sizeof(double) * B_trans->num_rows * B_trans->stride,
+                       sizeof(Queue) + sizeof(Task) * q->capacity);
 
     // Initialize the mutex for the Queue
     pthread_mutex_init(&queue_lock, NULL);
@@ -305,5 +327,8 @@ void matrix_multithread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size,
 
     // Destory the Queue mutex
     pthread_mutex_destroy(&queue_lock);
+
+    stats_record_call(STATS_MULTITHREAD, n, m, p, NUM_THREADS,
+                      now_ns() - stats_start);
 }
 
@@ -2,43 +2,134 @@
 #include <stdio.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <time.h>
 #include "matrix_multithread_9avx.h"
 #include "../shared/matrix.h"
 #include "../shared/queue.h"
 #include "../shared/matrix_utils.h"
+#include "../shared/stats.h"
+#include "../shared/matrix_verification.h"
+#include "../shared/trace.h"
 // For SIMD
 #include <immintrin.h>
 
+// The number of rows of B in a chunk of a panel, the unit of the transposition
+#define PANEL_CHUNK_ROWS 64
+
+// The state of a panel of B transposed during a multiplication
+typedef enum {
+    PANEL_PENDING = 0, // = 0 such that calloc() initializes the states
+    PANEL_IN_PROGRESS,
+    PANEL_READY
+} PanelState;
+
+// The state of one multiplication, reached from each of its Tasks
+typedef struct {
+
+    // The Tasks of the multiplication and the mutex guarding them and the panels
+    Queue* q;
+    pthread_mutex_t queue_lock;
+
+    // Matrix B, transposed panel by panel if row-major
+    Matrix* B;
+
+    // The state of each panel of B transposed, the next chunk to claim and
+    // the number of chunks done of each panel, out of num_chunks
+    PanelState* panel_state;
+    size_t* panel_next_chunk;
+    size_t* panel_chunks_done;
+    size_t num_chunks;
+
+} PanelContext;
+
+/**
+ * @brief Free the panel states of a multiplication.
+ *
+ * @param ctx Pointer to the PanelContext of the multiplication.
+*/
+void free_panels_9avx(PanelContext* ctx) {
+
+    free(ctx->panel_state);
+    free(ctx->panel_next_chunk);
+    free(ctx->panel_chunks_done);
+    ctx->panel_state = NULL;
+    ctx->panel_next_chunk = NULL;
+    ctx->panel_chunks_done = NULL;
+}
+
 /**
  * @brief Helper function for matrix_multithread_mult(). It allocates a
  * Matrix B transposed for the Matrix calculations. This Matrix is
- * freed at the end of matrix_multithread_mult(). This function also
- * establishes a Queue object and fills it with Task objects that
- * reflect each subjob / block that needs to be calculated in Matrix C.
+ * freed at the end of matrix_multithread_mult(). The values of B
+ * transposed are not filled in here: each panel (block_size columns of
+ * B) is transposed by the first worker that needs it, see
+ * transpose_panel_9avx(). If A or B is column-major, B is not
+ * transposed and B_trans is a view of the values of B instead (the
+ * rows of B transposed for a column-major B, and B itself for a
+ * row-major B with a column-major A). This function also establishes a Queue
+ * object and fills it with Task objects that reflect each subjob /
+ * block that needs to be calculated in Matrix C.
  *
  * @param A Pointer to Matrix A (A x B = C).
  * @param B Pointer to Matrix B.
  * @param C Pointer to Matrix C.
  * @param block_size The block size used in the blocking / tiling method.
+ * @param ctx Pointer to the PanelContext of the multiplication, which
+ * receives the panel states and the Queue.
  * @return Pointer to the Queue.
 */
-Queue* preprocessing_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
+Queue* preprocessing_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_size, PanelContext* ctx) {
 
-    // Create a new Matrix that is the transpose of Matrix B
-    double* B_trans_arr = NULL;
-    int result = posix_memalign((void**)&B_trans_arr, 64, sizeof(double) * B->num_rows * B->num_cols);
-    if (result != 0) {
-        perror("Error: Allocation of B transposed array failed");
-        return NULL;
-    }
+    // Only the dot products of two row-major matrices need B transposed
+    bool transpose_b = (A->layout == MATRIX_ROW_MAJOR && B->layout == MATRIX_ROW_MAJOR);
+
+    Matrix* B_trans = NULL;
+    if (transpose_b) {
+
+        // Allocate a new Matrix that will hold the transpose of Matrix B
+        size_t B_trans_stride = matrix_row_stride(B->num_rows);
+        size_t mapped_size = 0;
+        double* B_trans_arr = matrix_alloc_values(B->num_cols * B_trans_stride, &mapped_size);
+        if (!B_trans_arr) {
+            return NULL;
+        }
 
-    // Insert transposed values and Allocate Matrix
-    for (size_t i = 0; i < B->num_rows; i++) {
-        for (size_t j = 0; j < B->num_cols; j++) {
-            B_trans_arr[j * B->num_rows + i] = B->values[i * B->num_cols + j];
+        B_trans = matrix_create_from_pointers(B->num_cols, B->num_rows, B_trans_arr);
+        B_trans->stride = B_trans_stride;
+        B_trans->mapped_size = mapped_size;
+    } else {
+
+        // A view of the values of B (with its layout), which stay owned by B
+        if (B->layout == MATRIX_COL_MAJOR) {
+            B_trans = matrix_create_col_major_from_pointers(B->num_rows, B->num_cols, B->values);
+        } else {
+            B_trans = matrix_create_from_pointers(B->num_rows, B->num_cols, B->values);
+        }
+        if (!B_trans) {
+            return NULL;
         }
+        B_trans->stride = B->stride;
+        B_trans->owns_rows = false;
+    }
+
+    // No panel of B transposed is filled in yet (all are ready without a transposition)
+    size_t num_panels = (B->num_cols + block_size - 1) / block_size;
+    ctx->panel_state = (PanelState*)calloc(num_panels, sizeof(PanelState));
+    ctx->panel_next_chunk = (size_t*)calloc(num_panels, sizeof(size_t));
+    ctx->panel_chunks_done = (size_t*)calloc(num_panels, sizeof(size_t));
+    if (!ctx->panel_state || !ctx->panel_next_chunk || !ctx->panel_chunks_done) {
+        perror("Error: Allocation of panel states failed");
+        free_panels_9avx(ctx);
+        matrix_free(B_trans);
+        return NULL;
+    }
+    ctx->num_chunks = (B->num_rows + PANEL_CHUNK_ROWS - 1) / PANEL_CHUNK_ROWS;
+    for (size_t panel = 0; panel < num_panels && !transpose_b; panel++) {
+        ctx->panel_state[panel] = PANEL_READY;
     }
-    Matrix* B_trans = matrix_create_from_pointers(B->num_cols, B->num_rows, B_trans_arr);
+    ctx->B = B;
 
     // Extract Matrix dimensions for C
     size_t n = A->num_rows;
@@ -74,9 +165,20 @@ Queue* preprocessing_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
     }
 
     // Set up Queue
+    uint64_t queue_start = trace_begin();
     Queue* q = queue_create(num_tasks);
+    if (!q) {
+        free_panels_9avx(ctx);
+        matrix_free(B_trans);
+        return NULL;
+    }
+    ctx->q = q;
 
-    // Turn each block in C into a Task for the Queue
+    /*
+     * Turn each block in C into a Task for the Queue. The first row of
+     * blocks covers every panel, so the first Tasks taken by the threads
+     * transpose different panels in parallel.
+    */
     for (size_t i = 0; i < n; i += block_size) {
         for (size_t j = 0; j < p; j += block_size) {
 
@@ -86,13 +188,217 @@ Queue* preprocessing_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
 
             // Store the block inside a Task and enqueue it
             Task t = task_create(A, B_trans, C, block_size, i, j, i_max, j_max);
+            t.context = ctx;
             queue_add(q, t);
         }
     }
+    trace_end(queue_start, "build_queue", "preprocessing", num_tasks, block_size);
 
     return q;
 }
 
+/**
+ * @brief Transpose the rows row_start to row_end and columns col_start
+ * to col_end (exclusive) of Matrix B into B transposed.
+ *
+ * @param B Pointer to Matrix B.
+ * @param B_trans Pointer to B transposed.
+ * @param row_start The first row of B in the chunk.
+ * @param row_end The row of B after the chunk.
+ * @param col_start The first column of B in the panel.
+ * @param col_end The column of B after the panel.
+*/
+void transpose_panel_9avx(Matrix* B, Matrix* B_trans, size_t row_start, size_t row_end,
+                          size_t col_start, size_t col_end) {
+
+    size_t b_stride = B->stride;
+    size_t b_trans_stride = B_trans->stride;
+    double* B_arr = B->values;
+    double* B_trans_arr = B_trans->values;
+
+    // Read the rows of B contiguously, write block_size rows of B transposed
+    for (size_t i = row_start; i < row_end; i++) {
+        for (size_t j = col_start; j < col_end; j++) {
+            B_trans_arr[j * b_trans_stride + i] = B_arr[i * b_stride + j];
+        }
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_col_9avx() for a column-major A
+ * and a row-major B. Updates a micro-tile of up to 4 rows and 8 columns
+ * of C with k_len columns of A, broadcasting the elements of A.
+ *
+ * @param a Pointer to the element of A in the first row of the
+ * micro-tile (column k).
+ * @param b Pointer to the first column of the micro-tile in B (row k).
+ * @param c Pointer to the top-left element of the micro-tile in C.
+ * @param num_rows The number of rows of the micro-tile (1-4).
+*/
+void tile_a_col_9avx(const double* a, size_t a_stride, const double* b, size_t b_stride,
+                     double* c, size_t c_stride, size_t num_rows, size_t k_len) {
+
+    __m256d c_vec[4][2];
+    for (size_t r = 0; r < num_rows; r++) {
+        c_vec[r][0] = _mm256_loadu_pd(&c[r * c_stride]);
+        c_vec[r][1] = _mm256_loadu_pd(&c[r * c_stride + 4]);
+    }
+
+    for (size_t kk = 0; kk < k_len; kk++) {
+        __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+        __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+        for (size_t r = 0; r < num_rows; r++) {
+            __m256d a_val = _mm256_broadcast_sd(&a[kk * a_stride + r]);
+            c_vec[r][0] = _mm256_fmadd_pd(a_val, b_vals1, c_vec[r][0]);
+            c_vec[r][1] = _mm256_fmadd_pd(a_val, b_vals2, c_vec[r][1]);
+        }
+    }
+
+    for (size_t r = 0; r < num_rows; r++) {
+        _mm256_storeu_pd(&c[r * c_stride], c_vec[r][0]);
+        _mm256_storeu_pd(&c[r * c_stride + 4], c_vec[r][1]);
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_col_9avx() for a column-major A
+ * and a column-major B. Adds the product of k_len columns of A and rows
+ * of B to a micro-tile of 8 rows and 4 columns of C. The accumulators
+ * hold columns of the micro-tile, which are transposed (4 x 4 at a time)
+ * into rows before they are added to C.
+ *
+ * @param a Pointer to the element of A in the first row of the
+ * micro-tile (column k).
+ * @param b Pointer to the element of B in the first column of the
+ * micro-tile (row k), the columns of B are contiguous.
+ * @param c Pointer to the top-left element of the micro-tile in C.
+*/
+void tile_ab_col_9avx(const double* a, size_t a_stride, const double* b, size_t b_stride,
+                      double* c, size_t c_stride, size_t k_len) {
+
+    __m256d c_vec[2][4];
+    for (size_t v = 0; v < 2; v++) {
+        for (size_t col = 0; col < 4; col++) {
+            c_vec[v][col] = _mm256_setzero_pd();
+        }
+    }
+
+    for (size_t kk = 0; kk < k_len; kk++) {
+        __m256d a_vals1 = _mm256_loadu_pd(&a[kk * a_stride]);
+        __m256d a_vals2 = _mm256_loadu_pd(&a[kk * a_stride + 4]);
+        for (size_t col = 0; col < 4; col++) {
+            __m256d b_val = _mm256_broadcast_sd(&b[col * b_stride + kk]);
+            c_vec[0][col] = _mm256_fmadd_pd(a_vals1, b_val, c_vec[0][col]);
+            c_vec[1][col] = _mm256_fmadd_pd(a_vals2, b_val, c_vec[1][col]);
+        }
+    }
+
+    // Transpose the columns of each 4 x 4 half and add the rows to C
+    for (size_t v = 0; v < 2; v++) {
+        __m256d t0 = _mm256_unpacklo_pd(c_vec[v][0], c_vec[v][1]);
+        __m256d t1 = _mm256_unpackhi_pd(c_vec[v][0], c_vec[v][1]);
+        __m256d t2 = _mm256_unpacklo_pd(c_vec[v][2], c_vec[v][3]);
+        __m256d t3 = _mm256_unpackhi_pd(c_vec[v][2], c_vec[v][3]);
+        __m256d rows[4];
+        rows[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+        rows[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+        rows[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+        rows[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+        for (size_t r = 0; r < 4; r++) {
+            double* c_row = &c[(v * 4 + r) * c_stride];
+            _mm256_storeu_pd(c_row, _mm256_add_pd(_mm256_loadu_pd(c_row), rows[r]));
+        }
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_col_9avx(). Handles the rows
+ * row_start to row_end and columns col_start to col_end (exclusive) of
+ * C not covered by the micro-tiles, for the columns k_start to k_end of
+ * a column-major A. Element (k, j) of B is found at
+ * k * b_k_step + j * b_j_step.
+*/
+void residual_col_9avx(Matrix* A, Matrix* B, Matrix* C, size_t row_start, size_t row_end,
+                       size_t col_start, size_t col_end, size_t k_start, size_t k_end,
+                       size_t b_k_step, size_t b_j_step) {
+
+    for (size_t r = row_start; r < row_end; r++) {
+        for (size_t j = col_start; j < col_end; j++) {
+            double c_value = C->values[r * C->stride + j];
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                c_value += A->values[kk * A->stride + r] * B->values[kk * b_k_step + j * b_j_step];
+            }
+            C->values[r * C->stride + j] = c_value;
+        }
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_9avx() for a column-major A.
+ * Neither A nor B is transposed: t.B_trans holds B itself, with its
+ * layout. With a row-major B, the elements of A are broadcast, and with
+ * a column-major B, the elements of B are broadcast.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_col_9avx(Task t) {
+
+    // Matrices: A x B = C
+    Matrix* A = t.A;
+    Matrix* B = t.B_trans;
+    Matrix* C = t.C;
+
+    size_t m = A->num_cols;
+    size_t a_stride = A->stride;
+    size_t b_stride = B->stride;
+    size_t c_stride = C->stride;
+    double* A_arr = A->values;
+    double* B_arr = B->values;
+    double* C_arr = C->values;
+    size_t block_size = t.block_size;
+
+    // The distances between two elements of B in the shared dimension and in a row
+    bool b_col_major = (B->layout == MATRIX_COL_MAJOR);
+    size_t b_k_step = b_col_major ? 1 : b_stride;
+    size_t b_j_step = b_col_major ? b_stride : 1;
+
+    // Loop goes through blocks in the shared dimension
+    for (size_t k = 0; k < m; k += block_size) {
+        size_t k_min = min(k + block_size, m);
+        size_t ii = t.C_row_start;
+
+        if (!b_col_major) {
+            for (; ii < t.C_row_end; ii += 4) {
+                size_t num_rows = min(4, t.C_row_end - ii);
+                size_t jj = t.C_col_start;
+
+                // The constant 4 for full micro-tiles lets the compiler keep the accumulators in registers
+                for (; jj + 7 < t.C_col_end; jj += 8) {
+                    if (num_rows == 4) {
+                        tile_a_col_9avx(&A_arr[k * a_stride + ii], a_stride, &B_arr[k * b_stride + jj], b_stride,
+                                        &C_arr[ii * c_stride + jj], c_stride, 4, k_min - k);
+                    } else {
+                        tile_a_col_9avx(&A_arr[k * a_stride + ii], a_stride, &B_arr[k * b_stride + jj], b_stride,
+                                        &C_arr[ii * c_stride + jj], c_stride, num_rows, k_min - k);
+                    }
+                }
+                residual_col_9avx(A, B, C, ii, ii + num_rows, jj, t.C_col_end, k, k_min, b_k_step, b_j_step);
+            }
+        } else {
+            for (; ii + 7 < t.C_row_end; ii += 8) {
+                size_t jj = t.C_col_start;
+                for (; jj + 3 < t.C_col_end; jj += 4) {
+                    tile_ab_col_9avx(&A_arr[k * a_stride + ii], a_stride, &B_arr[jj * b_stride + k], b_stride,
+                                     &C_arr[ii * c_stride + jj], c_stride, k_min - k);
+                }
+                residual_col_9avx(A, B, C, ii, ii + 8, jj, t.C_col_end, k, k_min, b_k_step, b_j_step);
+            }
+            residual_col_9avx(A, B, C, ii, t.C_row_end, t.C_col_start, t.C_col_end, k, k_min, b_k_step, b_j_step);
+        }
+    }
+}
+
 /**
  * @brief Helper function to task_worker(). This function encapsulates
  * the Matrix multiplication done by a single thread given the input
@@ -108,9 +414,19 @@ void thread_mult_9avx(Task t) {
     Matrix* B_trans = t.B_trans;
     Matrix* C = t.C;
 
+    // A column-major A has its own access patterns
+    if (A->layout == MATRIX_COL_MAJOR) {
+        thread_mult_col_9avx(t);
+        return;
+    }
+
     // Extract Matrix dimensions
     size_t m = A->num_cols;
-    size_t p = B_trans->num_rows;
+
+    // Extract the row strides (equal to the number of columns if not padded)
+    size_t a_stride = A->stride;
+    size_t b_trans_stride = B_trans->stride;
+    size_t c_stride = C->stride;
 
     // retrieve internal Matrix arrays
     double* A_arr = A->values;
@@ -132,13 +448,13 @@ void thread_mult_9avx(Task t) {
 
         // These two loops let us consider a single element in C
         for (size_t ii = C_row_start; ii < C_row_end; ii++) {
-            size_t a_row_offset = ii * m;
+            size_t a_row_offset = ii * a_stride;
             for (size_t jj = C_col_start; jj < C_col_end; jj++) {
 
                 // This loop handles the dot product (using SIMD)
                 size_t kk = k;
-                size_t c_index = ii * p + jj;
-                size_t b_row_offset = jj * m;
+                size_t c_index = ii * c_stride + jj;
+                size_t b_row_offset = jj * b_trans_stride;
                 double c_value = C_arr[c_index];
 
                 /*
@@ -206,16 +522,13 @@ void thread_mult_9avx(Task t) {
     }
 }
 
-// Mutex lock used to access the Queue
-pthread_mutex_t queue_lock_9avx;
-
 /**
  * @brief Function used by the threads. A thread will access the Queue
  * and retrieve a Task object that describes a block of Matrix C that
  * needs to be calculated.
  *
- * @param A pointer to a ThreadArgs object on the heap that
- * contains the Queue.
+ * @param A pointer to the PanelContext of the multiplication that
+ * contains the Queue and its mutex.
  *
  * @return In both cases of success and failure, it returns NULL.
  * Failures are however logged using perror.
@@ -223,7 +536,14 @@ pthread_mutex_t queue_lock_9avx;
 void* process_tasks_9avx(void* arg) {
 
     // Extract argument
-    Queue* q = (Queue*) arg;
+    PanelContext* ctx = (PanelContext*) arg;
+    Queue* q = ctx->q;
+    uint64_t busy_ns = 0;
+    uint64_t worker_start = trace_begin();
+    size_t num_tasks_done = 0;
+
+    // The number of Tasks in a row this thread put back into the Queue
+    size_t num_requeued = 0;
 
     // Keep going until the Queue is empty (true due to mutex for Queue)
     while (true) {
@@ -232,10 +552,12 @@ void* process_tasks_9avx(void* arg) {
         bool is_empty;
 
         // Lock the Queue with the mutex before accessing
-        if (pthread_mutex_lock(&queue_lock_9avx) != 0) {
+        uint64_t lock_start = trace_begin();
+        if (pthread_mutex_lock(&ctx->queue_lock) != 0) {
             perror("Error: Mutex lock failed");
             return NULL;
         }
+        trace_end(lock_start, "lock_wait", "queue", 0, 0);
 
         // Retrieve Queue data
         is_empty = queue_is_empty(q);
@@ -243,8 +565,49 @@ void* process_tasks_9avx(void* arg) {
             t = queue_get(q);
         }
 
+        /*
+         * Until the panel of the Task is ready, transpose the chunks of it
+         * no other thread has claimed (releasing the Queue meanwhile). Once
+         * all chunks are claimed, the Task goes back to the end of the
+         * Queue instead of waiting for the other threads.
+        */
+        PanelContext* panels = is_empty ? NULL : (PanelContext*)t.context;
+        size_t panel = is_empty ? 0 : t.C_col_start / t.block_size;
+        while (!is_empty && panels->panel_state[panel] != PANEL_READY &&
+               panels->panel_next_chunk[panel] < panels->num_chunks) {
+            size_t chunk = panels->panel_next_chunk[panel]++;
+            panels->panel_state[panel] = PANEL_IN_PROGRESS;
+            pthread_mutex_unlock(&ctx->queue_lock);
+
+            size_t row_start = chunk * PANEL_CHUNK_ROWS;
+            size_t row_end = min(row_start + PANEL_CHUNK_ROWS, panels->B->num_rows);
+            uint64_t transpose_start = trace_begin();
+            uint64_t chunk_start = now_ns();
+            transpose_panel_9avx(panels->B, t.B_trans, row_start, row_end, t.C_col_start, t.C_col_end);
+            busy_ns += now_ns() - chunk_start;
+            trace_end(transpose_start, "transpose_panel", "preprocessing", t.C_col_start, row_start);
+
+            // The Tasks of this panel are runnable once all chunks are done
+            pthread_mutex_lock(&ctx->queue_lock);
+            panels->panel_chunks_done[panel]++;
+            if (panels->panel_chunks_done[panel] == panels->num_chunks) {
+                panels->panel_state[panel] = PANEL_READY;
+            }
+        }
+
+        bool is_ready = is_empty || panels->panel_state[panel] == PANEL_READY;
+        if (!is_ready) {
+            queue_add(q, t);
+            num_requeued++;
+        } else {
+            num_requeued = 0;
+        }
+
+        // Every Task of the Queue has been put back once, all wait for the other threads
+        bool all_waiting = (num_requeued > 0 && num_requeued >= q->size);
+
         // Unlock the Queue
-        if(pthread_mutex_unlock(&queue_lock_9avx) != 0) {
+        if(pthread_mutex_unlock(&ctx->queue_lock) != 0) {
             perror("Error: Mutex unlock failed");
             return NULL;
         }
@@ -252,12 +615,29 @@ void* process_tasks_9avx(void* arg) {
         if (is_empty) {
             // Queue is empty, unlock mutex and leave
             break;
+        } else if (!is_ready) {
+            // Let the threads transposing the remaining chunks run
+            if (all_waiting) {
+                sched_yield();
+                num_requeued = 0;
+            }
         } else {
             // Perform Matrix multiplication with the Task
+            uint64_t task_start = trace_begin();
+            uint64_t busy_start = now_ns();
             thread_mult_9avx(t);
+            busy_ns += now_ns() - busy_start;
+            trace_end(task_start, "task", "compute", t.C_row_start, t.C_col_start);
+            num_tasks_done++;
         }
     }
 
+    // The worker span shows the idle tail after the last Task
+    trace_end(worker_start, "worker", "thread", num_tasks_done, 0);
+
+    // Add the busy time of this thread once it runs out of Tasks
+    stats_record_busy(STATS_MULTITHREAD_9AVX, busy_ns);
+
     return NULL;
 }
 
@@ -289,6 +669,12 @@ void matrix_multithread_mult_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_
         return;
     }
 
+    if (A->layout == MATRIX_TILE_MAJOR || B->layout == MATRIX_TILE_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: A and B have to be row-major or column-major and C row-major");
+        return;
+    }
+
     size_t min_nm = min(n, m);
     if (block_size == 0) {
         errno = EINVAL;
@@ -301,58 +687,69 @@ void matrix_multithread_mult_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_
     block_size = (block_size > smallest_dimension) ? smallest_dimension : block_size;
 
     // Create a Queue filled with all the tasks / blocks to calculate in C
-    Queue* q = preprocessing_9avx(A, B, C, block_size);
+    uint64_t mult_start = trace_begin();
+    uint64_t stats_start = now_ns();
+    PanelContext ctx = {0};
+    Queue* q = preprocessing_9avx(A, B, C, block_size, &ctx);
+    if (!q) {
+        return;
+    }
 
     // Retrieve a pointer to B_transposed so that it can be later freed
     Matrix* B_trans = queue_peek(q).B_trans;
+    size_t b_trans_bytes = B_trans->owns_rows ? sizeof(double) * B_trans->num_rows * B_trans->stride : 0;
+    stats_record_bytes(STATS_MULTITHREAD_9AVX, b_trans_bytes,
+                       sizeof(Queue) + sizeof(Task) * q->capacity);
 
-    // Initialize the mutex for the Queue
-    pthread_mutex_init(&queue_lock_9avx, NULL);
+    // Initialize the mutex for the Queue and the panels
+    pthread_mutex_init(&ctx.queue_lock, NULL);
 
     // Create array to hold threads
     pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
 
-    // Assign each thread to the task_worker() function
-    for (size_t i = 0; i < NUM_THREADS; i++) {
-
-        // Create a thread and check for successfull initialization
-        if (pthread_create(&threads[i], NULL, process_tasks_9avx, q) != 0) {
+    // Assign each thread to the process_tasks_9avx() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_9avx, &ctx) != 0) {
             perror("Error: Creating thread failed");
-
-            // Handle clean-up by canceling threads and freeing allocations
-            for (size_t j = 0; j < i; j++) {
-                if (pthread_cancel(threads[j]) != 0) {
-                    perror("Error: Canceling thread failed");
-                }
-            }
-
-            // Destory the Queue mutex
-            if (pthread_mutex_destroy(&queue_lock_9avx) != 0) {
-                perror("Error: Destorying queue_lock mutex failed");
-            }
-
-            return;
+            break;
         }
     }
 
-    // Have the main thread wait for each thread to finish
-    for (size_t i = 0; i < NUM_THREADS; i++) {
-
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
         if (pthread_join(threads[i], NULL) != 0) {
             perror("Error: pthread_join failed");
-
-            free(q);
-            pthread_mutex_destroy(&queue_lock_9avx);
-            free(C);
-            return;
         }
     }
 
     // Free allocated memory
-    free(q);
-    free(B_trans);
+    queue_free(q);
+    matrix_free(B_trans);
+    free_panels_9avx(&ctx);
 
     // Destory the Queue mutex
-    pthread_mutex_destroy(&queue_lock_9avx);
+    pthread_mutex_destroy(&ctx.queue_lock);
+
+    trace_end(mult_start, "matrix_multithread_mult_9avx", "api", n, p);
+
+    stats_record_call(STATS_MULTITHREAD_9AVX, n, m, p, NUM_THREADS,
+                      now_ns() - stats_start);
 }
 
+int matrix_multithread_mult_9avx_checked(Matrix* A, Matrix* B, Matrix* C,
+                                         size_t block_size, size_t NUM_THREADS,
+                                         size_t num_trials) {
+
+    matrix_multithread_mult_9avx(A, B, C, block_size, NUM_THREADS);
+
+    // Seed the random vectors differently for every call
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)(uintptr_t)C;
+    int result = matrix_verify_freivalds(A, B, C, num_trials,
+                                         FREIVALDS_DEFAULT_TOLERANCE, seed);
+    if (result == 1) {
+        fprintf(stderr, "Error: Freivalds check failed for matrix_multithread_mult_9avx()\n");
+    }
+
+    return result;
+}
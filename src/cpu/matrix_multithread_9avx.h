@@ -23,20 +23,55 @@
  * the relevant information. To access the Queue, the threads share
  * a single mutex.
  *
+ * B is not transposed up front by the calling thread. B transposed is
+ * split into panels of block_size rows (one per column block of C), and
+ * each panel into chunks of 64 rows of B. Every worker that takes a Task
+ * of a panel that is not ready transposes the chunks of the panel no
+ * other worker has claimed yet. Once all chunks are claimed, the Task is
+ * put back at the end of the Queue and the worker takes the next one
+ * instead of waiting for the chunks still being transposed by others.
+ * The transposition is thereby done in parallel, even with fewer panels
+ * than threads, and overlaps with the computation of the ready panels.
+ * The panel states and the Queue mutex belong to the call (reached from
+ * each Task), so concurrent calls do not share any state.
+ *
+ * A and B can each be row-major or column-major (C is row-major), and
+ * each of the four combinations has its own access pattern:
+ * - A row-major, B row-major: the dot products of rows of A and rows of
+ *   B transposed described above.
+ * - A row-major, B column-major: the values of B already are the rows
+ *   of B transposed, so the dot products use them directly and no panel
+ *   is transposed (or copied).
+ * - A column-major, B row-major: a micro-tile of 4 rows x 8 columns of C
+ *   stays in AVX registers while each element of A is broadcast and
+ *   multiplied with 8 contiguous elements of a row of B. Neither Matrix
+ *   is transposed.
+ * - A column-major, B column-major: 4 contiguous elements of a column of
+ *   A are multiplied with a broadcast element of B, for a micro-tile of
+ *   8 rows x 4 columns of C. The micro-tile is transposed in registers
+ *   before it is added to the rows of C. Neither Matrix is transposed.
+ *
  * For documentation on the blocking / tiling method,
  * see matrix_singlethread.h.
+ *
+ * If tracing is enabled (see trace.h), the preprocessing phases (Queue
+ * creation and every panel transposition), the Queue lock waits, every
+ * Task (with its C tile coordinates) and the
+ * lifetime of each worker thread are recorded.
  */
 
 #ifndef MATRIX_MULTITHREAD_9AVX_H
 #define MATRIX_MULTITHREAD_9AVX_H
 
 #include "../shared/matrix.h"
+#include "../shared/task.h"
 
 /**
  * @brief Matrix multiply the two matrices A and B. Matrix A is the
  * left-Matrix and Matrix B is the right-Matrix.
  *
- * @note Matrix C must be pre-allocated by the caller.
+ * @note Matrix C must be pre-allocated by the caller. A and B can be
+ * row-major or column-major, C has to be row-major.
  *
  * @param A Pointer to the first input Matrix (dimensions n x m).
  * @param B Pointer to the second input Matrix (dimensions m x p).
@@ -47,4 +82,48 @@
 */
 void matrix_multithread_mult_9avx(Matrix* A, Matrix* B, Matrix* C, size_t block_size, size_t NUM_THREADS);
 
+/**
+ * @brief Same as matrix_multithread_mult_9avx(), followed by a
+ * Freivalds check of the result (see matrix_verification.h). The check
+ * costs O(n^2) per trial and is intended as a low-overhead guard
+ * against silent kernel bugs in production.
+ *
+ * @note Matrix C must be pre-allocated and zero-filled by the caller.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @param num_trials The number of random vectors used by the check.
+ * @return A value of zero if the result passed the check, 1 if a
+ * mismatch was detected and -1 if an error occured.
+*/
+int matrix_multithread_mult_9avx_checked(Matrix* A, Matrix* B, Matrix* C,
+                                         size_t block_size, size_t NUM_THREADS,
+                                         size_t num_trials);
+
+/**
+ * @brief The tile kernel of matrix_multithread_mult_9avx(). Adds the
+ * product of the rows C_row_start..C_row_end-1 of t.A and the columns
+ * C_col_start..C_col_end-1 of B (over all t.A->num_cols columns of A)
+ * to the corresponding block of t.C, which has to be row-major.
+ *
+ * What t.B_trans holds depends on the layout of t.A:
+ * - A row-major: the rows of B transposed, i.e. the values of B
+ *   transposed in row-major order or of a column-major B. Only the
+ *   values and the stride of t.B_trans are read.
+ * - A column-major: B itself, read with the layout of t.B_trans
+ *   (MATRIX_ROW_MAJOR or MATRIX_COL_MAJOR).
+ *
+ * @note Exposed for blocked routines (e.g. matrix_multithread_triangular.h)
+ * that apply it to views into larger matrices. A view is a Matrix whose
+ * values point into another Matrix, with that Matrix's stride and layout.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_9avx(Task t);
+
 #endif // MATRIX_MULTITHREAD_9AVX_H
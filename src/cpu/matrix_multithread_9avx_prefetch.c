@@ -0,0 +1,455 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include "matrix_multithread_9avx_prefetch.h"
+#include "../shared/matrix.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+#include "../shared/stats.h"
+// For SIMD
+#include <immintrin.h>
+
+/**
+ * @brief Helper function for matrix_multithread_mult(). It allocates a
+ * Matrix B transposed for the Matrix calculations. This Matrix is
+ * freed at the end of matrix_multithread_mult(). This function also
+ * establishes a Queue object and fills it with Task objects that
+ * reflect each subjob / block that needs to be calculated in Matrix C.
+ *
+ * @param A Pointer to Matrix A (A x B = C).
+ * @param B Pointer to Matrix B.
+ * @param C Pointer to Matrix C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue.
+*/
+Queue* preprocessing_9avx_prefetch(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
+
+    // Create a new Matrix that is the transpose of Matrix B
+    size_t B_trans_stride = matrix_row_stride(B->num_rows);
+    size_t mapped_size = 0;
+    double* B_trans_arr = matrix_alloc_values(B->num_cols * B_trans_stride, &mapped_size);
+    if (!B_trans_arr) {
+        return NULL;
+    }
+
+    // Insert transposed values and Allocate Matrix
+    for (size_t i = 0; i < B->num_rows; i++) {
+        for (size_t j = 0; j < B->num_cols; j++) {
+            B_trans_arr[j * B_trans_stride + i] = B->values[i * B->stride + j];
+        }
+    }
+    Matrix* B_trans = matrix_create_from_pointers(B->num_cols, B->num_rows, B_trans_arr);
+    B_trans->stride = B_trans_stride;
+    B_trans->mapped_size = mapped_size;
+
+    // Extract Matrix dimensions for C
+    size_t n = A->num_rows;
+    size_t p = B->num_cols;
+
+    // Determine if we have edge cases when blocking / tiling Matrix C
+    bool perfect_row = false;
+    bool perfect_col = false;
+    if (n % block_size == 0) { perfect_row = true; }
+    if (p % block_size == 0) { perfect_col = true; }
+
+    /*
+     * The number of full blocks along each dimension in C.
+     * Division with size_t floors the value to closest whole number.
+     */
+    size_t full_row_blocks = n / block_size;
+    size_t full_col_blocks = p / block_size;
+    size_t full_total_blocks = full_row_blocks * full_col_blocks;
+
+    // Holds the number of blocks / tasks in C for Queue creation
+    size_t num_tasks = 0;
+
+    // Depending on edge cases, determine the total blocks in Matrix C
+    if (perfect_row && perfect_col) {
+        num_tasks = full_total_blocks;
+    } else if (perfect_row && !perfect_col) {
+        num_tasks = full_total_blocks + full_row_blocks;
+    } else if (!perfect_row && perfect_col) {
+        num_tasks = full_total_blocks + full_col_blocks;
+    } else {
+        // No perfects
+        num_tasks = full_total_blocks + full_row_blocks + full_col_blocks + 1;
+    }
+
+    // Set up Queue
+    Queue* q = queue_create(num_tasks);
+
+    // Turn each block in C into a Task for the Queue
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j < p; j += block_size) {
+
+            // These make sure we do not leave Matrix C due to edge cases
+            size_t i_max = min(i + block_size, n);
+            size_t j_max = min(j + block_size, p);
+
+            // Store the block inside a Task and enqueue it
+            Task t = task_create(A, B_trans, C, block_size, i, j, i_max, j_max);
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/*
+ * Kernel options for the current multiplication. These are set by
+ * matrix_multithread_mult_9avx_prefetch() before the threads are
+ * created and only read by the threads.
+ */
+size_t prefetch_distance_9avx;
+bool streaming_stores_9avx;
+
+/**
+ * @brief Helper function to thread_mult_9avx_prefetch(). Writes a row
+ * of final C values in the block using non-temporal stores. Elements
+ * before the first 32-byte aligned address and after the last full
+ * group of 4 doubles are written using normal stores.
+ *
+ * @param C_row Pointer to the start of the row in Matrix C.
+ * @param row_buf The computed C values for the columns in the block.
+ * @param col_start The first column of the block (inclusive).
+ * @param col_end The last column of the block (exclusive).
+*/
+void store_row_streaming(double* C_row, const double* row_buf,
+                         size_t col_start, size_t col_end) {
+
+    size_t jj = col_start;
+
+    // Normal stores until the address is 32-byte aligned
+    while (jj < col_end && ((uintptr_t)&C_row[jj] & 31) != 0) {
+        C_row[jj] = row_buf[jj - col_start];
+        jj++;
+    }
+
+    // Stream full groups of 4 doubles past the cache
+    for (; jj + 3 < col_end; jj += 4) {
+        _mm256_stream_pd(&C_row[jj], _mm256_loadu_pd(&row_buf[jj - col_start]));
+    }
+
+    // Handle the residual elements
+    for (; jj < col_end; jj++) {
+        C_row[jj] = row_buf[jj - col_start];
+    }
+}
+
+/**
+ * @brief Helper function to task_worker(). This function encapsulates
+ * the Matrix multiplication done by a single thread given the input
+ * Task t.
+ *
+ * @note Identical to thread_mult_9avx() in matrix_multithread_9avx.c,
+ * except for the prefetching and the streaming stores.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_9avx_prefetch(Task t) {
+
+    // Matrices: A x B = C
+    Matrix* A = t.A;
+    Matrix* B_trans = t.B_trans;
+    Matrix* C = t.C;
+
+    // Extract Matrix dimensions
+    size_t m = A->num_cols;
+
+    // Extract the row strides (equal to the number of columns if not padded)
+    size_t a_stride = A->stride;
+    size_t b_trans_stride = B_trans->stride;
+    size_t c_stride = C->stride;
+
+    // retrieve internal Matrix arrays
+    double* A_arr = A->values;
+    double* B_trans_arr = B_trans->values;
+    double* C_arr = C->values;
+
+    // The block size to use (blocking method)
+    size_t block_size = t.block_size;
+
+    // Variables to describe the C block (start inclusive, end exclusive)
+    size_t C_row_start = t.C_row_start;
+    size_t C_col_start = t.C_col_start;
+    size_t C_row_end = t.C_row_end;
+    size_t C_col_end = t.C_col_end;
+
+    // Kernel options
+    size_t prefetch_distance = prefetch_distance_9avx;
+    bool use_streaming_stores = streaming_stores_9avx;
+
+    // Holds a row of final C values in the block before streaming them
+    double row_buf[C_col_end - C_col_start];
+
+    // Loop goes through blocks in the shared dimension
+    for (size_t k = 0; k < m; k += block_size) {
+        size_t k_min = min(k + block_size, m);
+
+        // The C values are final after the last k-block
+        bool stream_block = use_streaming_stores && k_min == m;
+
+        // These two loops let us consider a single element in C
+        for (size_t ii = C_row_start; ii < C_row_end; ii++) {
+            size_t a_row_offset = ii * a_stride;
+            for (size_t jj = C_col_start; jj < C_col_end; jj++) {
+
+                // This loop handles the dot product (using SIMD)
+                size_t kk = k;
+                size_t c_index = ii * c_stride + jj;
+                size_t b_row_offset = jj * b_trans_stride;
+                double c_value = C_arr[c_index];
+
+                __m256d c_vec1 = _mm256_setzero_pd();
+                __m256d c_vec2 = _mm256_setzero_pd();
+                __m256d c_vec3 = _mm256_setzero_pd();
+
+                for (; kk + 11 < k_min; kk += 12) {
+
+                    /*
+                     * Prefetch the elements prefetch_distance ahead. A
+                     * step of 12 doubles (96 bytes) can span two cache
+                     * lines, hence two prefetches for each Matrix.
+                     * Prefetches past the k-block fetch the start of the
+                     * next k-block of the same rows (the next panels).
+                     * They are bounded by the row length m, so the
+                     * addresses never point past the rows.
+                     */
+                    size_t ahead = kk + prefetch_distance;
+                    if (prefetch_distance != 0 && ahead < m) {
+                        _mm_prefetch((const char*)&A_arr[a_row_offset + ahead], _MM_HINT_T0);
+                        _mm_prefetch((const char*)&B_trans_arr[b_row_offset + ahead], _MM_HINT_T0);
+                        if (ahead + 8 < m) {
+                            _mm_prefetch((const char*)&A_arr[a_row_offset + ahead + 8], _MM_HINT_T0);
+                            _mm_prefetch((const char*)&B_trans_arr[b_row_offset + ahead + 8], _MM_HINT_T0);
+                        }
+                    }
+
+                    // Load the 4 doubles from A. A total of 12 doubles
+                    __m256d a_vals1 = _mm256_loadu_pd(&A_arr[a_row_offset + kk]);
+                    __m256d a_vals2 = _mm256_loadu_pd(&A_arr[a_row_offset + kk + 4]);
+                    __m256d a_vals3 = _mm256_loadu_pd(&A_arr[a_row_offset + kk + 8]);
+
+                    // Load the 4 doubles from B. A total of 12 doubles
+                    __m256d b_vals1 = _mm256_loadu_pd(&B_trans_arr[b_row_offset + kk]);
+                    __m256d b_vals2 = _mm256_loadu_pd(&B_trans_arr[b_row_offset + kk + 4]);
+                    __m256d b_vals3 = _mm256_loadu_pd(&B_trans_arr[b_row_offset + kk + 8]);
+
+                    // Multiply and accumulate into the c_vecs
+                    c_vec1 = _mm256_fmadd_pd(a_vals1, b_vals1, c_vec1);
+                    c_vec2 = _mm256_fmadd_pd(a_vals2, b_vals2, c_vec2);
+                    c_vec3 = _mm256_fmadd_pd(a_vals3, b_vals3, c_vec3);
+                }
+
+                // Unwrap the c_vecs and sum up the elements in the vector
+                double temp1[4], temp2[4], temp3[4];
+                _mm256_store_pd(temp1, c_vec1);
+                _mm256_store_pd(temp2, c_vec2);
+                _mm256_store_pd(temp3, c_vec3);
+                c_value += temp1[0] + temp1[1] + temp1[2] + temp1[3];
+                c_value += temp2[0] + temp2[1] + temp2[2] + temp2[3];
+                c_value += temp3[0] + temp3[1] + temp3[2] + temp3[3];
+
+                // Handle residual operations not handled by the SIMD loop
+                for (; kk < k_min; kk++) {
+                    c_value += A_arr[a_row_offset + kk] * B_trans_arr[b_row_offset + kk];
+                }
+
+                // Write back to memory (or to the row buffer if streaming)
+                if (stream_block) {
+                    row_buf[jj - C_col_start] = c_value;
+                } else {
+                    C_arr[c_index] = c_value;
+                }
+            }
+
+            if (stream_block) {
+                store_row_streaming(&C_arr[ii * c_stride], row_buf, C_col_start, C_col_end);
+            }
+        }
+    }
+
+    // Make the streaming stores globally visible before the next Task
+    if (use_streaming_stores) {
+        _mm_sfence();
+    }
+}
+
+// Mutex lock used to access the Queue
+pthread_mutex_t queue_lock_9avx_prefetch;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_9avx_prefetch(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+    uint64_t busy_ns = 0;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_9avx_prefetch) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_9avx_prefetch) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            uint64_t busy_start = now_ns();
+            thread_mult_9avx_prefetch(t);
+            busy_ns += now_ns() - busy_start;
+        }
+    }
+
+    // Add the busy time of this thread once it runs out of Tasks
+    stats_record_busy(STATS_MULTITHREAD_9AVX_PREFETCH, busy_ns);
+
+    return NULL;
+}
+
+void matrix_multithread_mult_9avx_prefetch(Matrix* A, Matrix* B, Matrix* C,
+                                           size_t block_size, size_t NUM_THREADS,
+                                           size_t prefetch_distance,
+                                           bool use_streaming_stores) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return;
+    }
+
+    // Extract Matrix dimensions
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+
+    if (n == 0 || m == 0 || p == 0) {
+        errno = EINVAL;
+        perror("Error: At least one of the dimensions (n, m or p) are 0");
+        return;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return;
+    }
+
+    size_t min_nm = min(n, m);
+    if (block_size == 0) {
+        errno = EINVAL;
+        perror("Error: Block size cannot be of value 0");
+        return;
+    }
+
+    // Check if the block size needs to be adjusted for smaller matrices
+    size_t smallest_dimension = min(min_nm, p);
+    block_size = (block_size > smallest_dimension) ? smallest_dimension : block_size;
+
+    // Set the kernel options before any thread reads them
+    prefetch_distance_9avx = prefetch_distance;
+    streaming_stores_9avx = use_streaming_stores;
+
+    // Create a Queue filled with all the tasks / blocks to calculate in C
+    uint64_t stats_start = now_ns();
+    Queue* q = preprocessing_9avx_prefetch(A, B, C, block_size);
+    if (!q) {
+        return;
+    }
+
+    // Retrieve a pointer to B_transposed so that it can be later freed
+    Matrix* B_trans = queue_peek(q).B_trans;
+    stats_record_bytes(STATS_MULTITHREAD_9AVX_PREFETCH, sizeof(double) * B_trans->num_rows * B_trans->stride,
+                       sizeof(Queue) + sizeof(Task) * q->capacity);
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_9avx_prefetch, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+
+    // Assign each thread to the process_tasks_9avx_prefetch() function
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+
+        // Create a thread and check for successfull initialization
+        if (pthread_create(&threads[i], NULL, process_tasks_9avx_prefetch, q) != 0) {
+            perror("Error: Creating thread failed");
+
+            // Handle clean-up by canceling threads and freeing allocations
+            for (size_t j = 0; j < i; j++) {
+                if (pthread_cancel(threads[j]) != 0) {
+                    perror("Error: Canceling thread failed");
+                }
+            }
+
+            // Destory the Queue mutex
+            if (pthread_mutex_destroy(&queue_lock_9avx_prefetch) != 0) {
+                perror("Error: Destorying queue_lock mutex failed");
+            }
+
+            return;
+        }
+    }
+
+    // Have the main thread wait for each thread to finish
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+
+            queue_free(q);
+            pthread_mutex_destroy(&queue_lock_9avx_prefetch);
+            return;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    matrix_free(B_trans);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_9avx_prefetch);
+
+    stats_record_call(STATS_MULTITHREAD_9AVX_PREFETCH, A->num_rows, A->num_cols, B->num_cols, NUM_THREADS,
+                      now_ns() - stats_start);
+}
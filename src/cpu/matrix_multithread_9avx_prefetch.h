@@ -0,0 +1,62 @@
+/**
+ * @file matrix_multithread_9avx_prefetch.h
+ *
+ * @brief Contains function prototypes for a variant of the
+ * matrix_multithread_9avx.h Matrix multiplication with two additional
+ * memory optimizations that can be switched on and off:
+ * - Software prefetching of A and B transposed.
+ * - Non-temporal (streaming) stores of the final C values.
+ *
+ * @details
+ * Software prefetching: While computing the dot product for an element
+ * in C, the kernel issues _mm_prefetch() for the A and B transposed
+ * elements prefetch_distance doubles ahead of the current position.
+ * Once the distance reaches past the current k-block, the prefetches
+ * fetch the start of the next k-block of the same rows (the next A and
+ * B transposed panels), hiding the latency of moving to the next block.
+ * The prefetched elements are bounded by the row length, so an address
+ * never points past a row of A or B transposed.
+ *
+ * Streaming stores: Each element in C is final after the last k-block
+ * has been added. For this k-block, the row of C values in the block
+ * is written with _mm256_stream_pd(), which bypasses the cache so
+ * that the C tiles do not evict the A and B panels. Elements that do
+ * not fill a full 32-byte aligned group are written with normal stores.
+ *
+ * Both features are switchable so that the benchmark can measure the
+ * effect of each separately for every dimension.
+ *
+ * For documentation on the multithreading, see
+ * matrix_multithread_9avx.h.
+ */
+
+#ifndef MATRIX_MULTITHREAD_9AVX_PREFETCH_H
+#define MATRIX_MULTITHREAD_9AVX_PREFETCH_H
+
+#include <stdbool.h>
+#include "../shared/matrix.h"
+
+/**
+ * @brief Matrix multiply the two matrices A and B. Matrix A is the
+ * left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. All three
+ * matrices have to be row-major.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @param prefetch_distance The number of doubles to prefetch ahead
+ * of the current position in A and B transposed. 0 disables prefetching.
+ * @param use_streaming_stores true to write the final C values using
+ * non-temporal stores.
+*/
+void matrix_multithread_mult_9avx_prefetch(Matrix* A, Matrix* B, Matrix* C,
+                                           size_t block_size, size_t NUM_THREADS,
+                                           size_t prefetch_distance,
+                                           bool use_streaming_stores);
+
+#endif // MATRIX_MULTITHREAD_9AVX_PREFETCH_H
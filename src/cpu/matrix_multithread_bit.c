@@ -0,0 +1,393 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_bit.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// The operands of the current multiplication (Task only holds double matrices)
+MatrixBit* A_bit = NULL;
+MatrixBit* B_bit = NULL;
+MatrixBit* C_bit = NULL;
+MatrixInt32* C_count_bit = NULL;
+
+// true for matrix_multithread_count_bit(), false for the or-and product
+bool counting_bit = false;
+
+/**
+ * @brief Helper function for both products. It creates a Queue filled
+ * with a Task for each block of rows_per_task x cols_per_task of C.
+ *
+ * @param n The number of rows of C.
+ * @param p The number of columns of C (in the unit of cols_per_task).
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_bit(size_t n, size_t p, size_t rows_per_task, size_t cols_per_task, size_t block_size) {
+
+    size_t num_row_blocks = (n + rows_per_task - 1) / rows_per_task;
+    size_t num_col_blocks = (p + cols_per_task - 1) / cols_per_task;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; i += rows_per_task) {
+        for (size_t j = 0; j < p; j += cols_per_task) {
+            Task t = {0};
+            t.block_size = block_size;
+            t.C_row_start = i;
+            t.C_col_start = j;
+            t.C_row_end = min(i + rows_per_task, n);
+            t.C_col_end = min(j + cols_per_task, p);
+            t.is_valid = true;
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to thread_mult_bit(). Ors the rows of B
+ * selected by the set bits of words w_start to w_end (exclusive) of a
+ * row of A into num_regs AVX2 registers (1-4) of a row of C.
+ *
+ * @param a_row The row of A.
+ * @param b Pointer to the first word of the tile in row 0 of B.
+ * @param c Pointer to the first word of the tile in the row of C.
+*/
+void tile_or_bit(const uint64_t* a_row, size_t w_start, size_t w_end,
+                 const uint64_t* b, size_t b_stride, uint64_t* c, size_t num_regs) {
+
+    __m256i c_vec[4];
+    for (size_t r = 0; r < num_regs; r++) {
+        c_vec[r] = _mm256_load_si256((const __m256i*)&c[4 * r]);
+    }
+
+    for (size_t w = w_start; w < w_end; w++) {
+        uint64_t word = a_row[w];
+        while (word) {
+            size_t k = w * 64 + _tzcnt_u64(word);
+            const uint64_t* b_row = &b[k * b_stride];
+            for (size_t r = 0; r < num_regs; r++) {
+                c_vec[r] = _mm256_or_si256(c_vec[r], _mm256_load_si256((const __m256i*)&b_row[4 * r]));
+            }
+            // Clear the lowest set bit
+            word &= word - 1;
+        }
+    }
+
+    for (size_t r = 0; r < num_regs; r++) {
+        _mm256_store_si256((__m256i*)&c[4 * r], c_vec[r]);
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_bit(). Computes the or-and
+ * product for the block of C described by Task t (columns in words).
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_bit(Task t) {
+
+    size_t m = A_bit->num_cols;
+
+    // The shared dimension is blocked in whole words of A
+    size_t k_block = (t.block_size + 63) / 64 * 64;
+
+    for (size_t k = 0; k < m; k += k_block) {
+        size_t w_start = k / 64;
+        size_t w_end = (min(k + k_block, m) + 63) / 64;
+
+        for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+            const uint64_t* a_row = &A_bit->words[ii * A_bit->stride];
+            uint64_t* c_row = &C_bit->words[ii * C_bit->stride];
+
+            // The rows are padded to whole registers
+            for (size_t jw = t.C_col_start; jw < t.C_col_end; jw += BIT_TILE_WORDS) {
+                size_t num_regs = min(BIT_TILE_WORDS, t.C_col_end - jw) / 4;
+                if (num_regs == 4) {
+                    tile_or_bit(a_row, w_start, w_end, &B_bit->words[jw], B_bit->stride, &c_row[jw], 4);
+                } else {
+                    tile_or_bit(a_row, w_start, w_end, &B_bit->words[jw], B_bit->stride, &c_row[jw], num_regs);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Helper function to count the set bits of the four 64-bit
+ * values in v, using a lookup table for each 4 bits.
+ *
+ * @return The counts of the bytes, added per 64 bits.
+*/
+__m256i popcount_bit(__m256i v) {
+
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+    __m256i low = _mm256_and_si256(v, low_mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+/**
+ * @brief Helper function to add the four 64-bit values of v.
+*/
+int64_t hsum_epi64_bit(__m256i v) {
+
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+/**
+ * @brief Helper function to process_tasks_bit(). Computes the counting
+ * product for the block of C described by Task t (B_bit holds B
+ * transposed).
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_count_bit(Task t) {
+
+    size_t num_words = A_bit->stride;
+
+    for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+
+        const uint64_t* a_row = &A_bit->words[ii * A_bit->stride];
+        int32_t* c_row = &C_count_bit->values[ii * C_count_bit->stride];
+
+        // Four columns of C at a time to reuse each load of A
+        for (size_t jj = t.C_col_start; jj < t.C_col_end; jj += 4) {
+
+            size_t num_cols = min(4, t.C_col_end - jj);
+            const uint64_t* b_rows[4];
+            __m256i c_acc[4];
+            for (size_t c = 0; c < num_cols; c++) {
+                b_rows[c] = &B_bit->words[(jj + c) * B_bit->stride];
+                c_acc[c] = _mm256_setzero_si256();
+            }
+
+            for (size_t w = 0; w < num_words; w += 4) {
+                __m256i a_vals = _mm256_load_si256((const __m256i*)&a_row[w]);
+                for (size_t c = 0; c < num_cols; c++) {
+                    __m256i both = _mm256_and_si256(a_vals, _mm256_load_si256((const __m256i*)&b_rows[c][w]));
+                    c_acc[c] = _mm256_add_epi64(c_acc[c], popcount_bit(both));
+                }
+            }
+
+            for (size_t c = 0; c < num_cols; c++) {
+                c_row[jj + c] = (int32_t)hsum_epi64_bit(c_acc[c]);
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_bit;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_bit(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_bit) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_bit) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else if (counting_bit) {
+            thread_count_bit(t);
+        } else {
+            thread_mult_bit(t);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for both products. Processes the Queue with
+ * NUM_THREADS threads and frees it.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int run_tasks_bit(Queue* q, size_t NUM_THREADS) {
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_bit, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_bit() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_bit, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_bit);
+
+    return result;
+}
+
+int matrix_multithread_mult_bit(MatrixBit* A, MatrixBit* B, MatrixBit* C,
+                                size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Blocks of block_size rows and BIT_TILE_WORDS words of C (B and C have the same stride)
+    Queue* q = preprocessing_bit(C->num_rows, C->stride, block_size, BIT_TILE_WORDS, block_size);
+    if (!q) {
+        return -1;
+    }
+    A_bit = A;
+    B_bit = B;
+    C_bit = C;
+    counting_bit = false;
+
+    int result = run_tasks_bit(q, NUM_THREADS);
+
+    A_bit = NULL;
+    B_bit = NULL;
+    C_bit = NULL;
+
+    return result;
+}
+
+int matrix_multithread_count_bit(MatrixBit* A, MatrixBit* B, MatrixInt32* C,
+                                 size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Transpose B bit by bit (the work is proportional to the set bits)
+    MatrixBit* B_trans = matrix_bit_create(B->num_cols, B->num_rows);
+    if (!B_trans) {
+        return -1;
+    }
+    for (size_t k = 0; k < B->num_rows; k++) {
+        const uint64_t* b_row = &B->words[k * B->stride];
+        for (size_t w = 0; w < B->stride; w++) {
+            uint64_t word = b_row[w];
+            while (word) {
+                size_t j = w * 64 + _tzcnt_u64(word);
+                B_trans->words[j * B_trans->stride + k / 64] |= (uint64_t)1 << (k % 64);
+                word &= word - 1;
+            }
+        }
+    }
+
+    Queue* q = preprocessing_bit(C->num_rows, C->num_cols, block_size, block_size, block_size);
+    if (!q) {
+        matrix_bit_free(B_trans);
+        return -1;
+    }
+    A_bit = A;
+    B_bit = B_trans;
+    C_count_bit = C;
+    counting_bit = true;
+
+    int result = run_tasks_bit(q, NUM_THREADS);
+
+    matrix_bit_free(B_trans);
+    A_bit = NULL;
+    B_bit = NULL;
+    C_count_bit = NULL;
+
+    return result;
+}
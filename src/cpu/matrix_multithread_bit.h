@@ -0,0 +1,77 @@
+/**
+ * @file matrix_multithread_bit.h
+ *
+ * @brief Contains function prototypes for boolean Matrix multiplication
+ * of bit-packed matrices (see matrix_bit.h) utilizing the following for
+ * improved performance:
+ * - Multithreading
+ * - AVX2 bit operations on 256 elements at a time
+ * - Blocking / tiling method
+ *
+ * @details
+ * Two products are supported:
+ * - matrix_multithread_mult_bit(): the or-and product, C = C or (A and B).
+ *   Row i of C is the or of the rows k of B for the true elements
+ *   A[i][k]. A Task covers block_size rows and BIT_TILE_WORDS words of
+ *   columns of C, which stay in four AVX2 registers while the set bits of
+ *   row i of A (found with tzcnt) select the rows of B to or in. The
+ *   shared dimension is blocked with block_size (rounded up to a multiple
+ *   of 64) such that the used rows of B stay in cache.
+ * - matrix_multithread_count_bit(): the counting product, C[i][j] is the
+ *   number of k with A[i][k] and B[k][j] (for example, the number of
+ *   paths of length two in a graph). B is transposed (bit by bit) such
+ *   that C[i][j] is the popcount of the and of two rows. AVX2 has no
+ *   popcount instruction, so the count uses a 4-bit lookup table with
+ *   _mm256_shuffle_epi8 and _mm256_sad_epu8 to add the bytes. A Task
+ *   covers a block of C, each row of A is loaded once for four columns.
+ *
+ * As in matrix_multithread_9avx.h, a single Queue hands out the Tasks.
+ */
+
+#ifndef MATRIX_MULTITHREAD_BIT_H
+#define MATRIX_MULTITHREAD_BIT_H
+
+#include "../shared/matrix_bit.h"
+#include "../shared/matrix_quant.h"
+
+// The number of words of C per Task in the or-and product (1024 columns)
+#define BIT_TILE_WORDS 16
+
+/**
+ * @brief Boolean Matrix multiply (or-and) the two matrices A and B.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. The product is
+ * or-ed into the values of C, so start from a false C for the plain
+ * product.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_bit(MatrixBit* A, MatrixBit* B, MatrixBit* C,
+                                size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Count for each element of C the k with A[i][k] and B[k][j],
+ * the product of A and B over the integers.
+ *
+ * @note Matrix C must be pre-allocated by the caller. Its values are
+ * overwritten (not accumulated).
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the counts will be stored.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_count_bit(MatrixBit* A, MatrixBit* B, MatrixInt32* C,
+                                 size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_BIT_H
@@ -0,0 +1,461 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include "matrix_multithread_chain.h"
+#include "matrix_multithread_9avx.h"
+#include "../shared/stats.h"
+#include "../shared/matrix_utils.h"
+
+const size_t CHAIN_CALIBRATION_SIZES[CHAIN_NUM_SIZES] = {16, 128, 512};
+
+/**
+ * @brief Helper function to cost_chain(). Returns the index of the
+ * CHAIN_CALIBRATION_SIZES nearest to size, measured by the ratio.
+*/
+size_t nearest_chain(size_t size) {
+
+    size_t best = 0;
+    double best_ratio = 0.0;
+    for (size_t s = 0; s < CHAIN_NUM_SIZES; s++) {
+        double ratio = (double)size / CHAIN_CALIBRATION_SIZES[s];
+        if (ratio < 1.0) {
+            ratio = 1.0 / ratio;
+        }
+        if (s == 0 || ratio < best_ratio) {
+            best = s;
+            best_ratio = ratio;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Helper function to matrix_chain_plan(). The cost of an n x m
+ * times m x p product: the FLOPs, or the predicted seconds if a
+ * throughput is given.
+*/
+double cost_chain(ChainThroughput* throughput, size_t n, size_t m, size_t p) {
+
+    double flops = 2.0 * n * m * p;
+    if (!throughput) {
+        return flops;
+    }
+
+    double gflops = throughput->gflops[nearest_chain(n)][nearest_chain(m)][nearest_chain(p)];
+    return flops / (gflops * 1e9);
+}
+
+int matrix_chain_calibrate(ChainThroughput* throughput, size_t block_size, size_t NUM_THREADS) {
+
+    if (!throughput || block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Missing ChainThroughput, or block size or threads are 0");
+        return -1;
+    }
+
+    for (size_t a = 0; a < CHAIN_NUM_SIZES; a++) {
+        for (size_t b = 0; b < CHAIN_NUM_SIZES; b++) {
+            for (size_t c = 0; c < CHAIN_NUM_SIZES; c++) {
+
+                size_t n = CHAIN_CALIBRATION_SIZES[a];
+                size_t m = CHAIN_CALIBRATION_SIZES[b];
+                size_t p = CHAIN_CALIBRATION_SIZES[c];
+
+                // The values do not change the speed of the kernel
+                Matrix* A = matrix_create_with(pattern_zero, NULL, n, m);
+                Matrix* B = matrix_create_with(pattern_zero, NULL, m, p);
+                Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+                if (!A || !B || !C) {
+                    Matrix* created[3] = {A, B, C};
+                    for (size_t x = 0; x < 3; x++) {
+                        if (created[x]) {
+                            matrix_free(created[x]);
+                        }
+                    }
+                    return -1;
+                }
+
+                // The fastest of two runs after a warm-up run
+                matrix_multithread_mult_9avx(A, B, C, block_size, NUM_THREADS);
+                uint64_t best_ns = UINT64_MAX;
+                for (int run = 0; run < 2; run++) {
+                    uint64_t start = now_ns();
+                    matrix_multithread_mult_9avx(A, B, C, block_size, NUM_THREADS);
+                    uint64_t elapsed = now_ns() - start;
+                    best_ns = (elapsed < best_ns) ? elapsed : best_ns;
+                }
+
+                // FLOPs per nanosecond are GFLOP/s
+                throughput->gflops[a][b][c] = 2.0 * n * m * p / (best_ns + 1);
+
+                matrix_free(A);
+                matrix_free(B);
+                matrix_free(C);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Helper function to matrix_chain_plan(). The FLOPs of the
+ * product of Ai..Aj in the order of the plan.
+*/
+double flops_chain(ChainPlan* plan, size_t i, size_t j) {
+
+    if (i == j) {
+        return 0.0;
+    }
+
+    size_t s = plan->split[i * plan->num_matrices + j];
+    return flops_chain(plan, i, s) + flops_chain(plan, s + 1, j) +
+           2.0 * plan->dims[i] * plan->dims[s + 1] * plan->dims[j + 1];
+}
+
+// A consumed intermediate product, free to hold a later one of at most capacity values
+typedef struct {
+    Matrix* matrix;
+    size_t capacity;
+} ChainBuffer;
+
+/**
+ * @brief Helper function to bytes_chain() and execute_chain(). Takes the
+ * smallest buffer of the free list with room for num_values values.
+ *
+ * @return true if a buffer was taken.
+*/
+bool take_chain(ChainBuffer* free_list, size_t* num_free, size_t num_values, ChainBuffer* taken) {
+
+    size_t best = *num_free;
+    for (size_t f = 0; f < *num_free; f++) {
+        if (free_list[f].capacity >= num_values &&
+            (best == *num_free || free_list[f].capacity < free_list[best].capacity)) {
+            best = f;
+        }
+    }
+    if (best == *num_free) {
+        return false;
+    }
+
+    *taken = free_list[best];
+    free_list[best] = free_list[--(*num_free)];
+    return true;
+}
+
+/**
+ * @brief Helper function to matrix_chain_plan(). Follows the execution
+ * of Ai..Aj by execute_chain() and adds the Arena bytes of every
+ * intermediate product that cannot reuse a consumed one to bytes.
+ *
+ * @return The buffer of the product (a capacity of 0 for an input or
+ * the result of the chain).
+*/
+ChainBuffer bytes_chain(ChainPlan* plan, size_t i, size_t j, bool is_result,
+                        ChainBuffer* free_list, size_t* num_free, size_t* bytes) {
+
+    ChainBuffer product = {NULL, 0};
+    if (i == j) {
+        return product;
+    }
+
+    size_t s = plan->split[i * plan->num_matrices + j];
+    ChainBuffer left = bytes_chain(plan, i, s, false, free_list, num_free, bytes);
+    ChainBuffer right = bytes_chain(plan, s + 1, j, false, free_list, num_free, bytes);
+
+    size_t num_values = plan->dims[i] * matrix_row_stride(plan->dims[j + 1]);
+    if (!is_result && !take_chain(free_list, num_free, num_values, &product)) {
+        // The Matrix struct and its values, as placed by matrix_create_with_arena()
+        size_t header = (sizeof(Matrix) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        size_t values = sizeof(double) * num_values;
+        *bytes += (header + values + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        product.capacity = num_values;
+    }
+
+    // The operands are consumed once the product is computed
+    if (left.capacity > 0) {
+        free_list[(*num_free)++] = left;
+    }
+    if (right.capacity > 0) {
+        free_list[(*num_free)++] = right;
+    }
+
+    return product;
+}
+
+ChainPlan* matrix_chain_plan(Matrix** matrices, size_t num_matrices, ChainThroughput* throughput) {
+
+    if (!matrices || num_matrices == 0) {
+        errno = EINVAL;
+        perror("Error: The chain has no matrices");
+        return NULL;
+    }
+
+    for (size_t i = 0; i < num_matrices; i++) {
+        if (!matrices[i] || (i > 0 && matrices[i - 1]->num_cols != matrices[i]->num_rows)) {
+            errno = EINVAL;
+            perror("Error: A Matrix of the chain is missing or the dimensions do not match");
+            return NULL;
+        }
+        if (matrices[i]->layout == MATRIX_TILE_MAJOR) {
+            errno = EINVAL;
+            perror("Error: The matrices of the chain have to be row-major or column-major");
+            return NULL;
+        }
+    }
+
+    size_t k = num_matrices;
+    ChainPlan* plan = (ChainPlan*)malloc(sizeof(ChainPlan));
+    if (!plan) {
+        perror("Error: Allocation of the ChainPlan failed");
+        return NULL;
+    }
+    plan->num_matrices = k;
+    plan->dims = (size_t*)malloc(sizeof(size_t) * (k + 1));
+    plan->split = (size_t*)calloc(k * k, sizeof(size_t));
+    double* cost = (double*)calloc(k * k, sizeof(double));
+    if (!plan->dims || !plan->split || !cost) {
+        perror("Error: Allocation of the ChainPlan tables failed");
+        free(plan->dims);
+        free(plan->split);
+        free(plan);
+        free(cost);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        plan->dims[i] = matrices[i]->num_rows;
+    }
+    plan->dims[k] = matrices[k - 1]->num_cols;
+    size_t* d = plan->dims;
+
+    // The sub-chains by increasing length, cost[i * k + j] is the cheapest Ai..Aj
+    for (size_t length = 2; length <= k; length++) {
+        for (size_t i = 0; i + length <= k; i++) {
+            size_t j = i + length - 1;
+            double best = -1.0;
+            for (size_t s = i; s < j; s++) {
+                double c = cost[i * k + s] + cost[(s + 1) * k + j] + cost_chain(throughput, d[i], d[s + 1], d[j + 1]);
+                if (best < 0.0 || c < best) {
+                    best = c;
+                    plan->split[i * k + j] = s;
+                }
+            }
+            cost[i * k + j] = best;
+        }
+    }
+    plan->planned_cost = cost[k - 1];
+    free(cost);
+
+    // The left to right order multiplies the running product with the next Matrix
+    plan->naive_cost = 0.0;
+    plan->naive_flops = 0.0;
+    for (size_t s = 1; s < k; s++) {
+        plan->naive_cost += cost_chain(throughput, d[0], d[s], d[s + 1]);
+        plan->naive_flops += 2.0 * d[0] * d[s] * d[s + 1];
+    }
+
+    plan->planned_flops = flops_chain(plan, 0, k - 1);
+    // At most k - 2 intermediate products are free at once
+    ChainBuffer* free_list = (ChainBuffer*)malloc(sizeof(ChainBuffer) * k);
+    if (!free_list) {
+        perror("Error: Allocation of the free list failed");
+        matrix_chain_plan_free(plan);
+        return NULL;
+    }
+    size_t num_free = 0;
+    plan->workspace_bytes = 0;
+    bytes_chain(plan, 0, k - 1, true, free_list, &num_free, &plan->workspace_bytes);
+    free(free_list);
+
+    return plan;
+}
+
+/**
+ * @brief Helper function to matrix_chain_plan_print(). Prints the order
+ * of Ai..Aj.
+*/
+void print_chain(ChainPlan* plan, size_t i, size_t j) {
+
+    if (i == j) {
+        printf("A%zu", i + 1);
+        return;
+    }
+
+    size_t s = plan->split[i * plan->num_matrices + j];
+    printf("(");
+    print_chain(plan, i, s);
+    printf(" ");
+    print_chain(plan, s + 1, j);
+    printf(")");
+}
+
+int matrix_chain_plan_print(ChainPlan* plan) {
+
+    if (!plan) {
+        errno = EINVAL;
+        perror("Error: There is no ChainPlan to print");
+        return -1;
+    }
+
+    printf("Order: ");
+    print_chain(plan, 0, plan->num_matrices - 1);
+    printf("\n");
+    printf("Planned: %.0f FLOPs (cost %g), left to right: %.0f FLOPs (cost %g), ratio %.2f\n",
+           plan->planned_flops, plan->planned_cost, plan->naive_flops, plan->naive_cost,
+           (plan->planned_cost > 0.0) ? plan->naive_cost / plan->planned_cost : 1.0);
+
+    return 0;
+}
+
+int matrix_chain_plan_free(ChainPlan* plan) {
+
+    if (!plan) {
+        errno = EINVAL;
+        perror("Error: There is no ChainPlan to free");
+        return -1;
+    }
+
+    free(plan->dims);
+    free(plan->split);
+    free(plan);
+
+    return 0;
+}
+
+/**
+ * @brief Helper function to matrix_multithread_mult_chain(). Multiplies
+ * Ai..Aj in the order of the plan into target, or into a zero Matrix if
+ * target is NULL: a consumed intermediate product of the free list with
+ * enough room, or a new Matrix (in the workspace if given). The consumed
+ * operands are added to the free list.
+ *
+ * @return The buffer of the product (a capacity of 0 for an input or
+ * target), with a NULL Matrix if an error occured.
+*/
+ChainBuffer execute_chain(Matrix** matrices, ChainPlan* plan, size_t i, size_t j, Matrix* target,
+                          ChainBuffer* free_list, size_t* num_free, Arena* workspace,
+                          size_t block_size, size_t NUM_THREADS) {
+
+    ChainBuffer product = {target, 0};
+    if (i == j) {
+        product.matrix = matrices[i];
+        return product;
+    }
+
+    size_t s = plan->split[i * plan->num_matrices + j];
+    ChainBuffer left = execute_chain(matrices, plan, i, s, NULL, free_list, num_free, workspace,
+                                     block_size, NUM_THREADS);
+    ChainBuffer right = execute_chain(matrices, plan, s + 1, j, NULL, free_list, num_free, workspace,
+                                      block_size, NUM_THREADS);
+
+    size_t n = plan->dims[i];
+    size_t p = plan->dims[j + 1];
+    size_t num_values = n * matrix_row_stride(p);
+    if (!left.matrix || !right.matrix) {
+        product.matrix = NULL;
+    } else if (!target && take_chain(free_list, num_free, num_values, &product)) {
+        // Reshape the consumed Matrix to n x p and zero it
+        Matrix* M = product.matrix;
+        M->num_rows = n;
+        M->num_cols = p;
+        M->stride = matrix_row_stride(p);
+        memset(M->values, 0, sizeof(double) * num_values);
+    } else if (!target) {
+        if (workspace) {
+            product.matrix = matrix_create_with_arena(workspace, pattern_zero, NULL, n, p);
+        } else {
+            product.matrix = matrix_create_with(pattern_zero, NULL, n, p);
+        }
+        product.capacity = num_values;
+    }
+    if (product.matrix) {
+        matrix_multithread_mult_9avx(left.matrix, right.matrix, product.matrix, block_size, NUM_THREADS);
+    }
+
+    // The operands are consumed once the product is computed
+    if (left.matrix && left.capacity > 0) {
+        free_list[(*num_free)++] = left;
+    }
+    if (right.matrix && right.capacity > 0) {
+        free_list[(*num_free)++] = right;
+    }
+
+    return product;
+}
+
+int matrix_multithread_mult_chain(Matrix** matrices, size_t num_matrices, Matrix* C, ChainPlan* plan,
+                                  Arena* workspace, size_t block_size, size_t NUM_THREADS) {
+
+    if (!matrices || !C || block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Missing matrices, or block size or threads are 0");
+        return -1;
+    }
+
+    // matrix_multithread_mult_9avx() takes row-major or column-major operands and a row-major C
+    for (size_t i = 0; i < num_matrices; i++) {
+        if (!matrices[i] || matrices[i]->layout == MATRIX_TILE_MAJOR) {
+            errno = EINVAL;
+            perror("Error: The matrices of the chain have to be row-major or column-major");
+            return -1;
+        }
+    }
+    if (C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix C has to be row-major");
+        return -1;
+    }
+
+    // Plan with the FLOPs if no plan is given
+    ChainPlan* used_plan = plan ? plan : matrix_chain_plan(matrices, num_matrices, NULL);
+    if (!used_plan) {
+        return -1;
+    }
+
+    // The plan has to be made for matrices of the same dimensions
+    bool matches = (used_plan->num_matrices == num_matrices);
+    for (size_t i = 0; i < num_matrices && matches; i++) {
+        matches = (matrices[i]->num_rows == used_plan->dims[i] && matrices[i]->num_cols == used_plan->dims[i + 1]);
+    }
+
+    int result = 0;
+    if (!matches || C->num_rows != used_plan->dims[0] || C->num_cols != used_plan->dims[num_matrices]) {
+        errno = EINVAL;
+        perror("Error: The plan or Matrix C does not match the chain");
+        result = -1;
+    } else if (num_matrices == 1) {
+        // A chain of one Matrix is added as it is
+        Matrix* A = matrices[0];
+        for (size_t i = 0; i < C->num_rows; i++) {
+            for (size_t j = 0; j < C->num_cols; j++) {
+                C->values[i * C->stride + j] += A->values[matrix_index(A, i, j)];
+            }
+        }
+    } else {
+        // At most num_matrices - 2 intermediate products are free at once
+        ChainBuffer* free_list = (ChainBuffer*)malloc(sizeof(ChainBuffer) * num_matrices);
+        size_t num_free = 0;
+        if (!free_list) {
+            perror("Error: Allocation of the free list failed");
+            result = -1;
+        } else if (!execute_chain(matrices, used_plan, 0, num_matrices - 1, C, free_list, &num_free,
+                                  workspace, block_size, NUM_THREADS).matrix) {
+            result = -1;
+        }
+
+        // matrix_free() leaves the Arena matrices alone
+        for (size_t f = 0; f < num_free; f++) {
+            matrix_free(free_list[f].matrix);
+        }
+        free(free_list);
+    }
+
+    if (!plan) {
+        matrix_chain_plan_free(used_plan);
+    }
+
+    return result;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file matrix_multithread_chain.h
+ *
+ * @brief Contains function prototypes for the multiplication of a chain
+ * of matrices A1 x A2 x ... x Ak in the cheapest order.
+ *
+ * @details
+ * The order of the pairwise products does not change the result, but it
+ * can change the work by orders of magnitude: with A1 (1000 x 10),
+ * A2 (10 x 1000) and A3 (1000 x 10), (A1 x A2) x A3 takes 40 MFLOP and
+ * A1 x (A2 x A3) takes 0.4 MFLOP. matrix_chain_plan() chooses the order
+ * with the classic dynamic program over the sub-chains: the cost of
+ * Ai..Aj is the minimum over the split points s of the cost of Ai..As,
+ * As+1..Aj and of the product of the two, which takes O(k^3) time.
+ *
+ * By default, the cost of a product is its number of floating-point
+ * operations. Small and thin products run at a lower throughput than
+ * large ones though, so the cost can also be the time predicted by a
+ * ChainThroughput measured with matrix_chain_calibrate().
+ *
+ * matrix_multithread_mult_chain() executes a plan with the
+ * MULTITHREAD_9AVX kernel. The intermediate products are allocated from
+ * an Arena (see matrix_arena.h), so repeated chains reuse the same
+ * memory once the Arena is reset between them. Within a chain, an
+ * intermediate product is reused by a later one once it is consumed, so
+ * the Arena only grows to the peak of the live intermediate products.
+ */
+
+#ifndef MATRIX_MULTITHREAD_CHAIN_H
+#define MATRIX_MULTITHREAD_CHAIN_H
+
+#include "../shared/matrix.h"
+#include "../shared/matrix_arena.h"
+
+// The dimensions (of n, m and p) measured by matrix_chain_calibrate()
+#define CHAIN_NUM_SIZES 3
+extern const size_t CHAIN_CALIBRATION_SIZES[CHAIN_NUM_SIZES];
+
+typedef struct {
+
+    // The GFLOP/s of an n x m times m x p product, indexed by the nearest
+    // CHAIN_CALIBRATION_SIZES of n, m and p
+    double gflops[CHAIN_NUM_SIZES][CHAIN_NUM_SIZES][CHAIN_NUM_SIZES];
+
+} ChainThroughput;
+
+typedef struct {
+
+    // The number of matrices in the chain
+    size_t num_matrices;
+
+    // The num_matrices + 1 dimensions, Ai is dims[i] x dims[i + 1]
+    size_t* dims;
+
+    // split[i * num_matrices + j] is the s where Ai..Aj is split into
+    // (Ai..As) x (As+1..Aj)
+    size_t* split;
+
+    // The cost (FLOPs, or seconds with a ChainThroughput) of the plan
+    // and of the left to right order
+    double planned_cost;
+    double naive_cost;
+
+    // The floating-point operations of the plan and of the left to right order
+    double planned_flops;
+    double naive_flops;
+
+    // The Arena bytes of the intermediate products in the order of
+    // execution, where a product reuses a consumed one if it fits
+    size_t workspace_bytes;
+
+} ChainPlan;
+
+/**
+ * @brief Measure the throughput of matrix_multithread_mult_9avx() for
+ * every combination of CHAIN_CALIBRATION_SIZES as n, m and p.
+ *
+ * @param throughput Pointer to the ChainThroughput to fill in.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_chain_calibrate(ChainThroughput* throughput, size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Choose the cheapest order to multiply the chain of matrices.
+ *
+ * @note The matrices have to be row-major or column-major.
+ *
+ * @param matrices The matrices A1 to Ak of the chain.
+ * @param num_matrices The number of matrices k.
+ * @param throughput The measured throughput used as the cost model, or
+ * NULL to count floating-point operations.
+ * @return A pointer to the ChainPlan, or NULL if an error occured.
+*/
+ChainPlan* matrix_chain_plan(Matrix** matrices, size_t num_matrices, ChainThroughput* throughput);
+
+/**
+ * @brief Print the order of a ChainPlan, for example ((A1 A2) A3), and
+ * its cost against the left to right order.
+ *
+ * @param plan Pointer to the ChainPlan.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_chain_plan_print(ChainPlan* plan);
+
+/**
+ * @brief Free a ChainPlan.
+ *
+ * @param plan Pointer to the ChainPlan.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_chain_plan_free(ChainPlan* plan);
+
+/**
+ * @brief Multiply the chain of matrices in the order of the plan.
+ *
+ * @note Matrix C must be pre-allocated by the caller. The product is
+ * added to the values of C, like the kernels do. Once an intermediate
+ * product has been multiplied, its Matrix is reused by the next product
+ * that fits into it. New ones are created in the workspace and stay
+ * there until the caller resets it, plan->workspace_bytes is enough for
+ * a chain. Without a workspace, they are allocated on the heap and
+ * freed at the end. The matrices of the chain have to be row-major or
+ * column-major and C row-major.
+ *
+ * @param matrices The matrices A1 to Ak of the chain.
+ * @param num_matrices The number of matrices k.
+ * @param C Pointer to the output Matrix (dimensions of A1 rows x Ak columns).
+ * @param plan The plan from matrix_chain_plan() for these matrices, or
+ * NULL to plan with the FLOPs as cost.
+ * @param workspace The Arena for the intermediate products, or NULL.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_chain(Matrix** matrices, size_t num_matrices, Matrix* C, ChainPlan* plan,
+                                  Arena* workspace, size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_CHAIN_H
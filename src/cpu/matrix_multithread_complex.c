@@ -0,0 +1,438 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_complex.h"
+#include "matrix_multithread_9avx.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// Rows of C per micro-tile
+#define MICRO_ROWS_COMPLEX 4
+// Registers (of two elements) of C per micro-tile row
+#define MICRO_VECS_COMPLEX 2
+// Freivalds trials checking each real product of COMPLEX_METHOD_3M
+#define CHECK_TRIALS_COMPLEX 1
+
+// The operands of the current multiplication (Task only holds double matrices)
+MatrixComplex* A_complex = NULL;
+MatrixComplex* B_complex = NULL;
+MatrixComplex* C_complex = NULL;
+
+/**
+ * @brief Helper function for matrix_multithread_mult_complex(). It
+ * creates a Queue filled with a Task for each block of Matrix C.
+ *
+ * @param n The number of rows in C.
+ * @param p The number of columns in C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_complex(size_t n, size_t p, size_t block_size) {
+
+    // Column blocks are even such that no register straddles two Tasks
+    size_t col_block_size = (block_size + 1) & ~(size_t)1;
+
+    // The number of blocks in each dimension of C (rounded up)
+    size_t num_row_blocks = (n + block_size - 1) / block_size;
+    size_t num_col_blocks = (p + col_block_size - 1) / col_block_size;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        return NULL;
+    }
+
+    // Turn each block in C into a Task (the matrices are A_complex, B_complex and C_complex)
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j < p; j += col_block_size) {
+            Task t = {0};
+            t.block_size = block_size;
+            t.C_row_start = i;
+            t.C_col_start = j;
+            t.C_row_end = min(i + block_size, n);
+            t.C_col_end = min(j + col_block_size, p);
+            t.is_valid = true;
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to thread_mult_complex(). Adds the product of
+ * A[ii..ii+3][k_start..k_end-1] and B[k_start..k_end-1][jj..jj+3] to the
+ * corresponding 4 x 4 micro-tile of C.
+ *
+ * @param ii The first row of the micro-tile.
+ * @param jj The first column of the micro-tile (even).
+ * @param k_start The first index of the inner dimension.
+ * @param k_end One past the last index of the inner dimension.
+*/
+void micro_tile_complex(size_t ii, size_t jj, size_t k_start, size_t k_end) {
+
+    size_t a_stride = 2 * A_complex->stride;
+    size_t b_stride = 2 * B_complex->stride;
+    size_t c_stride = 2 * C_complex->stride;
+    const double* A_arr = &A_complex->values[ii * a_stride];
+    const double* B_arr = &B_complex->values[2 * jj];
+    double* C_arr = &C_complex->values[ii * c_stride + 2 * jj];
+
+    __m256d c00 = _mm256_loadu_pd(&C_arr[0]);
+    __m256d c01 = _mm256_loadu_pd(&C_arr[4]);
+    __m256d c10 = _mm256_loadu_pd(&C_arr[c_stride]);
+    __m256d c11 = _mm256_loadu_pd(&C_arr[c_stride + 4]);
+    __m256d c20 = _mm256_loadu_pd(&C_arr[2 * c_stride]);
+    __m256d c21 = _mm256_loadu_pd(&C_arr[2 * c_stride + 4]);
+    __m256d c30 = _mm256_loadu_pd(&C_arr[3 * c_stride]);
+    __m256d c31 = _mm256_loadu_pd(&C_arr[3 * c_stride + 4]);
+
+    for (size_t k = k_start; k < k_end; k++) {
+
+        __m256d b0 = _mm256_loadu_pd(&B_arr[k * b_stride]);
+        __m256d b1 = _mm256_loadu_pd(&B_arr[k * b_stride + 4]);
+        __m256d bs0 = _mm256_permute_pd(b0, 0x5);
+        __m256d bs1 = _mm256_permute_pd(b1, 0x5);
+
+        __m256d ar = _mm256_broadcast_sd(&A_arr[2 * k]);
+        __m256d ai = _mm256_broadcast_sd(&A_arr[2 * k + 1]);
+        c00 = _mm256_fmaddsub_pd(ar, b0, _mm256_fmaddsub_pd(ai, bs0, c00));
+        c01 = _mm256_fmaddsub_pd(ar, b1, _mm256_fmaddsub_pd(ai, bs1, c01));
+
+        ar = _mm256_broadcast_sd(&A_arr[a_stride + 2 * k]);
+        ai = _mm256_broadcast_sd(&A_arr[a_stride + 2 * k + 1]);
+        c10 = _mm256_fmaddsub_pd(ar, b0, _mm256_fmaddsub_pd(ai, bs0, c10));
+        c11 = _mm256_fmaddsub_pd(ar, b1, _mm256_fmaddsub_pd(ai, bs1, c11));
+
+        ar = _mm256_broadcast_sd(&A_arr[2 * a_stride + 2 * k]);
+        ai = _mm256_broadcast_sd(&A_arr[2 * a_stride + 2 * k + 1]);
+        c20 = _mm256_fmaddsub_pd(ar, b0, _mm256_fmaddsub_pd(ai, bs0, c20));
+        c21 = _mm256_fmaddsub_pd(ar, b1, _mm256_fmaddsub_pd(ai, bs1, c21));
+
+        ar = _mm256_broadcast_sd(&A_arr[3 * a_stride + 2 * k]);
+        ai = _mm256_broadcast_sd(&A_arr[3 * a_stride + 2 * k + 1]);
+        c30 = _mm256_fmaddsub_pd(ar, b0, _mm256_fmaddsub_pd(ai, bs0, c30));
+        c31 = _mm256_fmaddsub_pd(ar, b1, _mm256_fmaddsub_pd(ai, bs1, c31));
+    }
+
+    _mm256_storeu_pd(&C_arr[0], c00);
+    _mm256_storeu_pd(&C_arr[4], c01);
+    _mm256_storeu_pd(&C_arr[c_stride], c10);
+    _mm256_storeu_pd(&C_arr[c_stride + 4], c11);
+    _mm256_storeu_pd(&C_arr[2 * c_stride], c20);
+    _mm256_storeu_pd(&C_arr[2 * c_stride + 4], c21);
+    _mm256_storeu_pd(&C_arr[3 * c_stride], c30);
+    _mm256_storeu_pd(&C_arr[3 * c_stride + 4], c31);
+}
+
+/**
+ * @brief Helper function to thread_mult_complex(). Same as
+ * micro_tile_complex() for the edges of a block, with num_rows rows
+ * (1-4) and num_vecs registers of two elements (1-2).
+ *
+ * @note A column past num_cols is padding of B and C, which is zero
+ * in B and therefore stays zero in C.
+*/
+void edge_tile_complex(size_t ii, size_t jj, size_t num_rows, size_t num_vecs,
+                       size_t k_start, size_t k_end) {
+
+    size_t a_stride = 2 * A_complex->stride;
+    size_t b_stride = 2 * B_complex->stride;
+    size_t c_stride = 2 * C_complex->stride;
+    const double* A_arr = &A_complex->values[ii * a_stride];
+    const double* B_arr = &B_complex->values[2 * jj];
+    double* C_arr = &C_complex->values[ii * c_stride + 2 * jj];
+
+    __m256d c_acc[MICRO_ROWS_COMPLEX][MICRO_VECS_COMPLEX];
+    for (size_t r = 0; r < num_rows; r++) {
+        for (size_t v = 0; v < num_vecs; v++) {
+            c_acc[r][v] = _mm256_loadu_pd(&C_arr[r * c_stride + 4 * v]);
+        }
+    }
+
+    for (size_t k = k_start; k < k_end; k++) {
+        for (size_t v = 0; v < num_vecs; v++) {
+            __m256d b = _mm256_loadu_pd(&B_arr[k * b_stride + 4 * v]);
+            __m256d bs = _mm256_permute_pd(b, 0x5);
+            for (size_t r = 0; r < num_rows; r++) {
+                __m256d ar = _mm256_broadcast_sd(&A_arr[r * a_stride + 2 * k]);
+                __m256d ai = _mm256_broadcast_sd(&A_arr[r * a_stride + 2 * k + 1]);
+                c_acc[r][v] = _mm256_fmaddsub_pd(ar, b, _mm256_fmaddsub_pd(ai, bs, c_acc[r][v]));
+            }
+        }
+    }
+
+    for (size_t r = 0; r < num_rows; r++) {
+        for (size_t v = 0; v < num_vecs; v++) {
+            _mm256_storeu_pd(&C_arr[r * c_stride + 4 * v], c_acc[r][v]);
+        }
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_complex(). Computes the block
+ * of Matrix C described by Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_complex(Task t) {
+
+    size_t m = A_complex->num_cols;
+    size_t micro_cols = 2 * MICRO_VECS_COMPLEX;
+
+    // Slices of the inner dimension keep the rows of B of the block in cache
+    for (size_t kk = 0; kk < m; kk += t.block_size) {
+
+        size_t k_end = min(kk + t.block_size, m);
+
+        for (size_t ii = t.C_row_start; ii < t.C_row_end; ii += MICRO_ROWS_COMPLEX) {
+
+            size_t num_rows = min(MICRO_ROWS_COMPLEX, t.C_row_end - ii);
+
+            for (size_t jj = t.C_col_start; jj < t.C_col_end; jj += micro_cols) {
+
+                // Registers needed for the remaining columns (rounded up into the padding)
+                size_t num_vecs = min(MICRO_VECS_COMPLEX, (t.C_col_end - jj + 1) / 2);
+
+                if (num_rows == MICRO_ROWS_COMPLEX && num_vecs == MICRO_VECS_COMPLEX) {
+                    micro_tile_complex(ii, jj, kk, k_end);
+                } else {
+                    edge_tile_complex(ii, jj, num_rows, num_vecs, kk, k_end);
+                }
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_complex;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_complex(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_complex) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_complex) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_complex(t);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_mult_complex(). Computes
+ * the product with COMPLEX_METHOD_DIRECT.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int mult_direct_complex(MatrixComplex* A, MatrixComplex* B, MatrixComplex* C,
+                        size_t block_size, size_t NUM_THREADS) {
+
+    // Create a Queue filled with all the tasks / blocks to calculate in C
+    Queue* q = preprocessing_complex(A->num_rows, B->num_cols, block_size);
+    if (!q) {
+        return -1;
+    }
+    A_complex = A;
+    B_complex = B;
+    C_complex = C;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_complex, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_complex() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_complex, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    A_complex = NULL;
+    B_complex = NULL;
+    C_complex = NULL;
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_complex);
+
+    return result;
+}
+
+/**
+ * @brief Helper function for mult_3m_complex(). Splits M into its real
+ * part, its imaginary part and the sum of both parts.
+ *
+ * @param parts Receives the three new matrices.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int split_3m_complex(MatrixComplex* M, Matrix* parts[3]) {
+
+    for (size_t i = 0; i < 3; i++) {
+        parts[i] = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+        if (!parts[i]) {
+            return -1;
+        }
+    }
+
+    if (matrix_complex_split(M, parts[0], parts[1]) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            size_t idx = i * parts[2]->stride + j;
+            parts[2]->values[idx] = parts[0]->values[idx] + parts[1]->values[idx];
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_mult_complex(). Computes
+ * the product with COMPLEX_METHOD_3M.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int mult_3m_complex(MatrixComplex* A, MatrixComplex* B, MatrixComplex* C,
+                    size_t block_size, size_t NUM_THREADS) {
+
+    size_t n = A->num_rows;
+    size_t p = B->num_cols;
+
+    // Ar, Ai, Ar + Ai and Br, Bi, Br + Bi, followed by T1, T2, T3
+    Matrix* A_parts[3] = {NULL, NULL, NULL};
+    Matrix* B_parts[3] = {NULL, NULL, NULL};
+    Matrix* T[3] = {NULL, NULL, NULL};
+    int result = 0;
+
+    if (split_3m_complex(A, A_parts) != 0 || split_3m_complex(B, B_parts) != 0) {
+        result = -1;
+    }
+    for (size_t i = 0; i < 3 && result == 0; i++) {
+        T[i] = matrix_create_with(pattern_zero, NULL, n, p);
+        if (!T[i]) {
+            result = -1;
+        }
+    }
+
+    if (result == 0) {
+        // T1 = Ar * Br, T2 = Ai * Bi, T3 = (Ar + Ai) * (Br + Bi)
+        for (size_t i = 0; i < 3 && result == 0; i++) {
+            if (matrix_multithread_mult_9avx_checked(A_parts[i], B_parts[i], T[i], block_size,
+                                                     NUM_THREADS, CHECK_TRIALS_COMPLEX) != 0) {
+                result = -1;
+            }
+        }
+    }
+
+    if (result == 0) {
+
+        // Cr += T1 - T2, Ci += T3 - T1 - T2
+        for (size_t i = 0; i < n; i++) {
+            double* C_row = &C->values[2 * i * C->stride];
+            for (size_t j = 0; j < p; j++) {
+                size_t idx = i * T[0]->stride + j;
+                double t1 = T[0]->values[idx];
+                double t2 = T[1]->values[idx];
+                C_row[2 * j] += t1 - t2;
+                C_row[2 * j + 1] += T[2]->values[idx] - t1 - t2;
+            }
+        }
+    }
+
+    // Free allocated memory
+    for (size_t i = 0; i < 3; i++) {
+        if (A_parts[i]) { matrix_free(A_parts[i]); }
+        if (B_parts[i]) { matrix_free(B_parts[i]); }
+        if (T[i]) { matrix_free(T[i]); }
+    }
+
+    return result;
+}
+
+int matrix_multithread_mult_complex(MatrixComplex* A, MatrixComplex* B, MatrixComplex* C,
+                                    ComplexMethod method, size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    if (method == COMPLEX_METHOD_3M) {
+        return mult_3m_complex(A, B, C, block_size, NUM_THREADS);
+    }
+    return mult_direct_complex(A, B, C, block_size, NUM_THREADS);
+}
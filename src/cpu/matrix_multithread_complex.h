@@ -0,0 +1,72 @@
+/**
+ * @file matrix_multithread_complex.h
+ *
+ * @brief Contains function prototypes for Matrix multiplication of
+ * complex matrices (see matrix_complex.h) utilizing the following for
+ * improved performance:
+ * - Multithreading
+ * - AVX fmaddsub on the interleaved layout
+ * - Blocking / tiling method
+ *
+ * @details
+ * COMPLEX_METHOD_DIRECT works on the interleaved layout. A register
+ * holds two elements b = (br0, bi0, br1, bi1) of a row of B, and
+ * bs = (bi0, br0, bi1, br1) is the same register with the parts swapped.
+ * With the real part ar and the imaginary part ai of an element of A
+ * broadcast, the accumulator c is updated with two fused instructions:
+ *
+ *     c = fmaddsub(ar, b, fmaddsub(ai, bs, c))
+ *
+ * The inner fmaddsub gives (ai*bi - cr, ai*br + ci), the outer one
+ * (ar*br - ai*bi + cr, ar*bi + ai*br + ci), which is c + a * b. Each
+ * Task (a block of C, as in matrix_multithread_9avx.h) is computed in
+ * micro-tiles of 4 rows x 4 elements (8 accumulators) for every
+ * block_size slice of the inner dimension.
+ *
+ * COMPLEX_METHOD_3M splits the matrices into their real and imaginary
+ * parts and needs three real products instead of four:
+ *
+ *     T1 = Ar * Br, T2 = Ai * Bi, T3 = (Ar + Ai) * (Br + Bi)
+ *     Cr += T1 - T2, Ci += T3 - T1 - T2
+ *
+ * The real products use matrix_multithread_mult_9avx_checked() with one
+ * Freivalds trial each, a failed product fails the call. This saves 25%
+ * of the floating-point operations at the cost of the splitting passes
+ * and a slightly larger error of the imaginary part. It only pays off
+ * if the real kernel reaches at least 3/4 of the flop rate of the direct
+ * kernel, which is not the case for MULTITHREAD_9AVX at the time of
+ * writing (3M reaches about 10, direct about 25 complex GFLOP/s on one
+ * core for n = 500-1500), so the method has to be selected explicitly.
+ */
+
+#ifndef MATRIX_MULTITHREAD_COMPLEX_H
+#define MATRIX_MULTITHREAD_COMPLEX_H
+
+#include "../shared/matrix_complex.h"
+
+// The algorithm used by matrix_multithread_mult_complex()
+typedef enum {
+    COMPLEX_METHOD_DIRECT = 0, // = 0 to be able to loop through enums
+    COMPLEX_METHOD_3M
+} ComplexMethod;
+
+/**
+ * @brief Matrix multiply the two complex matrices A and B.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. As for the double
+ * kernels, the product is added to the values of C.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param method The algorithm to use.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_complex(MatrixComplex* A, MatrixComplex* B, MatrixComplex* C,
+                                    ComplexMethod method, size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_COMPLEX_H
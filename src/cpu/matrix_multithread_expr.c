@@ -0,0 +1,723 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "matrix_multithread_expr.h"
+#include "matrix_multithread_9avx.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+
+// The kinds of terms of a materialized node
+typedef enum {
+    EXPR_TERM_PRODUCT = 0, // coef * (left x right) of an EXPR_MULT node
+    EXPR_TERM_MATRIX,      // coef * the value of an input or materialized node
+    EXPR_TERM_ROW          // coef * a 1 x num_cols row added to every row
+} ExprTermKind;
+
+typedef struct {
+    ExprTermKind kind;
+    ExprNode* node;
+    double coef;
+} ExprTerm;
+
+// A materialized node, the sum of its terms
+typedef struct {
+
+    ExprNode* node;
+    ExprTerm* terms;
+    size_t num_terms;
+
+    // The Matrix the terms are added to, and whether the tiles are zeroed first
+    Matrix* target;
+    bool overwrite;
+
+} ExprGroup;
+
+// The groups of the current evaluation, the level being computed and its tile size
+ExprGroup* groups_expr = NULL;
+size_t num_groups_expr = 0;
+size_t level_expr = 0;
+size_t block_size_expr = 0;
+
+// Set by a thread whose tile buffer or Queue lock failed, atomic since it is shared by the threads
+_Atomic bool failed_expr = false;
+
+/**
+ * @brief A pattern for matrix_create_with() that leaves the values
+ * uninitialized, for matrices whose tiles are zeroed when computed.
+*/
+double* pattern_none_expr(double* values, void* args, size_t num) {
+
+    (void)args;
+    (void)num;
+    return values;
+}
+
+ExprGraph* expr_graph_create() {
+
+    ExprGraph* g = (ExprGraph*)calloc(1, sizeof(ExprGraph));
+    if (!g) {
+        perror("Error: Allocation of the ExprGraph failed");
+        return NULL;
+    }
+    return g;
+}
+
+int expr_graph_free(ExprGraph* g) {
+
+    if (!g) {
+        errno = EINVAL;
+        perror("Error: There is no ExprGraph to free");
+        return -1;
+    }
+
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        free(g->nodes[i]);
+    }
+    free(g->nodes);
+    free(g);
+
+    return 0;
+}
+
+/**
+ * @brief Helper function to the expr_*() functions. Adds a node to the
+ * graph.
+ *
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* add_node_expr(ExprGraph* g, ExprOp op, ExprNode* left, ExprNode* right, double scalar,
+                        size_t num_rows, size_t num_cols) {
+
+    if (g->num_nodes == g->capacity) {
+        size_t capacity = (g->capacity == 0) ? 16 : 2 * g->capacity;
+        ExprNode** nodes = (ExprNode**)realloc(g->nodes, sizeof(ExprNode*) * capacity);
+        if (!nodes) {
+            perror("Error: Allocation of the ExprGraph nodes failed");
+            return NULL;
+        }
+        g->nodes = nodes;
+        g->capacity = capacity;
+    }
+
+    ExprNode* node = (ExprNode*)calloc(1, sizeof(ExprNode));
+    if (!node) {
+        perror("Error: Allocation of the ExprNode failed");
+        return NULL;
+    }
+    node->op = op;
+    node->left = left;
+    node->right = right;
+    node->scalar = scalar;
+    node->num_rows = num_rows;
+    node->num_cols = num_cols;
+
+    g->nodes[g->num_nodes++] = node;
+    return node;
+}
+
+ExprNode* expr_input(ExprGraph* g, Matrix* M) {
+
+    if (!g || !M || M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Missing ExprGraph or Matrix, or the Matrix is not row-major");
+        return NULL;
+    }
+
+    ExprNode* node = add_node_expr(g, EXPR_INPUT, NULL, NULL, 0.0, M->num_rows, M->num_cols);
+    if (node) {
+        node->value = M;
+    }
+    return node;
+}
+
+ExprNode* expr_mult(ExprGraph* g, ExprNode* left, ExprNode* right) {
+
+    if (!g || !left || !right || left->num_cols != right->num_rows) {
+        errno = EINVAL;
+        perror("Error: Missing operands, or the dimensions are not valid for multiplication");
+        return NULL;
+    }
+    return add_node_expr(g, EXPR_MULT, left, right, 0.0, left->num_rows, right->num_cols);
+}
+
+ExprNode* expr_add(ExprGraph* g, ExprNode* left, ExprNode* right) {
+
+    if (!g || !left || !right || left->num_rows != right->num_rows || left->num_cols != right->num_cols) {
+        errno = EINVAL;
+        perror("Error: Missing operands, or the dimensions are not valid for addition");
+        return NULL;
+    }
+    return add_node_expr(g, EXPR_ADD, left, right, 0.0, left->num_rows, left->num_cols);
+}
+
+ExprNode* expr_scale(ExprGraph* g, double alpha, ExprNode* node) {
+
+    if (!g || !node) {
+        errno = EINVAL;
+        perror("Error: Missing ExprGraph or operand");
+        return NULL;
+    }
+    return add_node_expr(g, EXPR_SCALE, node, NULL, alpha, node->num_rows, node->num_cols);
+}
+
+ExprNode* expr_add_row(ExprGraph* g, ExprNode* node, ExprNode* row) {
+
+    if (!g || !node || !row || row->num_rows != 1 || row->num_cols != node->num_cols) {
+        errno = EINVAL;
+        perror("Error: Missing operands, or the row is not 1 x the columns of the operand");
+        return NULL;
+    }
+    return add_node_expr(g, EXPR_ADD_ROW, node, row, 0.0, node->num_rows, node->num_cols);
+}
+
+/**
+ * @brief Helper function to matrix_multithread_eval_expr(). Counts the
+ * users of every node reachable from node, visiting each node once.
+*/
+void count_uses_expr(ExprNode* node) {
+
+    ExprNode* operands[2] = {node->left, node->right};
+    for (size_t i = 0; i < 2; i++) {
+        if (operands[i]) {
+            operands[i]->num_uses++;
+            if (operands[i]->num_uses == 1) {
+                count_uses_expr(operands[i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Helper function to matrix_multithread_eval_expr(). Adds the
+ * terms of node times coef to the group of owner, flattening every node
+ * that is not an input or materialized.
+*/
+void collect_terms_expr(ExprGroup* group, ExprNode* owner, ExprNode* node, double coef) {
+
+    if (node->op == EXPR_INPUT || (node != owner && node->materialized)) {
+        group->terms[group->num_terms++] = (ExprTerm){EXPR_TERM_MATRIX, node, coef};
+        return;
+    }
+
+    switch (node->op) {
+        case EXPR_MULT:
+            group->terms[group->num_terms++] = (ExprTerm){EXPR_TERM_PRODUCT, node, coef};
+            break;
+        case EXPR_ADD:
+            collect_terms_expr(group, owner, node->left, coef);
+            collect_terms_expr(group, owner, node->right, coef);
+            break;
+        case EXPR_SCALE:
+            collect_terms_expr(group, owner, node->left, coef * node->scalar);
+            break;
+        case EXPR_ADD_ROW:
+            collect_terms_expr(group, owner, node->left, coef);
+            group->terms[group->num_terms++] = (ExprTerm){EXPR_TERM_ROW, node->right, coef};
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Helper function to collect_groups_expr(). Raises the level of
+ * group above the level of a node it reads.
+*/
+void read_node_expr(ExprGroup* group, ExprNode* read) {
+
+    if (read->op == EXPR_INPUT) {
+        return;
+    }
+    if (group->node->level <= read->level) {
+        group->node->level = read->level + 1;
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_expr(). Computes the tile of
+ * the group described by Task t, adding its terms one after the other
+ * while the tile is in the cache.
+ *
+ * @param t The Task passed as value that contains the tile.
+ * @param group The group of the target of the Task.
+ * @param buffer A block_size x block_size buffer of the thread.
+*/
+void thread_eval_expr(Task t, ExprGroup* group, double* buffer) {
+
+    Matrix* C = group->target;
+    size_t c_stride = C->stride;
+    size_t rows = t.C_row_end - t.C_row_start;
+    size_t cols = t.C_col_end - t.C_col_start;
+    double* C_tile = &C->values[t.C_row_start * c_stride + t.C_col_start];
+
+    if (group->overwrite) {
+        for (size_t i = 0; i < rows; i++) {
+            memset(&C_tile[i * c_stride], 0, sizeof(double) * cols);
+        }
+    }
+
+    for (size_t k = 0; k < group->num_terms; k++) {
+        ExprTerm term = group->terms[k];
+        Matrix* M = term.node->value;
+
+        if (term.kind == EXPR_TERM_PRODUCT && term.coef == 1.0) {
+            // Added to the tile of C by the tile kernel
+            Task product = t;
+            product.A = term.node->left->value;
+            product.B_trans = term.node->right->transposed;
+            thread_mult_9avx(product);
+
+        } else if (term.kind == EXPR_TERM_PRODUCT) {
+            // Computed into the buffer by the tile kernel on views starting at the tile
+            Matrix* A = term.node->left->value;
+            Matrix* B_trans = term.node->right->transposed;
+            Matrix A_view = *A;
+            Matrix B_trans_view = *B_trans;
+            Matrix buffer_view = *C;
+            A_view.values = &A->values[t.C_row_start * A->stride];
+            B_trans_view.values = &B_trans->values[t.C_col_start * B_trans->stride];
+            buffer_view.values = buffer;
+            buffer_view.stride = t.block_size;
+            memset(buffer, 0, sizeof(double) * rows * t.block_size);
+
+            Task product = t;
+            product.A = &A_view;
+            product.B_trans = &B_trans_view;
+            product.C = &buffer_view;
+            product.C_row_start = 0;
+            product.C_col_start = 0;
+            product.C_row_end = rows;
+            product.C_col_end = cols;
+            thread_mult_9avx(product);
+
+            // The epilogue: scale and add to the tile of C
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t j = 0; j < cols; j++) {
+                    C_tile[i * c_stride + j] += term.coef * buffer[i * t.block_size + j];
+                }
+            }
+
+        } else if (term.kind == EXPR_TERM_MATRIX) {
+            double* M_tile = &M->values[t.C_row_start * M->stride + t.C_col_start];
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t j = 0; j < cols; j++) {
+                    C_tile[i * c_stride + j] += term.coef * M_tile[i * M->stride + j];
+                }
+            }
+
+        } else {
+            double* row = &M->values[t.C_col_start];
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t j = 0; j < cols; j++) {
+                    C_tile[i * c_stride + j] += term.coef * row[j];
+                }
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_expr;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a tile of a materialized
+ * node of the current level.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_expr(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // The buffer of the scaled products, reused for all Tasks of the thread
+    double* buffer = (double*)malloc(sizeof(double) * block_size_expr * block_size_expr);
+    bool allocated = (buffer != NULL);
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (allocated) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_expr) != 0) {
+            perror("Error: Mutex lock failed");
+            failed_expr = true;
+            break;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_expr) != 0) {
+            perror("Error: Mutex unlock failed");
+            failed_expr = true;
+            break;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        }
+
+        // The group of the Task is the one of the current level with its target as C
+        for (size_t g = 0; g < num_groups_expr; g++) {
+            ExprGroup* group = &groups_expr[g];
+            if (group->node->level == level_expr && group->target == t.C) {
+                thread_eval_expr(t, group, buffer);
+                break;
+            }
+        }
+    }
+
+    if (!allocated) {
+        perror("Error: Allocation of the tile buffer failed");
+        failed_expr = true;
+    }
+
+    // Free allocated memory
+    free(buffer);
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function to matrix_multithread_eval_expr(). Computes the
+ * groups of level_expr, with a Task per tile of their targets in a
+ * single Queue.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int run_level_expr(size_t block_size, size_t NUM_THREADS) {
+
+    size_t num_tasks = 0;
+    for (size_t g = 0; g < num_groups_expr; g++) {
+        Matrix* target = groups_expr[g].target;
+        if (groups_expr[g].node->level == level_expr) {
+            num_tasks += ((target->num_rows + block_size - 1) / block_size) *
+                         ((target->num_cols + block_size - 1) / block_size);
+        }
+    }
+
+    Queue* q = queue_create(num_tasks);
+    if (!q) {
+        return -1;
+    }
+    block_size_expr = block_size;
+    for (size_t g = 0; g < num_groups_expr; g++) {
+        Matrix* target = groups_expr[g].target;
+        if (groups_expr[g].node->level != level_expr) {
+            continue;
+        }
+        for (size_t i = 0; i < target->num_rows; i += block_size) {
+            for (size_t j = 0; j < target->num_cols; j += block_size) {
+                Task t = {0};
+                t.C = target;
+                t.block_size = block_size;
+                t.C_row_start = i;
+                t.C_col_start = j;
+                t.C_row_end = min(i + block_size, target->num_rows);
+                t.C_col_end = min(j + block_size, target->num_cols);
+                t.is_valid = true;
+                queue_add(q, t);
+            }
+        }
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_expr, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_expr() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_expr, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_expr);
+
+    return result;
+}
+
+/**
+ * @brief Helper function to matrix_multithread_eval_expr(). Sets up the
+ * groups of the materialized nodes reachable from root, in the order of
+ * creation, with their terms and levels.
+ *
+ * @return The number of groups, with *groups the array of groups (and
+ * *terms the array of all terms), or 0 if an error occured.
+*/
+size_t collect_groups_expr(ExprGraph* g, ExprNode* root, ExprGroup** groups, ExprTerm** terms) {
+
+    // A node reachable from root is an operand of a reachable node
+    count_uses_expr(root);
+    size_t num_groups = 0;
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        ExprNode* node = g->nodes[i];
+        bool reachable = (node == root || node->num_uses > 0);
+        if (!reachable || (node->op == EXPR_INPUT && node != root)) {
+            continue;
+        }
+        node->materialized = node->materialized || node == root || node->num_uses > 1;
+        if (node->op == EXPR_MULT) {
+            node->left->materialized = (node->left->op != EXPR_INPUT);
+            node->right->materialized = (node->right->op != EXPR_INPUT);
+        }
+        if (node->op == EXPR_ADD_ROW) {
+            node->right->materialized = (node->right->op != EXPR_INPUT);
+        }
+    }
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        num_groups += g->nodes[i]->materialized;
+    }
+
+    // Each node adds at most two terms (one per operand)
+    *groups = (ExprGroup*)calloc(num_groups, sizeof(ExprGroup));
+    *terms = (ExprTerm*)malloc(sizeof(ExprTerm) * 2 * g->num_nodes);
+    if (!*groups || !*terms) {
+        perror("Error: Allocation of the expression groups failed");
+        free(*groups);
+        free(*terms);
+        return 0;
+    }
+
+    size_t group_index = 0;
+    size_t term_index = 0;
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        ExprNode* node = g->nodes[i];
+        if (!node->materialized) {
+            continue;
+        }
+        ExprGroup* group = &(*groups)[group_index++];
+        group->node = node;
+        group->terms = &(*terms)[term_index];
+        collect_terms_expr(group, node, node, 1.0);
+        term_index += group->num_terms;
+
+        // The operands are created before their users, so their levels are known
+        node->level = 1;
+        for (size_t k = 0; k < group->num_terms; k++) {
+            ExprTerm term = group->terms[k];
+            if (term.kind == EXPR_TERM_PRODUCT) {
+                read_node_expr(group, term.node->left);
+                read_node_expr(group, term.node->right);
+            } else {
+                read_node_expr(group, term.node);
+            }
+        }
+    }
+
+    // The last level reading each node (its users are at higher levels)
+    for (size_t i = 0; i < num_groups; i++) {
+        ExprGroup* group = &(*groups)[i];
+        for (size_t k = 0; k < group->num_terms; k++) {
+            ExprTerm term = group->terms[k];
+            ExprNode* read[2] = {term.node, NULL};
+            if (term.kind == EXPR_TERM_PRODUCT) {
+                read[0] = term.node->left;
+                read[1] = term.node->right;
+            }
+            for (size_t r = 0; r < 2; r++) {
+                if (read[r] && read[r]->last_level < group->node->level) {
+                    read[r]->last_level = group->node->level;
+                }
+            }
+        }
+    }
+
+    return num_groups;
+}
+
+int matrix_multithread_eval_expr(ExprGraph* g, ExprNode* root, Matrix* C, Arena* workspace,
+                                 size_t block_size, size_t NUM_THREADS) {
+
+    if (!g || !root || !C || block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Missing ExprGraph, node or Matrix C, or block size or threads are 0");
+        return -1;
+    }
+
+    if (C->num_rows != root->num_rows || C->num_cols != root->num_cols || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix C does not match the expression or is not row-major");
+        return -1;
+    }
+
+    // Reset the state of the previous evaluation
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        ExprNode* node = g->nodes[i];
+        if (node->op != EXPR_INPUT) {
+            node->value = NULL;
+        }
+        node->transposed = NULL;
+        node->num_uses = 0;
+        node->materialized = false;
+        node->level = 0;
+        node->last_level = 0;
+    }
+    g->allocations = 0;
+    g->reused = 0;
+    g->passes = 0;
+    g->levels = 0;
+    g->eager_allocations = 0;
+    g->eager_passes = 0;
+
+    ExprGroup* groups = NULL;
+    ExprTerm* terms = NULL;
+    size_t num_groups = collect_groups_expr(g, root, &groups, &terms);
+    if (num_groups == 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        ExprNode* node = g->nodes[i];
+        if (node->op != EXPR_INPUT && (node == root || node->num_uses > 0)) {
+            g->eager_allocations++;
+            g->eager_passes += 2;
+        }
+    }
+    for (size_t i = 0; i < num_groups; i++) {
+        if (groups[i].node->level > g->levels) {
+            g->levels = groups[i].node->level;
+        }
+    }
+
+    // The matrices of finished nodes, to be reused
+    Matrix** free_matrices = (Matrix**)malloc(sizeof(Matrix*) * num_groups);
+    size_t num_free = 0;
+    if (!free_matrices) {
+        perror("Error: Allocation of the free list failed");
+        free(groups);
+        free(terms);
+        return -1;
+    }
+
+    groups_expr = groups;
+    num_groups_expr = num_groups;
+    failed_expr = false;
+    int result = 0;
+
+    for (level_expr = 1; level_expr <= g->levels && result == 0; level_expr++) {
+
+        // The nodes no longer read are free for reuse
+        for (size_t i = 0; i < num_groups; i++) {
+            ExprNode* node = groups[i].node;
+            if (node != root && node->value && node->last_level < level_expr) {
+                free_matrices[num_free++] = node->value;
+                node->value = NULL;
+            }
+        }
+
+        for (size_t i = 0; i < num_groups && result == 0; i++) {
+            ExprGroup* group = &groups[i];
+            ExprNode* node = group->node;
+            if (node->level != level_expr) {
+                continue;
+            }
+
+            // The result is added to C, the other nodes take a free Matrix or a new one
+            Matrix* target = (node == root) ? C : NULL;
+            for (size_t f = 0; f < num_free && !target; f++) {
+                if (free_matrices[f]->num_rows == node->num_rows && free_matrices[f]->num_cols == node->num_cols) {
+                    target = free_matrices[f];
+                    free_matrices[f] = free_matrices[--num_free];
+                    g->reused++;
+                }
+            }
+            if (!target && workspace) {
+                target = matrix_create_with_arena(workspace, pattern_none_expr, NULL, node->num_rows, node->num_cols);
+                g->allocations++;
+            } else if (!target) {
+                target = matrix_create_with(pattern_none_expr, NULL, node->num_rows, node->num_cols);
+                g->allocations++;
+            }
+            group->target = target;
+            group->overwrite = (node != root);
+            if (node->op != EXPR_INPUT) {
+                node->value = target;
+            }
+            if (!target) {
+                result = -1;
+                break;
+            }
+
+            // The right operands of the products are transposed once
+            for (size_t k = 0; k < group->num_terms; k++) {
+                ExprNode* right = group->terms[k].node->right;
+                if (group->terms[k].kind == EXPR_TERM_PRODUCT && !right->transposed) {
+                    right->transposed = matrix_to_col_major(right->value);
+                    if (!right->transposed) {
+                        result = -1;
+                    }
+                }
+            }
+        }
+
+        if (result == 0 && run_level_expr(block_size, NUM_THREADS) != 0) {
+            result = -1;
+        }
+        for (size_t i = 0; i < num_groups; i++) {
+            g->passes += (groups[i].node->level == level_expr);
+        }
+    }
+
+    if (failed_expr) {
+        result = -1;
+    }
+
+    // Free the transposed operands and the intermediate matrices (not in the Arena)
+    for (size_t i = 0; i < g->num_nodes; i++) {
+        ExprNode* node = g->nodes[i];
+        if (node->transposed) {
+            matrix_free(node->transposed);
+            node->transposed = NULL;
+        }
+        if (node->op != EXPR_INPUT && node->value && node != root) {
+            free_matrices[num_free++] = node->value;
+        }
+        if (node->op != EXPR_INPUT) {
+            node->value = NULL;
+        }
+    }
+    for (size_t f = 0; f < num_free; f++) {
+        matrix_free(free_matrices[f]);
+    }
+
+    free(free_matrices);
+    free(groups);
+    free(terms);
+    groups_expr = NULL;
+    num_groups_expr = 0;
+
+    return result;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file matrix_multithread_expr.h
+ *
+ * @brief Contains function prototypes for lazy Matrix expressions such
+ * as alpha * (A x B) + C x D + bias, which are built as a graph and
+ * evaluated on demand with:
+ * - Elementwise operations fused into the epilogues of the products
+ * - Independent products computed concurrently
+ * - Reuse of the intermediate buffers
+ *
+ * @details
+ * Evaluated step by step, every operation of an expression creates a
+ * Matrix with matrix_create_with(pattern_zero, ...) and makes a memory
+ * pass to zero it and one to compute it. Instead, expr_mult(), expr_add(),
+ * expr_scale() and expr_add_row() only add an ExprNode to an ExprGraph,
+ * and matrix_multithread_eval_expr() evaluates the graph of a node.
+ *
+ * Only some nodes need their own Matrix: the result, the operands of the
+ * products and the nodes that are used more than once. Every other node
+ * is flattened into the node that uses it, such that each of these
+ * materialized nodes is a sum of terms: products of two matrices,
+ * matrices and rows (a 1 x p Matrix added to every row) scaled by a
+ * coefficient. alpha * (A x B) + C x D + bias is a single node with the
+ * terms alpha (A x B), 1 (C x D) and 1 bias.
+ *
+ * A materialized node is evaluated tile by tile (block_size x block_size
+ * tiles of its Matrix), with a Task per tile. The products with a
+ * coefficient of one are added to the tile by the tile kernel of
+ * matrix_multithread_9avx.h directly, the other products are computed
+ * into a buffer of the thread and added scaled, followed by the matrices
+ * and the rows. The tile stays in the cache between the terms, so the
+ * whole node takes a single memory pass over its Matrix.
+ *
+ * The materialized nodes are scheduled in levels: a node is one level
+ * above the nodes it reads. The Tasks of all nodes of a level share one
+ * Queue, so independent products (e.g. A x B and C x D in
+ * (A x B) x (C x D)) are computed concurrently by the threads. Once the
+ * last level that reads a node is done, its Matrix is reused by the next
+ * node of the same dimensions.
+ *
+ * Like in matrix_multithread_mult_9avx(), the right operand of each
+ * product is transposed once per evaluation. These copies are not
+ * counted as allocations of either evaluation.
+ */
+
+#ifndef MATRIX_MULTITHREAD_EXPR_H
+#define MATRIX_MULTITHREAD_EXPR_H
+
+#include "../shared/matrix.h"
+#include "../shared/matrix_arena.h"
+
+// The operations of the nodes
+typedef enum {
+    EXPR_INPUT = 0,
+    EXPR_MULT,   // left x right
+    EXPR_ADD,    // left + right
+    EXPR_SCALE,  // scalar * left
+    EXPR_ADD_ROW // left + right added to every row (right is 1 x num_cols)
+} ExprOp;
+
+typedef struct ExprNode {
+
+    // The operation, its operands (NULL if not used) and the scalar of EXPR_SCALE
+    ExprOp op;
+    struct ExprNode* left;
+    struct ExprNode* right;
+    double scalar;
+
+    // The dimensions of the value of the node
+    size_t num_rows;
+    size_t num_cols;
+
+    // The Matrix of an EXPR_INPUT, or of a materialized node during an evaluation
+    Matrix* value;
+
+    // The state of an evaluation: the value transposed if it is the right
+    // operand of a product, the number of nodes using it, and the level
+    // of a materialized node and the last level reading it
+    Matrix* transposed;
+    size_t num_uses;
+    bool materialized;
+    size_t level;
+    size_t last_level;
+
+} ExprNode;
+
+typedef struct {
+
+    // The nodes in the order of creation (operands before their users)
+    ExprNode** nodes;
+    size_t num_nodes;
+    size_t capacity;
+
+    // The last evaluation: the Matrix allocations, the buffers reused,
+    // the memory passes (one per materialized node) and the levels
+    size_t allocations;
+    size_t reused;
+    size_t passes;
+    size_t levels;
+
+    // The same expression evaluated step by step: one allocation and two
+    // memory passes (zeroing and computing) per operation
+    size_t eager_allocations;
+    size_t eager_passes;
+
+} ExprGraph;
+
+/**
+ * @brief Create an empty ExprGraph on the heap.
+ *
+ * @return A pointer to the ExprGraph, or NULL if an error occured.
+*/
+ExprGraph* expr_graph_create();
+
+/**
+ * @brief Free an ExprGraph and its nodes. The input matrices are left
+ * untouched.
+ *
+ * @param g Pointer to the ExprGraph.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int expr_graph_free(ExprGraph* g);
+
+/**
+ * @brief Add a row-major input Matrix to the graph. The Matrix is read
+ * when an expression is evaluated, not copied.
+ *
+ * @param g Pointer to the ExprGraph.
+ * @param M Pointer to the Matrix.
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* expr_input(ExprGraph* g, Matrix* M);
+
+/**
+ * @brief Add the product left x right to the graph.
+ *
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* expr_mult(ExprGraph* g, ExprNode* left, ExprNode* right);
+
+/**
+ * @brief Add the sum left + right to the graph.
+ *
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* expr_add(ExprGraph* g, ExprNode* left, ExprNode* right);
+
+/**
+ * @brief Add alpha * node to the graph.
+ *
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* expr_scale(ExprGraph* g, double alpha, ExprNode* node);
+
+/**
+ * @brief Add node + row to the graph, where the 1 x num_cols row (e.g. a
+ * bias) is added to every row of node.
+ *
+ * @return A pointer to the node, or NULL if an error occured.
+*/
+ExprNode* expr_add_row(ExprGraph* g, ExprNode* node, ExprNode* row);
+
+/**
+ * @brief Evaluate the expression of a node of the graph.
+ *
+ * @note Matrix C must be pre-allocated by the caller. The value of the
+ * expression is added to the values of C, like the kernels do. The
+ * intermediate matrices are created in the workspace and stay there
+ * until the caller resets it. Without a workspace, they are allocated
+ * and freed on the heap. The statistics of the evaluation are stored
+ * in the ExprGraph.
+ *
+ * @param g Pointer to the ExprGraph.
+ * @param root The node to evaluate.
+ * @param C Pointer to the output Matrix (dimensions of the node).
+ * @param workspace The Arena for the intermediate matrices, or NULL.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_eval_expr(ExprGraph* g, ExprNode* root, Matrix* C, Arena* workspace,
+                                 size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_EXPR_H
@@ -0,0 +1,483 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include "matrix_multithread_factor.h"
+#include "matrix_multithread_9avx.h"
+#include "matrix_multithread_triangular.h"
+#include "../shared/queue.h"
+#include "../shared/task.h"
+#include "../shared/matrix_utils.h"
+// For the square root without libm
+#include <immintrin.h>
+
+/**
+ * @brief Helper function to create a view of the block of M starting at
+ * (row, col). The view shares the values and the stride of M.
+ *
+ * @return The view passed as value.
+*/
+Matrix view_factor(Matrix* M, size_t row, size_t col, size_t num_rows, size_t num_cols) {
+
+    Matrix view = *M;
+    view.values = &M->values[row * M->stride + col];
+    view.num_rows = num_rows;
+    view.num_cols = num_cols;
+    view.owns_rows = false;
+    view.mapped_size = 0;
+    return view;
+}
+
+pthread_mutex_t queue_lock_factor;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of the trailing
+ * Matrix that needs to be updated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_factor(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_factor) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_factor) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform the GEMM tile with the Task
+            thread_mult_9avx(t);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for the factorizations. Adds A * B_trans^T to C
+ * (all views) with a Task for each block of C, computed by
+ * NUM_THREADS threads.
+ *
+ * @param lower_only true to only create Tasks for the blocks on and
+ * below the diagonal of C.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int trailing_update_factor(Matrix* A, Matrix* B_trans, Matrix* C, bool lower_only,
+                           size_t block_size, size_t NUM_THREADS) {
+
+    size_t n = C->num_rows;
+    size_t p = C->num_cols;
+    size_t num_row_blocks = (n + block_size - 1) / block_size;
+    size_t num_col_blocks = (p + block_size - 1) / block_size;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i += block_size) {
+        size_t col_end = lower_only ? min(i + 1, p) : p;
+        for (size_t j = 0; j < col_end; j += block_size) {
+            queue_add(q, task_create(A, B_trans, C, block_size, i, j,
+                                     min(i + block_size, n), min(j + block_size, p)));
+        }
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_factor, NULL);
+
+    // More threads than Tasks would leave threads idle
+    size_t num_threads = min(NUM_THREADS, q->size);
+    pthread_t threads[num_threads];
+    size_t num_created = 0;
+    int result = 0;
+
+    for (; num_created < num_threads; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_factor, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    queue_free(q);
+    pthread_mutex_destroy(&queue_lock_factor);
+
+    return result;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_lu(). Factors the panel
+ * A[k0:n][k0:k1] column by column with partial pivoting, swapping the
+ * whole rows of A.
+ *
+ * @return true if a zero pivot was found.
+*/
+bool panel_lu_factor(Matrix* A, size_t* pivots, size_t k0, size_t k1) {
+
+    size_t n = A->num_rows;
+    size_t stride = A->stride;
+    double* A_arr = A->values;
+    bool is_singular = false;
+
+    for (size_t j = k0; j < k1; j++) {
+
+        // The largest absolute value in column j on or below the diagonal
+        size_t pivot = j;
+        double pivot_abs = fabs(A_arr[j * stride + j]);
+        for (size_t i = j + 1; i < n; i++) {
+            double value_abs = fabs(A_arr[i * stride + j]);
+            if (value_abs > pivot_abs) {
+                pivot = i;
+                pivot_abs = value_abs;
+            }
+        }
+        pivots[j] = pivot;
+
+        if (pivot != j) {
+            double* row_j = &A_arr[j * stride];
+            double* row_pivot = &A_arr[pivot * stride];
+            for (size_t c = 0; c < n; c++) {
+                double temp = row_j[c];
+                row_j[c] = row_pivot[c];
+                row_pivot[c] = temp;
+            }
+        }
+
+        double diagonal = A_arr[j * stride + j];
+        if (diagonal == 0.0) {
+            is_singular = true;
+            continue;
+        }
+
+        // Column j of L and the rank-1 update of the rest of the panel
+        const double* row_j = &A_arr[j * stride];
+        for (size_t i = j + 1; i < n; i++) {
+            double* row_i = &A_arr[i * stride];
+            double l = row_i[j] / diagonal;
+            row_i[j] = l;
+            for (size_t c = j + 1; c < k1; c++) {
+                row_i[c] -= l * row_j[c];
+            }
+        }
+    }
+
+    return is_singular;
+}
+
+int matrix_multithread_lu(Matrix* A, size_t* pivots, size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !pivots) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A or the pivots");
+        return -1;
+    }
+
+    if (A->num_rows != A->num_cols) {
+        errno = EINVAL;
+        perror("Error: Only square matrices can be factored");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix A has to be row-major");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    size_t n = A->num_rows;
+    bool is_singular = false;
+
+    for (size_t k0 = 0; k0 < n; k0 += block_size) {
+
+        size_t k1 = min(k0 + block_size, n);
+        size_t nb = k1 - k0;
+
+        is_singular |= panel_lu_factor(A, pivots, k0, k1);
+        if (k1 == n) {
+            break;
+        }
+        size_t m2 = n - k1;
+
+        // U12 = L11^-1 * A12
+        Matrix L11 = view_factor(A, k0, k0, nb, nb);
+        Matrix A12 = view_factor(A, k0, k1, nb, m2);
+        if (matrix_multithread_trsm(&L11, &A12, TRIANGLE_LOWER, true, block_size, NUM_THREADS) != 0) {
+            return -1;
+        }
+
+        // A22 += L21 * (-U12)
+        Matrix* U12_neg_trans = matrix_create_with(pattern_zero, NULL, m2, nb);
+        if (!U12_neg_trans) {
+            return -1;
+        }
+        for (size_t i = 0; i < nb; i++) {
+            for (size_t j = 0; j < m2; j++) {
+                U12_neg_trans->values[j * U12_neg_trans->stride + i] = -A12.values[i * A12.stride + j];
+            }
+        }
+        Matrix L21 = view_factor(A, k1, k0, m2, nb);
+        Matrix A22 = view_factor(A, k1, k1, m2, m2);
+        int result = trailing_update_factor(&L21, U12_neg_trans, &A22, false, block_size, NUM_THREADS);
+        matrix_free(U12_neg_trans);
+        if (result != 0) {
+            return -1;
+        }
+    }
+
+    return is_singular ? 1 : 0;
+}
+
+int matrix_lu_solve(Matrix* LU, const size_t* pivots, Matrix* B, size_t block_size, size_t NUM_THREADS) {
+
+    if (!LU || !pivots || !B) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix LU, the pivots or Matrix B");
+        return -1;
+    }
+
+    if (LU->num_rows != LU->num_cols || LU->num_rows != B->num_rows) {
+        errno = EINVAL;
+        perror("Error: LU has to be n x n and B n x p");
+        return -1;
+    }
+
+    if (LU->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices LU and B have to be row-major");
+        return -1;
+    }
+
+    // B := P * B, in the order of the factorization
+    size_t p = B->num_cols;
+    for (size_t i = 0; i < B->num_rows; i++) {
+        if (pivots[i] != i) {
+            double* row_i = &B->values[i * B->stride];
+            double* row_pivot = &B->values[pivots[i] * B->stride];
+            for (size_t c = 0; c < p; c++) {
+                double temp = row_i[c];
+                row_i[c] = row_pivot[c];
+                row_pivot[c] = temp;
+            }
+        }
+    }
+
+    // L * U * X = P * B
+    if (matrix_multithread_trsm(LU, B, TRIANGLE_LOWER, true, block_size, NUM_THREADS) != 0) {
+        return -1;
+    }
+    return matrix_multithread_trsm(LU, B, TRIANGLE_UPPER, false, block_size, NUM_THREADS);
+}
+
+/**
+ * @brief Helper function for matrix_multithread_cholesky(). Factors the
+ * diagonal block A[k0:k1][k0:k1] unblocked (lower triangle only).
+ *
+ * @return false if the block is not positive definite.
+*/
+bool diagonal_cholesky_factor(Matrix* A, size_t k0, size_t k1) {
+
+    size_t stride = A->stride;
+    double* A_arr = A->values;
+
+    for (size_t j = k0; j < k1; j++) {
+
+        double* row_j = &A_arr[j * stride];
+        double diagonal = row_j[j];
+        for (size_t k = k0; k < j; k++) {
+            diagonal -= row_j[k] * row_j[k];
+        }
+        if (!(diagonal > 0.0)) {
+            return false;
+        }
+        diagonal = _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(diagonal)));
+        row_j[j] = diagonal;
+
+        for (size_t i = j + 1; i < k1; i++) {
+            double* row_i = &A_arr[i * stride];
+            double value = row_i[j];
+            for (size_t k = k0; k < j; k++) {
+                value -= row_i[k] * row_j[k];
+            }
+            row_i[j] = value / diagonal;
+        }
+    }
+
+    return true;
+}
+
+int matrix_multithread_cholesky(Matrix* A, size_t block_size, size_t NUM_THREADS) {
+
+    if (!A) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix A");
+        return -1;
+    }
+
+    if (A->num_rows != A->num_cols) {
+        errno = EINVAL;
+        perror("Error: Only square matrices can be factored");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix A has to be row-major");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    size_t n = A->num_rows;
+
+    for (size_t k0 = 0; k0 < n; k0 += block_size) {
+
+        size_t k1 = min(k0 + block_size, n);
+        size_t nb = k1 - k0;
+
+        if (!diagonal_cholesky_factor(A, k0, k1)) {
+            return 1;
+        }
+        if (k1 == n) {
+            break;
+        }
+        size_t m2 = n - k1;
+
+        // L21^T = L11^-1 * A21^T, computed on a copy of A21^T
+        Matrix* L21_trans = matrix_create_with(pattern_zero, NULL, nb, m2);
+        if (!L21_trans) {
+            return -1;
+        }
+        Matrix A21 = view_factor(A, k1, k0, m2, nb);
+        for (size_t i = 0; i < m2; i++) {
+            for (size_t j = 0; j < nb; j++) {
+                L21_trans->values[j * L21_trans->stride + i] = A21.values[i * A21.stride + j];
+            }
+        }
+        Matrix L11 = view_factor(A, k0, k0, nb, nb);
+        if (matrix_multithread_trsm(&L11, L21_trans, TRIANGLE_LOWER, false, block_size, NUM_THREADS) != 0) {
+            matrix_free(L21_trans);
+            return -1;
+        }
+
+        // Store L21 in A and -L21 as B transposed of the update
+        Matrix* L21_neg = matrix_create_with(pattern_zero, NULL, m2, nb);
+        if (!L21_neg) {
+            matrix_free(L21_trans);
+            return -1;
+        }
+        for (size_t i = 0; i < m2; i++) {
+            for (size_t j = 0; j < nb; j++) {
+                double l = L21_trans->values[j * L21_trans->stride + i];
+                A21.values[i * A21.stride + j] = l;
+                L21_neg->values[i * L21_neg->stride + j] = -l;
+            }
+        }
+        matrix_free(L21_trans);
+
+        // A22 += L21 * (-L21)^T (blocks on and below the diagonal)
+        Matrix A22 = view_factor(A, k1, k1, m2, m2);
+        int result = trailing_update_factor(&A21, L21_neg, &A22, true, block_size, NUM_THREADS);
+        matrix_free(L21_neg);
+        if (result != 0) {
+            return -1;
+        }
+    }
+
+    // The diagonal blocks of the updates also wrote above the diagonal
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            A->values[i * A->stride + j] = 0.0;
+        }
+    }
+
+    return 0;
+}
+
+int matrix_cholesky_solve(Matrix* L, Matrix* B, size_t block_size, size_t NUM_THREADS) {
+
+    if (!L || !B) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix L or Matrix B");
+        return -1;
+    }
+
+    if (L->num_rows != L->num_cols || L->num_rows != B->num_rows) {
+        errno = EINVAL;
+        perror("Error: L has to be n x n and B n x p");
+        return -1;
+    }
+
+    if (L->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices L and B have to be row-major");
+        return -1;
+    }
+
+    // L * Y = B
+    if (matrix_multithread_trsm(L, B, TRIANGLE_LOWER, false, block_size, NUM_THREADS) != 0) {
+        return -1;
+    }
+
+    // L^T * X = Y, with L^T as an upper triangular Matrix
+    size_t n = L->num_rows;
+    Matrix* L_trans = matrix_create_with(pattern_zero, NULL, n, n);
+    if (!L_trans) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            L_trans->values[j * L_trans->stride + i] = L->values[i * L->stride + j];
+        }
+    }
+    int result = matrix_multithread_trsm(L_trans, B, TRIANGLE_UPPER, false, block_size, NUM_THREADS);
+    matrix_free(L_trans);
+
+    return result;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file matrix_multithread_factor.h
+ *
+ * @brief Contains function prototypes for the blocked LU factorization
+ * with partial pivoting and the blocked Cholesky factorization, plus the
+ * corresponding solves, utilizing the following for improved performance:
+ * - Multithreading
+ * - SIMD registers (the tile kernel of matrix_multithread_9avx.h)
+ * - Blocking / tiling method
+ *
+ * @details
+ * Both factorizations are right-looking. For each panel of block_size
+ * columns starting at k0 (k1 = k0 + block_size):
+ *
+ * LU:
+ * 1. The panel A[k0:n][k0:k1] is factored column by column with partial
+ *    pivoting. Each pivot swaps the whole rows of A.
+ * 2. U12 = L11^-1 * A12 with matrix_multithread_trsm().
+ * 3. A22 -= L21 * U12, the O(n^3) part.
+ *
+ * Cholesky (lower):
+ * 1. The diagonal block A11 = L11 * L11^T is factored unblocked.
+ * 2. L21 = A21 * L11^-T with matrix_multithread_trsm() on A21^T.
+ * 3. A22 -= L21 * L21^T, only the blocks on and below the diagonal.
+ *
+ * Step 3 is split into Tasks (blocks of A22) that are handed out
+ * through a Queue and computed by thread_mult_9avx() on views into A.
+ * The tile kernel adds, so the B transposed operand is a negated copy
+ * (-U12^T for LU, -L21 for Cholesky). The serial panel work is
+ * O(n^2 * block_size) in total.
+ */
+
+#ifndef MATRIX_MULTITHREAD_FACTOR_H
+#define MATRIX_MULTITHREAD_FACTOR_H
+
+#include "../shared/matrix.h"
+
+/**
+ * @brief Factor A in place into P * A = L * U with partial pivoting.
+ *
+ * @note On return, the strict lower triangle of A holds L (with an
+ * implicit unit diagonal) and the upper triangle holds U.
+ *
+ * @param A Pointer to the Matrix to factor (dimensions n x n).
+ * @param pivots Array of n elements that receives the pivots: at step i,
+ * row i was swapped with row pivots[i] (>= i).
+ * @param block_size The block size (panel width) of the blocked method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success, 1 if A is singular (a zero pivot
+ * was found, the factorization is still completed) and -1 if an error
+ * occured.
+*/
+int matrix_multithread_lu(Matrix* A, size_t* pivots, size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Solve A * X = B with the factorization of matrix_multithread_lu().
+ *
+ * @param LU Pointer to the factored Matrix (dimensions n x n).
+ * @param pivots The pivots of the factorization.
+ * @param B Pointer to the Matrix (dimensions n x p) that is overwritten
+ * with the solution X.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_lu_solve(Matrix* LU, const size_t* pivots, Matrix* B, size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Factor the symmetric positive definite A in place into
+ * A = L * L^T.
+ *
+ * @note Only the lower triangle of A is read. On return, it holds L and
+ * the strict upper triangle is set to zero.
+ *
+ * @param A Pointer to the Matrix to factor (dimensions n x n).
+ * @param block_size The block size (panel width) of the blocked method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success, 1 if A is not positive definite
+ * (A is then left partially factored) and -1 if an error occured.
+*/
+int matrix_multithread_cholesky(Matrix* A, size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Solve A * X = B with the factor L of matrix_multithread_cholesky().
+ *
+ * @param L Pointer to the factor (dimensions n x n).
+ * @param B Pointer to the Matrix (dimensions n x p) that is overwritten
+ * with the solution X.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_cholesky_solve(Matrix* L, Matrix* B, size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_FACTOR_H
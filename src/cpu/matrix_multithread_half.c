@@ -0,0 +1,339 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_half.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// The operands of the current multiplication (Task only holds double matrices)
+MatrixHalf* A_half = NULL;
+MatrixHalf* B_trans_half = NULL;
+Matrix* C_half = NULL;
+HalfAccumulation accumulation_half = HALF_ACCUMULATE_FP32;
+
+/**
+ * @brief Helper function for matrix_multithread_mult_half(). It creates
+ * the transpose of B (freed at the end of matrix_multithread_mult_half())
+ * and a Queue filled with a Task for each block of Matrix C.
+ *
+ * @param B Pointer to Matrix B.
+ * @param n The number of rows in C.
+ * @param p The number of columns in C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_half(MatrixHalf* B, size_t n, size_t p, size_t block_size) {
+
+    // Create a new MatrixHalf that is the transpose of Matrix B
+    B_trans_half = matrix_half_create(B->format, B->num_cols, B->num_rows);
+    if (!B_trans_half) {
+        return NULL;
+    }
+    for (size_t i = 0; i < B->num_rows; i++) {
+        for (size_t j = 0; j < B->num_cols; j++) {
+            B_trans_half->values[j * B_trans_half->stride + i] = B->values[i * B->stride + j];
+        }
+    }
+
+    // The number of blocks in each dimension of C (rounded up)
+    size_t num_row_blocks = (n + block_size - 1) / block_size;
+    size_t num_col_blocks = (p + block_size - 1) / block_size;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        matrix_half_free(B_trans_half);
+        B_trans_half = NULL;
+        return NULL;
+    }
+
+    // Turn each block in C into a Task (the matrices are A_half, B_trans_half and C_half)
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j < p; j += block_size) {
+            Task t = {0};
+            t.block_size = block_size;
+            t.C_row_start = i;
+            t.C_col_start = j;
+            t.C_row_end = min(i + block_size, n);
+            t.C_col_end = min(j + block_size, p);
+            t.is_valid = true;
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to load 8 16-bit values and widen them to fp32.
+ *
+ * @param src Pointer to the 8 values (16-byte aligned).
+ * @param format The 16-bit format of the values.
+ * @return The 8 fp32 values.
+*/
+__m256 load_ps_half(const uint16_t* src, HalfFormat format) {
+
+    __m128i raw = _mm_load_si128((const __m128i*)src);
+    if (format == HALF_FP16) {
+        return _mm256_cvtph_ps(raw);
+    }
+    // bf16 is the upper half of fp32
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(raw), 16));
+}
+
+/**
+ * @brief Helper function to add the 8 fp32 values of v.
+ *
+ * @param v The vector to reduce.
+ * @return The sum.
+*/
+double hsum_ps_half(__m256 v) {
+
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+/**
+ * @brief Helper function to add the 4 fp64 values of v.
+ *
+ * @param v The vector to reduce.
+ * @return The sum.
+*/
+double hsum_pd_half(__m256d v) {
+
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+    return _mm_cvtsd_f64(sum);
+}
+
+/**
+ * @brief Helper function to thread_mult_half(). Computes four elements
+ * C[ii][jj..jj+num_cols-1] (num_cols <= 4) with fp32 accumulators.
+ *
+ * @param a_row Row ii of A.
+ * @param b_rows Rows jj.. of B transposed.
+ * @param num_cols The number of elements of C to compute (1-4).
+ * @param c_out Where to store the elements of C.
+*/
+void dot_fp32_half(const uint16_t* a_row, const uint16_t* b_rows[4], size_t num_cols, double* c_out) {
+
+    HalfFormat a_format = A_half->format;
+    HalfFormat b_format = B_trans_half->format;
+    size_t len = A_half->stride;
+
+    __m256 c_acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+
+    for (size_t kk = 0; kk < len; kk += 8) {
+        __m256 a_vals = load_ps_half(&a_row[kk], a_format);
+        for (size_t c = 0; c < num_cols; c++) {
+            c_acc[c] = _mm256_fmadd_ps(a_vals, load_ps_half(&b_rows[c][kk], b_format), c_acc[c]);
+        }
+    }
+
+    for (size_t c = 0; c < num_cols; c++) {
+        c_out[c] = hsum_ps_half(c_acc[c]);
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_half(). Computes four elements
+ * C[ii][jj..jj+num_cols-1] (num_cols <= 4) with fp64 accumulators.
+ *
+ * @param a_row Row ii of A.
+ * @param b_rows Rows jj.. of B transposed.
+ * @param num_cols The number of elements of C to compute (1-4).
+ * @param c_out Where to store the elements of C.
+*/
+void dot_fp64_half(const uint16_t* a_row, const uint16_t* b_rows[4], size_t num_cols, double* c_out) {
+
+    HalfFormat a_format = A_half->format;
+    HalfFormat b_format = B_trans_half->format;
+    size_t len = A_half->stride;
+
+    __m256d c_acc_lo[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+    __m256d c_acc_hi[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+
+    for (size_t kk = 0; kk < len; kk += 8) {
+        __m256 a_vals = load_ps_half(&a_row[kk], a_format);
+        __m256d a_lo = _mm256_cvtps_pd(_mm256_castps256_ps128(a_vals));
+        __m256d a_hi = _mm256_cvtps_pd(_mm256_extractf128_ps(a_vals, 1));
+        for (size_t c = 0; c < num_cols; c++) {
+            __m256 b_vals = load_ps_half(&b_rows[c][kk], b_format);
+            c_acc_lo[c] = _mm256_fmadd_pd(a_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(b_vals)), c_acc_lo[c]);
+            c_acc_hi[c] = _mm256_fmadd_pd(a_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(b_vals, 1)), c_acc_hi[c]);
+        }
+    }
+
+    for (size_t c = 0; c < num_cols; c++) {
+        c_out[c] = hsum_pd_half(_mm256_add_pd(c_acc_lo[c], c_acc_hi[c]));
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_half(). Computes the block of
+ * Matrix C described by Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_half(Task t) {
+
+    double* C_arr = C_half->values;
+    size_t c_stride = C_half->stride;
+
+    for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+
+        const uint16_t* a_row = &A_half->values[ii * A_half->stride];
+
+        // Four columns of C at a time to reuse each load of A
+        for (size_t jj = t.C_col_start; jj < t.C_col_end; jj += 4) {
+
+            size_t num_cols = min(4, t.C_col_end - jj);
+            const uint16_t* b_rows[4];
+            for (size_t c = 0; c < num_cols; c++) {
+                b_rows[c] = &B_trans_half->values[(jj + c) * B_trans_half->stride];
+            }
+
+            if (accumulation_half == HALF_ACCUMULATE_FP64) {
+                dot_fp64_half(a_row, b_rows, num_cols, &C_arr[ii * c_stride + jj]);
+            } else {
+                dot_fp32_half(a_row, b_rows, num_cols, &C_arr[ii * c_stride + jj]);
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_half;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_half(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_half) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_half) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_half(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_mult_half(MatrixHalf* A, MatrixHalf* B, Matrix* C,
+                                 HalfAccumulation accumulation,
+                                 size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix C has to be row-major");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create B transposed and a Queue filled with all the tasks / blocks to calculate in C
+    Queue* q = preprocessing_half(B, A->num_rows, B->num_cols, block_size);
+    if (!q) {
+        return -1;
+    }
+    A_half = A;
+    C_half = C;
+    accumulation_half = accumulation;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_half, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_half() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_half, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    matrix_half_free(B_trans_half);
+    A_half = NULL;
+    B_trans_half = NULL;
+    C_half = NULL;
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_half);
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file matrix_multithread_half.h
+ *
+ * @brief Contains function prototypes for Matrix multiplication of
+ * 16-bit floating-point matrices (see matrix_half.h) utilizing the
+ * following for improved performance:
+ * - Multithreading
+ * - On the fly conversion to fp32 inside the AVX registers
+ * - FMA with fp32 or fp64 accumulators
+ * - Blocking / tiling method
+ *
+ * @details
+ * Each load of 16 bytes holds 8 elements that are widened to 8 fp32
+ * values: HALF_FP16 with _mm256_cvtph_ps (F16C), HALF_BF16 by zero
+ * extending to 32 bits and shifting left by 16. A and B may use
+ * different formats.
+ *
+ * - HALF_ACCUMULATE_FP32: one _mm256_fmadd_ps per 8 elements. The error
+ *   of the sum grows with the inner dimension m (fp32 has 24 mantissa
+ *   bits).
+ * - HALF_ACCUMULATE_FP64: the fp32 values are widened to fp64 and
+ *   accumulated with two _mm256_fmadd_pd per 8 elements. The products
+ *   are exact, so the only error left is the rounding of the inputs.
+ *
+ * As in matrix_multithread_9avx.h, B is transposed such that each
+ * element of C is a dot product of two contiguous rows, and a single
+ * Queue hands out Tasks corresponding to blocks of C. The padding of
+ * the MatrixHalf rows is zero, so the dot products run over whole
+ * registers without a scalar tail.
+ */
+
+#ifndef MATRIX_MULTITHREAD_HALF_H
+#define MATRIX_MULTITHREAD_HALF_H
+
+#include "../shared/matrix.h"
+#include "../shared/matrix_half.h"
+
+// The precision of the accumulators
+typedef enum {
+    HALF_ACCUMULATE_FP32 = 0, // = 0 to be able to loop through enums
+    HALF_ACCUMULATE_FP64
+} HalfAccumulation;
+
+/**
+ * @brief Matrix multiply the two 16-bit matrices A and B.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller and has to be
+ * row-major. Its values are overwritten (not accumulated).
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param accumulation The precision of the accumulators.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_half(MatrixHalf* A, MatrixHalf* B, Matrix* C,
+                                 HalfAccumulation accumulation,
+                                 size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_HALF_H
@@ -0,0 +1,338 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include "matrix_multithread_int.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// The operands of one multiplication (Task only holds double matrices),
+// reached from each of its Tasks
+typedef struct {
+
+    QuantMatrix* A;
+    QuantMatrix* B_trans;
+    MatrixInt32* C;
+
+    // The Tasks of the multiplication and the mutex guarding them
+    Queue* q;
+    pthread_mutex_t queue_lock;
+
+} IntContext;
+
+/**
+ * @brief Helper function for matrix_multithread_mult_int(). It creates
+ * the transpose of B with its scales and zero points (freed at the end of
+ * matrix_multithread_mult_int()) and a Queue filled with a Task for each
+ * block of Matrix C.
+ *
+ * @param B Pointer to Matrix B.
+ * @param n The number of rows in C.
+ * @param p The number of columns in C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param ctx Pointer to the IntContext of the multiplication, which
+ * receives B transposed and the Queue.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_int(QuantMatrix* B, size_t n, size_t p, size_t block_size, IntContext* ctx) {
+
+    // Create a new QuantMatrix that is the transpose of Matrix B. Row i of B
+    // is column i of B transposed, so the per-channel parameters swap axes.
+    QuantGranularity granularity = B->granularity;
+    if (granularity == QUANT_PER_ROW) {
+        granularity = QUANT_PER_COL;
+    } else if (granularity == QUANT_PER_COL) {
+        granularity = QUANT_PER_ROW;
+    }
+    QuantMatrix* B_trans_int = quant_matrix_create(B->type, B->num_cols, B->num_rows, granularity);
+    if (!B_trans_int) {
+        return NULL;
+    }
+    memcpy(B_trans_int->scales, B->scales, sizeof(double) * B->num_params);
+    memcpy(B_trans_int->zero_points, B->zero_points, sizeof(int32_t) * B->num_params);
+    size_t element_size = quant_type_size(B->type);
+    char* B_arr = (char*)B->values;
+    char* B_trans_arr = (char*)B_trans_int->values;
+    for (size_t i = 0; i < B->num_rows; i++) {
+        for (size_t j = 0; j < B->num_cols; j++) {
+            memcpy(&B_trans_arr[(j * B_trans_int->stride + i) * element_size],
+                   &B_arr[(i * B->stride + j) * element_size], element_size);
+        }
+    }
+
+    // The number of blocks in each dimension of C (rounded up)
+    size_t num_row_blocks = (n + block_size - 1) / block_size;
+    size_t num_col_blocks = (p + block_size - 1) / block_size;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        quant_matrix_free(B_trans_int);
+        return NULL;
+    }
+    ctx->B_trans = B_trans_int;
+    ctx->q = q;
+
+    // Turn each block in C into a Task (the matrices are in the IntContext)
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j < p; j += block_size) {
+            Task t = {0};
+            t.block_size = block_size;
+            t.C_row_start = i;
+            t.C_col_start = j;
+            t.C_row_end = min(i + block_size, n);
+            t.C_col_end = min(j + block_size, p);
+            t.is_valid = true;
+            t.context = ctx;
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to add the 8 int32 values of v.
+ *
+ * @param v The vector to reduce.
+ * @return The sum.
+*/
+int32_t hsum_epi32_int(__m256i v) {
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+/**
+ * @brief Helper function to multiply 32 bytes of A with 32 bytes of a
+ * row of B transposed into 8 int32 partial sums.
+ *
+ * @param a 32 u8 (QUANT_UINT8) or 16 int16 (QUANT_INT16) values of A.
+ * @param b 32 s8 (QUANT_INT8) or 16 int16 (QUANT_INT16) values of B.
+ * @param is_int16 true for QUANT_INT16 x QUANT_INT16.
+ * @return The 8 int32 partial sums.
+*/
+__m256i madd_int(__m256i a, __m256i b, bool is_int16) {
+
+    if (is_int16) {
+        return _mm256_madd_epi16(a, b);
+    }
+    // u8 x s8 into int16 pairs, then widen the pairs into int32
+    __m256i pairs = _mm256_maddubs_epi16(a, b);
+    return _mm256_madd_epi16(pairs, _mm256_set1_epi16(1));
+}
+
+/**
+ * @brief Helper function to process_tasks_int(). Computes the block of
+ * Matrix C described by Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_int(Task t) {
+
+    IntContext* ctx = (IntContext*)t.context;
+    QuantMatrix* A_int = ctx->A;
+    QuantMatrix* B_trans_int = ctx->B_trans;
+    MatrixInt32* C_int = ctx->C;
+    bool is_int16 = A_int->type == QUANT_INT16;
+
+    // Both rows are padded with zeros to the same number of bytes
+    size_t row_bytes = A_int->stride * quant_type_size(A_int->type);
+    size_t b_row_bytes = B_trans_int->stride * quant_type_size(B_trans_int->type);
+    char* A_arr = (char*)A_int->values;
+    char* B_trans_arr = (char*)B_trans_int->values;
+    int32_t* C_arr = C_int->values;
+    size_t c_stride = C_int->stride;
+
+    for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+
+        const char* a_row = &A_arr[ii * row_bytes];
+        size_t jj = t.C_col_start;
+
+        // Four columns of C at a time to reuse each load of A
+        for (; jj + 3 < t.C_col_end; jj += 4) {
+
+            const char* b_row0 = &B_trans_arr[jj * b_row_bytes];
+            const char* b_row1 = b_row0 + b_row_bytes;
+            const char* b_row2 = b_row1 + b_row_bytes;
+            const char* b_row3 = b_row2 + b_row_bytes;
+
+            __m256i c_acc0 = _mm256_setzero_si256();
+            __m256i c_acc1 = _mm256_setzero_si256();
+            __m256i c_acc2 = _mm256_setzero_si256();
+            __m256i c_acc3 = _mm256_setzero_si256();
+
+            for (size_t kk = 0; kk < row_bytes; kk += 32) {
+                __m256i a_vals = _mm256_load_si256((const __m256i*)&a_row[kk]);
+                c_acc0 = _mm256_add_epi32(c_acc0, madd_int(a_vals, _mm256_load_si256((const __m256i*)&b_row0[kk]), is_int16));
+                c_acc1 = _mm256_add_epi32(c_acc1, madd_int(a_vals, _mm256_load_si256((const __m256i*)&b_row1[kk]), is_int16));
+                c_acc2 = _mm256_add_epi32(c_acc2, madd_int(a_vals, _mm256_load_si256((const __m256i*)&b_row2[kk]), is_int16));
+                c_acc3 = _mm256_add_epi32(c_acc3, madd_int(a_vals, _mm256_load_si256((const __m256i*)&b_row3[kk]), is_int16));
+            }
+
+            C_arr[ii * c_stride + jj] = hsum_epi32_int(c_acc0);
+            C_arr[ii * c_stride + jj + 1] = hsum_epi32_int(c_acc1);
+            C_arr[ii * c_stride + jj + 2] = hsum_epi32_int(c_acc2);
+            C_arr[ii * c_stride + jj + 3] = hsum_epi32_int(c_acc3);
+        }
+
+        // Remaining columns of the block
+        for (; jj < t.C_col_end; jj++) {
+            const char* b_row = &B_trans_arr[jj * b_row_bytes];
+            __m256i c_acc = _mm256_setzero_si256();
+            for (size_t kk = 0; kk < row_bytes; kk += 32) {
+                __m256i a_vals = _mm256_load_si256((const __m256i*)&a_row[kk]);
+                c_acc = _mm256_add_epi32(c_acc, madd_int(a_vals, _mm256_load_si256((const __m256i*)&b_row[kk]), is_int16));
+            }
+            C_arr[ii * c_stride + jj] = hsum_epi32_int(c_acc);
+        }
+    }
+}
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the IntContext that contains the Queue and
+ * its mutex.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_int(void* arg) {
+
+    // Extract argument
+    IntContext* ctx = (IntContext*) arg;
+    Queue* q = ctx->q;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&ctx->queue_lock) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&ctx->queue_lock) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_int(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_mult_int(QuantMatrix* A, QuantMatrix* B, MatrixInt32* C,
+                                size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    // See matrix_quant.h for the supported combinations
+    if (!(A->type == QUANT_UINT8 && B->type == QUANT_INT8) &&
+        !(A->type == QUANT_INT16 && B->type == QUANT_INT16)) {
+        errno = EINVAL;
+        perror("Error: Only QUANT_UINT8 x QUANT_INT8 and QUANT_INT16 x QUANT_INT16 are supported");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // _mm256_maddubs_epi16 saturates the int16 pair sums above 7 bit values of A
+    if (A->type == QUANT_UINT8) {
+        for (size_t i = 0; i < A->num_rows; i++) {
+            const uint8_t* row = (const uint8_t*)A->values + i * A->stride;
+            for (size_t j = 0; j < A->num_cols; j++) {
+                if (row[j] > 127) {
+                    errno = EINVAL;
+                    perror("Error: QUANT_UINT8 values of A have to be at most 127 (7 bits)");
+                    return -1;
+                }
+            }
+        }
+    }
+
+    // Create B transposed and a Queue filled with all the tasks / blocks to calculate in C
+    IntContext ctx = {0};
+    ctx.A = A;
+    ctx.C = C;
+    Queue* q = preprocessing_int(B, A->num_rows, B->num_cols, block_size, &ctx);
+    if (!q) {
+        return -1;
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&ctx.queue_lock, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_int() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_int, &ctx) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    quant_matrix_free(ctx.B_trans);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&ctx.queue_lock);
+
+    return result;
+}
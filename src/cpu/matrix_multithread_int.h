@@ -0,0 +1,58 @@
+/**
+ * @file matrix_multithread_int.h
+ *
+ * @brief Contains function prototypes for integer Matrix multiplication
+ * of quantized matrices (see matrix_quant.h) with int32 accumulation
+ * utilizing the following for improved performance:
+ * - Multithreading
+ * - AVX2 integer multiply-add instructions
+ * - Blocking / tiling method
+ *
+ * @details
+ * Two combinations of input types are supported:
+ * - QUANT_UINT8 x QUANT_INT8: _mm256_maddubs_epi16 multiplies 32 pairs
+ *   of u8 x s8 and adds neighbouring products into 16 int16 values,
+ *   _mm256_madd_epi16 with a vector of ones widens and adds these into
+ *   8 int32 accumulators. The int16 sums saturate for 8 bit values of A
+ *   (255 * 127 * 2 > 32767), so A is limited to 7 bits (0-127), which
+ *   matrix_quantize() uses for QUANT_UINT8 at most.
+ * - QUANT_INT16 x QUANT_INT16: _mm256_madd_epi16 multiplies 16 pairs of
+ *   int16 and adds neighbouring products into 8 int32 accumulators.
+ *
+ * As in matrix_multithread_9avx.h, B is transposed such that each
+ * element of C is a dot product of two contiguous rows, and a single
+ * Queue hands out Tasks corresponding to blocks of C. The padding of
+ * the QuantMatrix rows is zero, so the dot products run over whole
+ * AVX2 registers without a scalar tail.
+ *
+ * The result is the raw integer product of the quantized values. Use
+ * matrix_dequantize_product() to obtain the real product.
+ */
+
+#ifndef MATRIX_MULTITHREAD_INT_H
+#define MATRIX_MULTITHREAD_INT_H
+
+#include "../shared/matrix_quant.h"
+
+/**
+ * @brief Integer Matrix multiply the two quantized matrices A and B.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. Its values are
+ * overwritten (not accumulated). The QUANT_UINT8 values of A have to be
+ * at most 127, otherwise the call fails.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m) of
+ * type QUANT_UINT8 or QUANT_INT16.
+ * @param B Pointer to the second input Matrix (dimensions m x p) of
+ * type QUANT_INT8 or QUANT_INT16 respectively.
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_int(QuantMatrix* A, QuantMatrix* B, MatrixInt32* C,
+                                size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_INT_H
@@ -0,0 +1,323 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_oblivious.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+/**
+ * @brief Helper function to split_oblivious() and multiply_oblivious().
+ * Returns the split point of the range [start, end), the middle rounded
+ * up to a multiple of multiple (relative to start) such that the
+ * micro-tiles stay whole.
+*/
+size_t middle_oblivious(size_t start, size_t end, size_t multiple) {
+
+    size_t half = ((end - start) / 2 + multiple - 1) / multiple * multiple;
+    return start + half;
+}
+
+/**
+ * @brief Helper function for preprocessing_oblivious(). Recursively
+ * halves the larger of the rows and the columns of the part of C until
+ * num_tasks parts are reached, and adds the parts to the Queue in the
+ * order of the recursion (Morton order).
+ *
+ * @param q The Queue to add the Tasks to.
+ * @param t The Task of the whole part, with the matrices set.
+ * @param num_tasks The number of Tasks to divide the part into.
+*/
+void split_oblivious(Queue* q, Task t, size_t num_tasks) {
+
+    size_t num_rows = t.C_row_end - t.C_row_start;
+    size_t num_cols = t.C_col_end - t.C_col_start;
+
+    if (num_tasks <= 1 || (num_rows <= 4 && num_cols <= 8)) {
+        queue_add(q, t);
+        return;
+    }
+
+    Task first = t;
+    Task second = t;
+    if (num_cols <= 8 || (num_rows > num_cols && num_rows > 4)) {
+        first.C_row_end = second.C_row_start = middle_oblivious(t.C_row_start, t.C_row_end, 4);
+    } else {
+        first.C_col_end = second.C_col_start = middle_oblivious(t.C_col_start, t.C_col_end, 8);
+    }
+
+    split_oblivious(q, first, (num_tasks + 1) / 2);
+    split_oblivious(q, second, num_tasks / 2);
+}
+
+/**
+ * @brief Helper function for matrix_multithread_mult_oblivious(). It
+ * creates a Queue filled with the Tasks of C in Morton order.
+ *
+ * @param A Pointer to Matrix A (A x B = C).
+ * @param B Pointer to Matrix B.
+ * @param C Pointer to Matrix C.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_oblivious(Matrix* A, Matrix* B, Matrix* C, size_t NUM_THREADS) {
+
+    size_t num_tasks = OBLIVIOUS_TASKS_PER_THREAD * NUM_THREADS;
+
+    Queue* q = queue_create(num_tasks);
+    if (!q) {
+        return NULL;
+    }
+
+    // B is not transposed, it is held in B_trans
+    Task t = task_create(A, B, C, 0, 0, 0, C->num_rows, C->num_cols);
+    split_oblivious(q, t, num_tasks);
+
+    return q;
+}
+
+/**
+ * @brief Helper function to base_oblivious(). Updates a micro-tile of
+ * up to 4 rows and 8 columns of C with k_len columns of A.
+ *
+ * @param a Pointer to the first row of the micro-tile in A (column k).
+ * @param b Pointer to the first column of the micro-tile in B (row k).
+ * @param c Pointer to the top-left element of the micro-tile in C.
+ * @param num_rows The number of rows of the micro-tile (1-4).
+*/
+void tile_oblivious(const double* a, size_t a_stride, const double* b, size_t b_stride,
+                    double* c, size_t c_stride, size_t num_rows, size_t k_len) {
+
+    __m256d c_vec[4][2];
+    for (size_t r = 0; r < num_rows; r++) {
+        c_vec[r][0] = _mm256_loadu_pd(&c[r * c_stride]);
+        c_vec[r][1] = _mm256_loadu_pd(&c[r * c_stride + 4]);
+    }
+
+    for (size_t kk = 0; kk < k_len; kk++) {
+        __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+        __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+        for (size_t r = 0; r < num_rows; r++) {
+            __m256d a_val = _mm256_broadcast_sd(&a[r * a_stride + kk]);
+            c_vec[r][0] = _mm256_fmadd_pd(a_val, b_vals1, c_vec[r][0]);
+            c_vec[r][1] = _mm256_fmadd_pd(a_val, b_vals2, c_vec[r][1]);
+        }
+    }
+
+    for (size_t r = 0; r < num_rows; r++) {
+        _mm256_storeu_pd(&c[r * c_stride], c_vec[r][0]);
+        _mm256_storeu_pd(&c[r * c_stride + 4], c_vec[r][1]);
+    }
+}
+
+/**
+ * @brief Helper function to multiply_oblivious(). The base case of the
+ * recursion, adds A[i0:i1][k0:k1] x B[k0:k1][j0:j1] to C[i0:i1][j0:j1].
+*/
+void base_oblivious(Matrix* A, Matrix* B, Matrix* C,
+                    size_t i0, size_t i1, size_t k0, size_t k1, size_t j0, size_t j1) {
+
+    size_t a_stride = A->stride;
+    size_t b_stride = B->stride;
+    size_t c_stride = C->stride;
+
+    for (size_t ii = i0; ii < i1; ii += 4) {
+        size_t num_rows = min(4, i1 - ii);
+        size_t jj = j0;
+
+        // The constant 4 for full micro-tiles lets the compiler keep the accumulators in registers
+        for (; jj + 7 < j1; jj += 8) {
+            if (num_rows == 4) {
+                tile_oblivious(&A->values[ii * a_stride + k0], a_stride, &B->values[k0 * b_stride + jj], b_stride,
+                               &C->values[ii * c_stride + jj], c_stride, 4, k1 - k0);
+            } else {
+                tile_oblivious(&A->values[ii * a_stride + k0], a_stride, &B->values[k0 * b_stride + jj], b_stride,
+                               &C->values[ii * c_stride + jj], c_stride, num_rows, k1 - k0);
+            }
+        }
+
+        // Handle residual columns
+        for (size_t r = ii; r < ii + num_rows; r++) {
+            for (size_t j = jj; j < j1; j++) {
+                double c_value = C->values[r * c_stride + j];
+                for (size_t kk = k0; kk < k1; kk++) {
+                    c_value += A->values[r * a_stride + kk] * B->values[kk * b_stride + j];
+                }
+                C->values[r * c_stride + j] = c_value;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_oblivious(). Adds
+ * A[i0:i1][k0:k1] x B[k0:k1][j0:j1] to C[i0:i1][j0:j1] by halving the
+ * largest of the three dimensions until the base case is reached.
+*/
+void multiply_oblivious(Matrix* A, Matrix* B, Matrix* C,
+                        size_t i0, size_t i1, size_t k0, size_t k1, size_t j0, size_t j1) {
+
+    size_t num_rows = i1 - i0;
+    size_t num_shared = k1 - k0;
+    size_t num_cols = j1 - j0;
+
+    if (num_rows <= OBLIVIOUS_BASE_SIZE && num_shared <= OBLIVIOUS_BASE_SIZE && num_cols <= OBLIVIOUS_BASE_SIZE) {
+        base_oblivious(A, B, C, i0, i1, k0, k1, j0, j1);
+        return;
+    }
+
+    if (num_rows >= num_shared && num_rows >= num_cols) {
+        size_t i_mid = middle_oblivious(i0, i1, 4);
+        multiply_oblivious(A, B, C, i0, i_mid, k0, k1, j0, j1);
+        multiply_oblivious(A, B, C, i_mid, i1, k0, k1, j0, j1);
+    } else if (num_cols >= num_shared) {
+        size_t j_mid = middle_oblivious(j0, j1, 8);
+        multiply_oblivious(A, B, C, i0, i1, k0, k1, j0, j_mid);
+        multiply_oblivious(A, B, C, i0, i1, k0, k1, j_mid, j1);
+    } else {
+        // Both halves of the shared dimension add to the same part of C
+        size_t k_mid = middle_oblivious(k0, k1, 4);
+        multiply_oblivious(A, B, C, i0, i1, k0, k_mid, j0, j1);
+        multiply_oblivious(A, B, C, i0, i1, k_mid, k1, j0, j1);
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_oblivious(). This function
+ * encapsulates the Matrix multiplication done by a single thread given
+ * the input Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding part of Matrix C.
+*/
+void thread_mult_oblivious(Task t) {
+
+    // Matrices: A x B = C (B is held in B_trans)
+    multiply_oblivious(t.A, t.B_trans, t.C, t.C_row_start, t.C_row_end,
+                       0, t.A->num_cols, t.C_col_start, t.C_col_end);
+}
+
+// Mutex lock used to access the Queue
+pthread_mutex_t queue_lock_oblivious;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a part of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_oblivious(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_oblivious) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_oblivious) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_oblivious(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_mult_oblivious(Matrix* A, Matrix* B, Matrix* C, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return -1;
+    }
+
+    if (NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create a Queue filled with the parts of C in Morton order
+    Queue* q = preprocessing_oblivious(A, B, C, NUM_THREADS);
+    if (!q) {
+        return -1;
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_oblivious, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_oblivious() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_oblivious, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_oblivious);
+
+    return result;
+}
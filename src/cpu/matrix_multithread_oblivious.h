@@ -0,0 +1,64 @@
+/**
+ * @file matrix_multithread_oblivious.h
+ *
+ * @brief Contains function prototypes for cache-oblivious Matrix
+ * multiplication utilizing the following for improved performance:
+ * - Multithreading
+ * - SIMD registers (FMA)
+ * - Recursive divide and conquer instead of a block size
+ *
+ * @details
+ * The blocked kernels (see matrix_singlethread.h) perform well only with
+ * a block size tuned to the cache sizes, and the best block size shifts
+ * with the dimension and the kernel. The cache-oblivious product needs
+ * no such parameter: the largest of the three dimensions n, m and p is
+ * halved recursively, so at some depth of the recursion the three
+ * sub-matrices fit in L1, at a higher depth in L2, and so on, whatever
+ * the sizes of the caches are. Splitting n or p gives two independent
+ * halves of C, splitting m gives two products added to the same part of
+ * C, one after the other.
+ *
+ * The recursion stops at OBLIVIOUS_BASE_SIZE, where the remaining
+ * product is done with micro-tiles of 4 rows x 8 columns of C in AVX
+ * registers (as in matrix_multithread_semiring.h, B is not transposed).
+ * The base size only amortizes the cost of the recursion and of loading
+ * and storing the micro-tiles of C (64 was measured to be faster than 32
+ * and 128 at dimensions 200 to 2000); the recursion above it adapts to
+ * the caches by itself.
+ *
+ * For the multithreading, the same recursion (splitting only n and p)
+ * divides C into OBLIVIOUS_TASKS_PER_THREAD Tasks per thread. The Tasks
+ * are added to the Queue in the order of the recursion, which is the
+ * Morton (Z) order of the parts of C, so Tasks handed out one after the
+ * other share rows of A or columns of B.
+ */
+
+#ifndef MATRIX_MULTITHREAD_OBLIVIOUS_H
+#define MATRIX_MULTITHREAD_OBLIVIOUS_H
+
+#include "../shared/matrix.h"
+
+// The recursion stops once all three dimensions are at most this size
+#define OBLIVIOUS_BASE_SIZE 64
+
+// The minimum number of Tasks per thread, for load balancing
+#define OBLIVIOUS_TASKS_PER_THREAD 4
+
+/**
+ * @brief Matrix multiply the two matrices A and B with the
+ * cache-oblivious recursion.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. The product is
+ * added to the values of C. All three matrices have to be row-major.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_oblivious(Matrix* A, Matrix* B, Matrix* C, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_OBLIVIOUS_H
@@ -0,0 +1,394 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include "matrix_multithread_semiring.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// The semiring of the current multiplication
+Semiring ring_semiring;
+
+/**
+ * @brief The scalar operations of the built-in semirings.
+*/
+double plus_semiring(double x, double y) { return x + y; }
+double times_semiring(double x, double y) { return x * y; }
+// Same operand order as _mm256_min_pd(x, y) / _mm256_max_pd(x, y): y if either is NaN
+double min_semiring(double x, double y) { return (x < y) ? x : y; }
+double max_semiring(double x, double y) { return (x > y) ? x : y; }
+double or_semiring(double x, double y) { return (x != 0.0 || y != 0.0) ? 1.0 : 0.0; }
+double and_semiring(double x, double y) { return (x != 0.0 && y != 0.0) ? 1.0 : 0.0; }
+
+Semiring semiring_get(SemiringType type) {
+
+    Semiring s = {0};
+    s.type = type;
+
+    switch (type) {
+        case SEMIRING_PLUS_TIMES:
+            s.add = plus_semiring;
+            s.multiply = times_semiring;
+            s.zero = 0.0;
+            s.one = 1.0;
+            break;
+        case SEMIRING_MIN_PLUS:
+            s.add = min_semiring;
+            s.multiply = plus_semiring;
+            s.zero = INFINITY;
+            s.one = 0.0;
+            break;
+        case SEMIRING_MAX_PLUS:
+            s.add = max_semiring;
+            s.multiply = plus_semiring;
+            s.zero = -INFINITY;
+            s.one = 0.0;
+            break;
+        case SEMIRING_MAX_TIMES:
+            s.add = max_semiring;
+            s.multiply = times_semiring;
+            s.zero = 0.0;
+            s.one = 1.0;
+            break;
+        case SEMIRING_OR_AND:
+            s.add = or_semiring;
+            s.multiply = and_semiring;
+            s.zero = 0.0;
+            s.one = 1.0;
+            break;
+        default:
+            // SEMIRING_CUSTOM, the caller sets the operations
+            break;
+    }
+
+    return s;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_mult_semiring(). It
+ * creates a Queue filled with a Task for each block of Matrix C.
+ *
+ * @param A Pointer to Matrix A (A x B = C).
+ * @param B Pointer to Matrix B.
+ * @param C Pointer to Matrix C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_semiring(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
+
+    size_t n = C->num_rows;
+    size_t p = C->num_cols;
+
+    // The number of blocks in each dimension of C (rounded up)
+    size_t num_row_blocks = (n + block_size - 1) / block_size;
+    size_t num_col_blocks = (p + block_size - 1) / block_size;
+
+    Queue* q = queue_create(num_row_blocks * num_col_blocks);
+    if (!q) {
+        return NULL;
+    }
+
+    // Turn each block in C into a Task (B is not transposed, it is held in B_trans)
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j < p; j += block_size) {
+            Task t = task_create(A, B, C, block_size, i, j, min(i + block_size, n), min(j + block_size, p));
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to thread_mult_semiring(). Updates a micro-tile
+ * of up to 4 rows and 8 columns of C with the columns k_start to k_end
+ * (exclusive) of A, using the AVX kernel of a built-in semiring.
+ *
+ * @param a Pointer to the first row of the micro-tile in A (column 0).
+ * @param b Pointer to the first column of the micro-tile in B (row 0).
+ * @param c Pointer to the top-left element of the micro-tile in C.
+ * @param num_rows The number of rows of the micro-tile (1-4).
+*/
+void tile_semiring(const double* a, size_t a_stride, const double* b, size_t b_stride,
+                   double* c, size_t c_stride, size_t num_rows, size_t k_start, size_t k_end) {
+
+    __m256d c_vec[4][2];
+    for (size_t r = 0; r < num_rows; r++) {
+        c_vec[r][0] = _mm256_loadu_pd(&c[r * c_stride]);
+        c_vec[r][1] = _mm256_loadu_pd(&c[r * c_stride + 4]);
+    }
+
+    switch (ring_semiring.type) {
+
+        case SEMIRING_PLUS_TIMES:
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+                __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+                for (size_t r = 0; r < num_rows; r++) {
+                    __m256d a_val = _mm256_broadcast_sd(&a[r * a_stride + kk]);
+                    c_vec[r][0] = _mm256_fmadd_pd(a_val, b_vals1, c_vec[r][0]);
+                    c_vec[r][1] = _mm256_fmadd_pd(a_val, b_vals2, c_vec[r][1]);
+                }
+            }
+            break;
+
+        case SEMIRING_MIN_PLUS:
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+                __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+                for (size_t r = 0; r < num_rows; r++) {
+                    __m256d a_val = _mm256_broadcast_sd(&a[r * a_stride + kk]);
+                    c_vec[r][0] = _mm256_min_pd(c_vec[r][0], _mm256_add_pd(a_val, b_vals1));
+                    c_vec[r][1] = _mm256_min_pd(c_vec[r][1], _mm256_add_pd(a_val, b_vals2));
+                }
+            }
+            break;
+
+        case SEMIRING_MAX_PLUS:
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+                __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+                for (size_t r = 0; r < num_rows; r++) {
+                    __m256d a_val = _mm256_broadcast_sd(&a[r * a_stride + kk]);
+                    c_vec[r][0] = _mm256_max_pd(c_vec[r][0], _mm256_add_pd(a_val, b_vals1));
+                    c_vec[r][1] = _mm256_max_pd(c_vec[r][1], _mm256_add_pd(a_val, b_vals2));
+                }
+            }
+            break;
+
+        case SEMIRING_MAX_TIMES:
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                __m256d b_vals1 = _mm256_loadu_pd(&b[kk * b_stride]);
+                __m256d b_vals2 = _mm256_loadu_pd(&b[kk * b_stride + 4]);
+                for (size_t r = 0; r < num_rows; r++) {
+                    __m256d a_val = _mm256_broadcast_sd(&a[r * a_stride + kk]);
+                    c_vec[r][0] = _mm256_max_pd(c_vec[r][0], _mm256_mul_pd(a_val, b_vals1));
+                    c_vec[r][1] = _mm256_max_pd(c_vec[r][1], _mm256_mul_pd(a_val, b_vals2));
+                }
+            }
+            break;
+
+        default: {
+            // SEMIRING_OR_AND: the accumulators hold the masks of the true elements
+            __m256d zero = _mm256_setzero_pd();
+            for (size_t r = 0; r < num_rows; r++) {
+                c_vec[r][0] = _mm256_cmp_pd(c_vec[r][0], zero, _CMP_NEQ_UQ);
+                c_vec[r][1] = _mm256_cmp_pd(c_vec[r][1], zero, _CMP_NEQ_UQ);
+            }
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                __m256d b_mask1 = _mm256_cmp_pd(_mm256_loadu_pd(&b[kk * b_stride]), zero, _CMP_NEQ_UQ);
+                __m256d b_mask2 = _mm256_cmp_pd(_mm256_loadu_pd(&b[kk * b_stride + 4]), zero, _CMP_NEQ_UQ);
+                for (size_t r = 0; r < num_rows; r++) {
+                    __m256d a_mask = _mm256_cmp_pd(_mm256_broadcast_sd(&a[r * a_stride + kk]), zero, _CMP_NEQ_UQ);
+                    c_vec[r][0] = _mm256_or_pd(c_vec[r][0], _mm256_and_pd(a_mask, b_mask1));
+                    c_vec[r][1] = _mm256_or_pd(c_vec[r][1], _mm256_and_pd(a_mask, b_mask2));
+                }
+            }
+            __m256d one = _mm256_set1_pd(1.0);
+            for (size_t r = 0; r < num_rows; r++) {
+                c_vec[r][0] = _mm256_and_pd(c_vec[r][0], one);
+                c_vec[r][1] = _mm256_and_pd(c_vec[r][1], one);
+            }
+            break;
+        }
+    }
+
+    for (size_t r = 0; r < num_rows; r++) {
+        _mm256_storeu_pd(&c[r * c_stride], c_vec[r][0]);
+        _mm256_storeu_pd(&c[r * c_stride + 4], c_vec[r][1]);
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_semiring(). This function
+ * encapsulates the Matrix multiplication done by a single thread given
+ * the input Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_semiring(Task t) {
+
+    // Matrices: A x B = C (B is held in B_trans)
+    Matrix* A = t.A;
+    Matrix* B = t.B_trans;
+    Matrix* C = t.C;
+
+    size_t m = A->num_cols;
+    size_t a_stride = A->stride;
+    size_t b_stride = B->stride;
+    size_t c_stride = C->stride;
+    size_t block_size = t.block_size;
+
+    double (*add)(double, double) = ring_semiring.add;
+    double (*multiply)(double, double) = ring_semiring.multiply;
+    bool vectorized = (ring_semiring.type != SEMIRING_CUSTOM);
+
+    // Loop goes through blocks in the shared dimension
+    for (size_t k = 0; k < m; k += block_size) {
+        size_t k_min = min(k + block_size, m);
+
+        for (size_t ii = t.C_row_start; ii < t.C_row_end; ii += 4) {
+            size_t num_rows = min(4, t.C_row_end - ii);
+            size_t jj = t.C_col_start;
+
+            // Micro-tiles of 8 columns in the AVX registers. The constant 4 for
+            // full tiles lets the compiler keep the accumulators in registers.
+            if (vectorized) {
+                for (; jj + 7 < t.C_col_end; jj += 8) {
+                    if (num_rows == 4) {
+                        tile_semiring(&A->values[ii * a_stride], a_stride, &B->values[jj], b_stride,
+                                      &C->values[ii * c_stride + jj], c_stride, 4, k, k_min);
+                    } else {
+                        tile_semiring(&A->values[ii * a_stride], a_stride, &B->values[jj], b_stride,
+                                      &C->values[ii * c_stride + jj], c_stride, num_rows, k, k_min);
+                    }
+                }
+            }
+
+            // Handle residual columns (and custom semirings) with the scalar operations
+            for (size_t r = ii; r < ii + num_rows; r++) {
+                for (size_t j = jj; j < t.C_col_end; j++) {
+                    double c_value = C->values[r * c_stride + j];
+                    for (size_t kk = k; kk < k_min; kk++) {
+                        c_value = add(c_value, multiply(A->values[r * a_stride + kk], B->values[kk * b_stride + j]));
+                    }
+                    C->values[r * c_stride + j] = c_value;
+                }
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_semiring;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_semiring(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_semiring) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_semiring) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_semiring(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_mult_semiring(Matrix* A, Matrix* B, Matrix* C, Semiring semiring,
+                                     size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return -1;
+    }
+
+    if (semiring.type > SEMIRING_CUSTOM || !semiring.add || !semiring.multiply) {
+        errno = EINVAL;
+        perror("Error: The semiring is unknown or misses its operations");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create a Queue filled with all the tasks / blocks to calculate in C
+    Queue* q = preprocessing_semiring(A, B, C, block_size);
+    if (!q) {
+        return -1;
+    }
+    ring_semiring = semiring;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_semiring, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_semiring() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_semiring, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_semiring);
+
+    return result;
+}
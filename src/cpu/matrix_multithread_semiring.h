@@ -0,0 +1,104 @@
+/**
+ * @file matrix_multithread_semiring.h
+ *
+ * @brief Contains function prototypes for Matrix multiplication over a
+ * semiring: C[i][j] = C[i][j] (+) (A[i][0] (x) B[0][j]) (+) ... with
+ * the addition (+) and multiplication (x) of the semiring, utilizing the
+ * following for improved performance:
+ * - Multithreading
+ * - SIMD registers (for the built-in semirings)
+ * - Blocking / tiling method
+ *
+ * @details
+ * The built-in semirings are:
+ * - SEMIRING_PLUS_TIMES: (+, *) with zero 0, the usual product.
+ * - SEMIRING_MIN_PLUS: (min, +) with zero +inf, the tropical semiring
+ *   of shortest paths.
+ * - SEMIRING_MAX_PLUS: (max, +) with zero -inf, longest paths.
+ * - SEMIRING_MAX_TIMES: (max, *) with zero 0, most reliable paths
+ *   (meant for non-negative values).
+ * - SEMIRING_OR_AND: (or, and) with zero 0, reachability. Any nonzero
+ *   value is true, the result elements are 1.0 or 0.0.
+ * A SEMIRING_CUSTOM semiring uses the add and multiply function pointers
+ * in a scalar loop instead.
+ *
+ * As in matrix_multithread_9avx.h, a single Queue hands out Tasks
+ * corresponding to blocks of C, and the shared dimension is blocked
+ * with the same block size. B is not transposed: within a Task, a
+ * micro-tile of 4 rows x 8 columns of C stays in AVX registers while
+ * each element of A is broadcast and combined with 8 contiguous
+ * elements of a row of B (_mm256_min_pd / _mm256_add_pd for min-plus,
+ * _mm256_max_pd / _mm256_mul_pd for max-times, and so on). The kernels
+ * are branch-free: skipping the elements of A equal to the zero of the
+ * semiring was measured to be slower once they are mixed with other
+ * values, due to the mispredicted branches. The min and max of the
+ * residual columns match _mm256_min_pd / _mm256_max_pd: a NaN product
+ * replaces the accumulated value, and a later product replaces a NaN.
+ *
+ * Repeated squaring gives all-pairs shortest paths: with D holding the
+ * edge weights, +inf for missing edges and 0 on the diagonal, setting C
+ * to D and multiplying D * D into C ceil(log2(n - 1)) times (D = C
+ * after every step) leaves the shortest distances in C.
+ */
+
+#ifndef MATRIX_MULTITHREAD_SEMIRING_H
+#define MATRIX_MULTITHREAD_SEMIRING_H
+
+#include "../shared/matrix.h"
+
+// The (add, multiply) pairs with a specialized kernel
+typedef enum {
+    SEMIRING_PLUS_TIMES = 0, // = 0 to be able to loop through enums
+    SEMIRING_MIN_PLUS,
+    SEMIRING_MAX_PLUS,
+    SEMIRING_MAX_TIMES,
+    SEMIRING_OR_AND,
+    SEMIRING_CUSTOM
+} SemiringType;
+
+typedef struct {
+
+    // Selects the kernel, SEMIRING_CUSTOM uses the function pointers
+    SemiringType type;
+
+    // The operations of the semiring (set for the built-in semirings too)
+    double (*add)(double x, double y);
+    double (*multiply)(double x, double y);
+
+    // The identities of add (zero) and multiply (one)
+    double zero;
+    double one;
+
+} Semiring;
+
+/**
+ * @brief Retrieve a built-in semiring.
+ *
+ * @param type The semiring (not SEMIRING_CUSTOM).
+ * @return The Semiring passed as value. For SEMIRING_CUSTOM, the
+ * function pointers are NULL and have to be set by the caller.
+*/
+Semiring semiring_get(SemiringType type);
+
+/**
+ * @brief Matrix multiply the two matrices A and B over the semiring.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller. As for the double
+ * kernels, the product is added (with the add of the semiring) to the
+ * values of C, so fill C with semiring.zero for the plain product. All
+ * three matrices have to be row-major.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param semiring The semiring to multiply over.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_semiring(Matrix* A, Matrix* B, Matrix* C, Semiring semiring,
+                                     size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_SEMIRING_H
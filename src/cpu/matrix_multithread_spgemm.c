@@ -0,0 +1,553 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "matrix_multithread_spgemm.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+
+// The operands of the current multiplication (Task only holds dense matrices)
+MatrixCSR* A_spgemm = NULL;
+MatrixCSR* B_spgemm = NULL;
+MatrixCSR* C_spgemm = NULL;
+SpgemmAccumulator accumulator_spgemm = SPGEMM_ACCUMULATOR_HASH;
+
+// The work of rows 0..i-1 at index i (num_rows + 1 elements)
+size_t* row_work_spgemm = NULL;
+// The largest number of multiply-adds of a single row
+size_t max_row_work_spgemm = 0;
+
+// Symbolic phase output: the number of nonzeros of row i of C at index i + 1
+size_t* row_ptr_spgemm = NULL;
+bool numeric_phase_spgemm = false;
+
+// The number of bits needed for a column of C
+size_t column_bits_spgemm = 0;
+
+// Set by a thread whose accumulator or Queue lock failed (the threads write it concurrently)
+_Atomic bool failed_spgemm = false;
+
+// The accumulator of a thread, reused for all of its rows
+typedef struct {
+
+    // Hash accumulator (keys of SIZE_MAX are empty slots)
+    size_t* keys;
+    double* hash_values;
+
+    // Dense accumulator (markers[col] == row + 1 if col is in the current row)
+    double* dense_values;
+    size_t* markers;
+
+    // The distinct columns of the current row, in the order of appearance
+    size_t* columns;
+    size_t* sort_buffer;
+
+} SpgemmWorkspace;
+
+/**
+ * @brief Helper function to find the first row whose work starts at or
+ * after the given position.
+ *
+ * @param num_rows The number of rows.
+ * @param position The position in the total work.
+ * @return The row (0 to num_rows).
+*/
+size_t row_lower_bound_spgemm(size_t num_rows, size_t position) {
+
+    size_t low = 0;
+    size_t high = num_rows;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (row_work_spgemm[middle] < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_spgemm(). It creates a
+ * Queue filled with a Task for each range of rows, such that the ranges
+ * hold (about) the same work.
+ *
+ * @param num_rows The number of rows of C.
+ * @param num_parts The number of ranges to aim for.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_spgemm(size_t num_rows, size_t num_parts) {
+
+    Queue* q = queue_create(num_parts);
+    if (!q) {
+        return NULL;
+    }
+
+    size_t total_work = row_work_spgemm[num_rows];
+    size_t row_start = 0;
+    for (size_t part = 1; part <= num_parts && row_start < num_rows; part++) {
+
+        // The last range takes the remaining rows
+        size_t row_end = (part == num_parts) ? num_rows
+                         : row_lower_bound_spgemm(num_rows, total_work * part / num_parts);
+        if (row_end <= row_start) {
+            continue;
+        }
+
+        Task t = {0};
+        t.C_row_start = row_start;
+        t.C_row_end = row_end;
+        t.is_valid = true;
+        queue_add(q, t);
+
+        row_start = row_end;
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to sort the columns of a row of C.
+ * Short rows (the common case) use an insertion sort, longer rows an LSD
+ * radix sort on 8-bit digits over the bits needed for the columns of C.
+ *
+ * @param columns The columns.
+ * @param buffer Scratch space of at least count elements.
+ * @param count The number of columns.
+*/
+void sort_columns_spgemm(size_t* columns, size_t* buffer, size_t count) {
+
+    if (count <= 32) {
+        for (size_t i = 1; i < count; i++) {
+            size_t column = columns[i];
+            size_t j = i;
+            for (; j > 0 && columns[j - 1] > column; j--) {
+                columns[j] = columns[j - 1];
+            }
+            columns[j] = column;
+        }
+        return;
+    }
+
+    size_t* from = columns;
+    size_t* to = buffer;
+    for (size_t shift = 0; shift < column_bits_spgemm; shift += 8) {
+
+        // Counting sort on the digit, stable
+        size_t offsets[256] = {0};
+        for (size_t i = 0; i < count; i++) {
+            offsets[(from[i] >> shift) & 0xFF]++;
+        }
+        size_t total = 0;
+        for (size_t digit = 0; digit < 256; digit++) {
+            size_t digit_count = offsets[digit];
+            offsets[digit] = total;
+            total += digit_count;
+        }
+        for (size_t i = 0; i < count; i++) {
+            to[offsets[(from[i] >> shift) & 0xFF]++] = from[i];
+        }
+
+        size_t* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    // An odd number of passes leaves the result in the buffer
+    if (from != columns) {
+        memcpy(columns, from, sizeof(size_t) * count);
+    }
+}
+
+/**
+ * @brief Helper function to size the hash table of a row: the smallest
+ * power of two of at least twice the possible distinct columns.
+ *
+ * @param row The row of C.
+ * @param bits Output, the base-2 logarithm of the size.
+ * @return The size of the hash table of the row.
+*/
+size_t hash_capacity_spgemm(size_t row, size_t* bits) {
+
+    size_t work = row_work_spgemm[row + 1] - row_work_spgemm[row] - 1;
+    size_t distinct = min(work, B_spgemm->num_cols);
+    size_t capacity = 8;
+    *bits = 3;
+    while (capacity < 2 * distinct) {
+        capacity *= 2;
+        (*bits)++;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Helper function to find the slot of a column in the hash table,
+ * which is either the slot holding the column or the empty slot to
+ * insert it in (multiplicative hashing with linear probing).
+*/
+size_t hash_slot_spgemm(const size_t* keys, size_t column, size_t capacity, size_t bits) {
+
+    size_t slot = (size_t)(((uint64_t)column * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+    while (keys[slot] != column && keys[slot] != SIZE_MAX) {
+        slot = (slot + 1) & (capacity - 1);
+    }
+    return slot;
+}
+
+/**
+ * @brief Helper function to thread_mult_spgemm(). Collects the distinct
+ * columns of row i of C in w->columns and, in the numeric phase, their
+ * values in the accumulator.
+ *
+ * @return The number of distinct columns.
+*/
+size_t accumulate_row_spgemm(size_t i, SpgemmWorkspace* w, size_t capacity, size_t bits) {
+
+    const MatrixCSR* A = A_spgemm;
+    const MatrixCSR* B = B_spgemm;
+    bool numeric = numeric_phase_spgemm;
+    size_t count = 0;
+
+    if (accumulator_spgemm == SPGEMM_ACCUMULATOR_HASH) {
+
+        // Only the slots of this row's table size are used
+        memset(w->keys, 0xFF, sizeof(size_t) * capacity);
+
+        for (size_t a_nz = A->row_ptr[i]; a_nz < A->row_ptr[i + 1]; a_nz++) {
+            size_t k = A->col_indices[a_nz];
+            double a_value = A->values[a_nz];
+            for (size_t b_nz = B->row_ptr[k]; b_nz < B->row_ptr[k + 1]; b_nz++) {
+                size_t column = B->col_indices[b_nz];
+                size_t slot = hash_slot_spgemm(w->keys, column, capacity, bits);
+                if (w->keys[slot] == SIZE_MAX) {
+                    w->keys[slot] = column;
+                    w->columns[count++] = column;
+                    if (numeric) {
+                        w->hash_values[slot] = a_value * B->values[b_nz];
+                    }
+                } else if (numeric) {
+                    w->hash_values[slot] += a_value * B->values[b_nz];
+                }
+            }
+        }
+
+    } else {
+
+        size_t marker = i + 1;
+        for (size_t a_nz = A->row_ptr[i]; a_nz < A->row_ptr[i + 1]; a_nz++) {
+            size_t k = A->col_indices[a_nz];
+            double a_value = A->values[a_nz];
+            for (size_t b_nz = B->row_ptr[k]; b_nz < B->row_ptr[k + 1]; b_nz++) {
+                size_t column = B->col_indices[b_nz];
+                if (w->markers[column] != marker) {
+                    w->markers[column] = marker;
+                    w->columns[count++] = column;
+                    if (numeric) {
+                        w->dense_values[column] = a_value * B->values[b_nz];
+                    }
+                } else if (numeric) {
+                    w->dense_values[column] += a_value * B->values[b_nz];
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Helper function to process_tasks_spgemm(). Performs the current
+ * phase for the rows of Matrix C described by Task t.
+ *
+ * @param t The Task passed as value that contains the range of rows.
+ * @param w The accumulator of the thread.
+*/
+void thread_mult_spgemm(Task t, SpgemmWorkspace* w) {
+
+    for (size_t i = t.C_row_start; i < t.C_row_end; i++) {
+
+        size_t bits = 0;
+        size_t capacity = 0;
+        if (accumulator_spgemm == SPGEMM_ACCUMULATOR_HASH) {
+            capacity = hash_capacity_spgemm(i, &bits);
+        }
+
+        size_t count = accumulate_row_spgemm(i, w, capacity, bits);
+
+        if (!numeric_phase_spgemm) {
+            row_ptr_spgemm[i + 1] = count;
+            continue;
+        }
+
+        // Write the row sorted by column. A dense accumulator filled to more
+        // than 1/16 is scanned in column order instead of sorting its columns.
+        size_t p = C_spgemm->num_cols;
+        if (accumulator_spgemm == SPGEMM_ACCUMULATOR_DENSE && count > p / 16) {
+            count = 0;
+            for (size_t column = 0; column < p; column++) {
+                if (w->markers[column] == i + 1) {
+                    w->columns[count++] = column;
+                }
+            }
+        } else {
+            sort_columns_spgemm(w->columns, w->sort_buffer, count);
+        }
+        size_t start = C_spgemm->row_ptr[i];
+        for (size_t index = 0; index < count; index++) {
+            size_t column = w->columns[index];
+            C_spgemm->col_indices[start + index] = column;
+            if (accumulator_spgemm == SPGEMM_ACCUMULATOR_HASH) {
+                C_spgemm->values[start + index] = w->hash_values[hash_slot_spgemm(w->keys, column, capacity, bits)];
+            } else {
+                C_spgemm->values[start + index] = w->dense_values[column];
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_spgemm;
+
+/**
+ * @brief Function used by the threads. A thread allocates its
+ * accumulator, then accesses the Queue and retrieves Task objects that
+ * describe a range of rows of Matrix C until the Queue is empty.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror and set failed_spgemm.
+*/
+void* process_tasks_spgemm(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Allocate the accumulator (a row has at most min(work, num_cols) distinct columns)
+    SpgemmWorkspace w = {0};
+    size_t max_distinct = min(max_row_work_spgemm, B_spgemm->num_cols);
+    w.columns = (size_t*)malloc(sizeof(size_t) * (max_distinct + 1));
+    w.sort_buffer = (size_t*)malloc(sizeof(size_t) * (max_distinct + 1));
+    bool allocated = w.columns && w.sort_buffer;
+    if (accumulator_spgemm == SPGEMM_ACCUMULATOR_HASH) {
+        size_t bits = 3;
+        size_t capacity = 8;
+        while (capacity < 2 * max_distinct) {
+            capacity *= 2;
+            bits++;
+        }
+        w.keys = (size_t*)malloc(sizeof(size_t) * capacity);
+        w.hash_values = (double*)malloc(sizeof(double) * capacity);
+        allocated = allocated && w.keys && w.hash_values;
+    } else {
+        w.dense_values = (double*)malloc(sizeof(double) * B_spgemm->num_cols);
+        w.markers = (size_t*)calloc(B_spgemm->num_cols, sizeof(size_t));
+        allocated = allocated && w.dense_values && w.markers;
+    }
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (allocated) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_spgemm) != 0) {
+            perror("Error: Mutex lock failed");
+            failed_spgemm = true;
+            break;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_spgemm) != 0) {
+            perror("Error: Mutex unlock failed");
+            failed_spgemm = true;
+            break;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform the phase on the rows of the Task
+            thread_mult_spgemm(t, &w);
+        }
+    }
+
+    if (!allocated) {
+        perror("Error: Allocation of the accumulator failed");
+        failed_spgemm = true;
+    }
+
+    // Free allocated memory
+    free(w.columns);
+    free(w.sort_buffer);
+    free(w.keys);
+    free(w.hash_values);
+    free(w.dense_values);
+    free(w.markers);
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_spgemm(). Runs the
+ * current phase on all rows with NUM_THREADS threads.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int run_phase_spgemm(size_t num_rows, size_t NUM_THREADS) {
+
+    // Create a Queue filled with the row ranges of (about) equal work
+    Queue* q = preprocessing_spgemm(num_rows, min(num_rows, NUM_THREADS * SPGEMM_PARTS_PER_THREAD));
+    if (!q) {
+        return -1;
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_spgemm, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_spgemm() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_spgemm, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_spgemm);
+
+    if (failed_spgemm) {
+        result = -1;
+    }
+
+    return result;
+}
+
+MatrixCSR* matrix_multithread_spgemm(MatrixCSR* A, MatrixCSR* B, SpgemmAccumulator accumulator, size_t NUM_THREADS) {
+
+    if (!A || !B) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A or Matrix B");
+        return NULL;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return NULL;
+    }
+
+    if (accumulator >= SPGEMM_NUM_ACCUMULATORS) {
+        errno = EINVAL;
+        perror("Error: Unknown accumulator");
+        return NULL;
+    }
+
+    if (NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: The number of threads cannot be of value 0");
+        return NULL;
+    }
+
+    size_t n = A->num_rows;
+    row_work_spgemm = (size_t*)malloc(sizeof(size_t) * (n + 1));
+    row_ptr_spgemm = (size_t*)calloc(n + 1, sizeof(size_t));
+    if (!row_work_spgemm || !row_ptr_spgemm) {
+        perror("Error: Allocation of the row arrays failed");
+        free(row_work_spgemm);
+        free(row_ptr_spgemm);
+        return NULL;
+    }
+
+    // The work of a row is its multiply-adds plus one (so empty rows are not free)
+    row_work_spgemm[0] = 0;
+    max_row_work_spgemm = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t work = 0;
+        for (size_t a_nz = A->row_ptr[i]; a_nz < A->row_ptr[i + 1]; a_nz++) {
+            size_t k = A->col_indices[a_nz];
+            work += B->row_ptr[k + 1] - B->row_ptr[k];
+        }
+        row_work_spgemm[i + 1] = row_work_spgemm[i] + work + 1;
+        if (work > max_row_work_spgemm) {
+            max_row_work_spgemm = work;
+        }
+    }
+
+    A_spgemm = A;
+    B_spgemm = B;
+    C_spgemm = NULL;
+    accumulator_spgemm = accumulator;
+    failed_spgemm = false;
+    column_bits_spgemm = 0;
+    while (column_bits_spgemm < 8 * sizeof(size_t) && (B->num_cols - 1) >> column_bits_spgemm) {
+        column_bits_spgemm++;
+    }
+
+    // Symbolic phase: the number of nonzeros per row of C
+    numeric_phase_spgemm = false;
+    int result = run_phase_spgemm(n, NUM_THREADS);
+
+    // Turn the counts into row pointers and allocate C with the exact size
+    if (result == 0) {
+        for (size_t i = 0; i < n; i++) {
+            row_ptr_spgemm[i + 1] += row_ptr_spgemm[i];
+        }
+        C_spgemm = matrix_csr_create(n, B->num_cols, row_ptr_spgemm[n]);
+        if (!C_spgemm) {
+            result = -1;
+        }
+    }
+
+    // Numeric phase: the values of C
+    if (result == 0) {
+        memcpy(C_spgemm->row_ptr, row_ptr_spgemm, sizeof(size_t) * (n + 1));
+        numeric_phase_spgemm = true;
+        result = run_phase_spgemm(n, NUM_THREADS);
+    }
+
+    MatrixCSR* C = C_spgemm;
+    if (result != 0 && C) {
+        matrix_csr_free(C);
+        C = NULL;
+    }
+
+    // Free allocated memory
+    free(row_work_spgemm);
+    free(row_ptr_spgemm);
+    row_work_spgemm = NULL;
+    row_ptr_spgemm = NULL;
+    A_spgemm = NULL;
+    B_spgemm = NULL;
+    C_spgemm = NULL;
+
+    return C;
+}
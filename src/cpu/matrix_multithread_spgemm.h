@@ -0,0 +1,59 @@
+/**
+ * @file matrix_multithread_spgemm.h
+ *
+ * @brief Contains function prototypes for the multiplication of two
+ * sparse CSR matrices (see matrix_csr.h) into a new CSR Matrix (SpGEMM)
+ * utilizing the following for improved performance:
+ * - Multithreading with rows partitioned by their number of operations
+ * - Per-thread hash or dense accumulators
+ *
+ * @details
+ * Row i of C merges the rows k of B for the nonzeros A[i][k] of row i of
+ * A, so the work of a row is its number of multiply-adds, the sum of the
+ * lengths of those rows of B. The rows are cut into
+ * SPGEMM_PARTS_PER_THREAD * NUM_THREADS contiguous ranges of (about) the
+ * same work and handed out as Tasks through a Queue, in two phases:
+ * - Symbolic: count the distinct columns of each row of C, which sizes
+ *   the rows (row_ptr) and the arrays of C exactly.
+ * - Numeric: accumulate the values of each row and write them, sorted by
+ *   column, to their place in C.
+ *
+ * Each thread allocates its accumulator once and reuses it for its rows:
+ * - SPGEMM_ACCUMULATOR_HASH: an open-addressing hash table sized by the
+ *   largest row work, cheap for any number of columns of C.
+ * - SPGEMM_ACCUMULATOR_DENSE: a sparse accumulator (SPA), a dense row of
+ *   num_cols values with markers, which avoids hashing but costs
+ *   O(num_cols) memory per thread.
+ *
+ * Entries of C that cancel to zero are kept as explicit zeros.
+ */
+
+#ifndef MATRIX_MULTITHREAD_SPGEMM_H
+#define MATRIX_MULTITHREAD_SPGEMM_H
+
+#include "../shared/matrix_csr.h"
+
+// The number of row ranges per thread
+#define SPGEMM_PARTS_PER_THREAD 4
+
+// The accumulator used per row of C
+typedef enum {
+    SPGEMM_ACCUMULATOR_HASH = 0, // = 0 to be able to loop through enums
+    SPGEMM_ACCUMULATOR_DENSE,
+    SPGEMM_NUM_ACCUMULATORS
+} SpgemmAccumulator;
+
+/**
+ * @brief Matrix multiply the sparse matrices A and B into a new sparse
+ * Matrix.
+ *
+ * @param A Pointer to the input MatrixCSR (dimensions n x m).
+ * @param B Pointer to the input MatrixCSR (dimensions m x p).
+ * @param accumulator The accumulator used by the threads.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A pointer to the new MatrixCSR C = A * B (dimensions n x p),
+ * or NULL if an error occured.
+*/
+MatrixCSR* matrix_multithread_spgemm(MatrixCSR* A, MatrixCSR* B, SpgemmAccumulator accumulator, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_SPGEMM_H
@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_spmm.h"
+#include "../shared/queue.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// The sparse operand of the current multiplication (Task only holds dense matrices)
+MatrixCSR* A_spmm = NULL;
+
+/**
+ * @brief Helper function to find the first row whose nonzeros start at
+ * or after the given position.
+ *
+ * @param A Pointer to the sparse Matrix.
+ * @param position The position in the nonzeros (0 to nnz).
+ * @return The row (0 to num_rows).
+*/
+size_t row_lower_bound_spmm(MatrixCSR* A, size_t position) {
+
+    size_t low = 0;
+    size_t high = A->num_rows;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (A->row_ptr[middle] < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_spmm(). It creates a
+ * Queue filled with a Task for each range of rows, such that the ranges
+ * hold (about) the same number of nonzeros.
+ *
+ * @param A Pointer to the sparse Matrix A.
+ * @param B Pointer to Matrix B.
+ * @param C Pointer to Matrix C.
+ * @param num_parts The number of ranges to aim for.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_spmm(MatrixCSR* A, Matrix* B, Matrix* C, size_t num_parts) {
+
+    Queue* q = queue_create(num_parts);
+    if (!q) {
+        return NULL;
+    }
+
+    size_t row_start = 0;
+    for (size_t part = 1; part <= num_parts && row_start < A->num_rows; part++) {
+
+        // The last range takes the remaining rows
+        size_t row_end = (part == num_parts) ? A->num_rows
+                         : row_lower_bound_spmm(A, A->nnz * part / num_parts);
+        if (row_end <= row_start) {
+            continue;
+        }
+
+        Task t = {0};
+        t.B_trans = B;
+        t.C = C;
+        t.C_row_start = row_start;
+        t.C_row_end = row_end;
+        t.C_col_start = 0;
+        t.C_col_end = C->num_cols;
+        t.is_valid = true;
+        queue_add(q, t);
+
+        row_start = row_end;
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to process_tasks_spmm(). Computes the rows of
+ * Matrix C described by Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding rows in Matrix C.
+*/
+void thread_mult_spmm(Task t) {
+
+    // t.B_trans holds B (not transposed)
+    Matrix* B = t.B_trans;
+    Matrix* C = t.C;
+    size_t p = C->num_cols;
+    size_t b_stride = B->stride;
+    const size_t* row_ptr = A_spmm->row_ptr;
+    const size_t* col_indices = A_spmm->col_indices;
+    const double* A_values = A_spmm->values;
+
+    for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+
+        size_t nz_start = row_ptr[ii];
+        size_t nz_end = row_ptr[ii + 1];
+        double* c_row = &C->values[ii * C->stride];
+        size_t jj = 0;
+
+        // 16 columns of C stay in registers over all nonzeros of the row
+        for (; jj + 15 < p; jj += 16) {
+            __m256d c_vec1 = _mm256_loadu_pd(&c_row[jj]);
+            __m256d c_vec2 = _mm256_loadu_pd(&c_row[jj + 4]);
+            __m256d c_vec3 = _mm256_loadu_pd(&c_row[jj + 8]);
+            __m256d c_vec4 = _mm256_loadu_pd(&c_row[jj + 12]);
+            for (size_t nz = nz_start; nz < nz_end; nz++) {
+                __m256d a_val = _mm256_broadcast_sd(&A_values[nz]);
+                const double* b_row = &B->values[col_indices[nz] * b_stride + jj];
+                c_vec1 = _mm256_fmadd_pd(a_val, _mm256_loadu_pd(&b_row[0]), c_vec1);
+                c_vec2 = _mm256_fmadd_pd(a_val, _mm256_loadu_pd(&b_row[4]), c_vec2);
+                c_vec3 = _mm256_fmadd_pd(a_val, _mm256_loadu_pd(&b_row[8]), c_vec3);
+                c_vec4 = _mm256_fmadd_pd(a_val, _mm256_loadu_pd(&b_row[12]), c_vec4);
+            }
+            _mm256_storeu_pd(&c_row[jj], c_vec1);
+            _mm256_storeu_pd(&c_row[jj + 4], c_vec2);
+            _mm256_storeu_pd(&c_row[jj + 8], c_vec3);
+            _mm256_storeu_pd(&c_row[jj + 12], c_vec4);
+        }
+
+        // Remaining columns, 4 at a time
+        for (; jj + 3 < p; jj += 4) {
+            __m256d c_vec = _mm256_loadu_pd(&c_row[jj]);
+            for (size_t nz = nz_start; nz < nz_end; nz++) {
+                __m256d a_val = _mm256_broadcast_sd(&A_values[nz]);
+                c_vec = _mm256_fmadd_pd(a_val, _mm256_loadu_pd(&B->values[col_indices[nz] * b_stride + jj]), c_vec);
+            }
+            _mm256_storeu_pd(&c_row[jj], c_vec);
+        }
+
+        // Handle residual columns not handled by the SIMD loops
+        for (; jj < p; jj++) {
+            double c_value = c_row[jj];
+            for (size_t nz = nz_start; nz < nz_end; nz++) {
+                c_value += A_values[nz] * B->values[col_indices[nz] * b_stride + jj];
+            }
+            c_row[jj] = c_value;
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_spmm;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a range of rows of Matrix C
+ * that needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_spmm(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_spmm) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_spmm) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_spmm(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_spmm(MatrixCSR* A, Matrix* B, Matrix* C, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices B and C have to be row-major");
+        return -1;
+    }
+
+    if (NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: The number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create a Queue filled with the row ranges of (about) equal nonzeros
+    Queue* q = preprocessing_spmm(A, B, C, min(A->num_rows, NUM_THREADS * SPMM_PARTS_PER_THREAD));
+    if (!q) {
+        return -1;
+    }
+    A_spmm = A;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_spmm, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_spmm() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_spmm, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    A_spmm = NULL;
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_spmm);
+
+    return result;
+}
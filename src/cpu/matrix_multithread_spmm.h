@@ -0,0 +1,50 @@
+/**
+ * @file matrix_multithread_spmm.h
+ *
+ * @brief Contains function prototypes for the multiplication of a sparse
+ * CSR Matrix (see matrix_csr.h) with a dense Matrix (SpMM) utilizing the
+ * following for improved performance:
+ * - Multithreading with rows partitioned by their number of nonzeros
+ * - SIMD registers across the columns of B and C
+ *
+ * @details
+ * Row i of C is the sum of A[i][k] * (row k of B) over the nonzeros of
+ * row i of A. The kernel keeps 16 columns of row i of C in four AVX
+ * registers while it goes through the nonzeros of the row, broadcasting
+ * each A[i][k] and streaming the same 16 columns of row k of B. The
+ * remaining columns are handled 4 and then 1 at a time.
+ *
+ * The work of a row is proportional to its number of nonzeros, not to
+ * the number of rows. The rows are therefore cut into
+ * SPMM_PARTS_PER_THREAD * NUM_THREADS contiguous ranges of (about) the
+ * same number of nonzeros, found by binary search in row_ptr. Each range
+ * becomes a Task handed out through a Queue, so a thread that gets a
+ * range with a single heavy row does not hold up the others.
+ */
+
+#ifndef MATRIX_MULTITHREAD_SPMM_H
+#define MATRIX_MULTITHREAD_SPMM_H
+
+#include "../shared/matrix.h"
+#include "../shared/matrix_csr.h"
+
+// The number of row ranges per thread
+#define SPMM_PARTS_PER_THREAD 4
+
+/**
+ * @brief Matrix multiply the sparse Matrix A with the dense Matrix B.
+ *
+ * @note Matrix C must be pre-allocated by the caller. As for the double
+ * kernels, the product is added to the values of C. B and C have to be
+ * row-major.
+ *
+ * @param A Pointer to the sparse input Matrix (dimensions n x m).
+ * @param B Pointer to the dense input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_spmm(MatrixCSR* A, Matrix* B, Matrix* C, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_SPMM_H
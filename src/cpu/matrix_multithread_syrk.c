@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_syrk.h"
+#include "../shared/queue.h"
+#include "../shared/task.h"
+#include "../shared/matrix_utils.h"
+// For SIMD
+#include <immintrin.h>
+
+// true if the Tasks mirror their block into the upper triangle
+bool mirror_syrk = false;
+
+/**
+ * @brief Helper function for matrix_multithread_syrk(). It creates a
+ * Queue filled with a Task for each block of Matrix C on and below the
+ * diagonal. A is passed as both A and B transposed.
+ *
+ * @param A Pointer to Matrix A.
+ * @param C Pointer to Matrix C.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_syrk(Matrix* A, Matrix* C, size_t block_size) {
+
+    size_t n = A->num_rows;
+
+    // The number of blocks on and below the diagonal
+    size_t num_blocks = (n + block_size - 1) / block_size;
+    Queue* q = queue_create(num_blocks * (num_blocks + 1) / 2);
+    if (!q) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; i += block_size) {
+        for (size_t j = 0; j <= i; j += block_size) {
+            queue_add(q, task_create(A, A, C, block_size, i, j,
+                                     min(i + block_size, n), min(j + block_size, n)));
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to process_tasks_syrk(). Computes the elements
+ * of the block of Matrix C described by Task t that lie on or below the
+ * diagonal, and mirrors them if requested.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding block in Matrix C.
+*/
+void thread_mult_syrk(Task t) {
+
+    Matrix* A = t.A;
+    Matrix* C = t.C;
+
+    size_t m = A->num_cols;
+    size_t a_stride = A->stride;
+    size_t c_stride = C->stride;
+    double* A_arr = A->values;
+    double* C_arr = C->values;
+
+    // Loop goes through blocks in the shared dimension
+    for (size_t k = 0; k < m; k += t.block_size) {
+        size_t k_min = min(k + t.block_size, m);
+
+        for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+
+            size_t a_row_offset = ii * a_stride;
+            // Only j <= i within a diagonal block
+            size_t col_end = min(t.C_col_end, ii + 1);
+
+            for (size_t jj = t.C_col_start; jj < col_end; jj++) {
+
+                // Row jj of A plays the role of row jj of B transposed
+                size_t kk = k;
+                size_t c_index = ii * c_stride + jj;
+                size_t b_row_offset = jj * a_stride;
+                double c_value = C_arr[c_index];
+
+                __m256d c_vec1 = _mm256_setzero_pd();
+                __m256d c_vec2 = _mm256_setzero_pd();
+                __m256d c_vec3 = _mm256_setzero_pd();
+
+                for (; kk + 11 < k_min; kk += 12) {
+                    c_vec1 = _mm256_fmadd_pd(_mm256_loadu_pd(&A_arr[a_row_offset + kk]),
+                                             _mm256_loadu_pd(&A_arr[b_row_offset + kk]), c_vec1);
+                    c_vec2 = _mm256_fmadd_pd(_mm256_loadu_pd(&A_arr[a_row_offset + kk + 4]),
+                                             _mm256_loadu_pd(&A_arr[b_row_offset + kk + 4]), c_vec2);
+                    c_vec3 = _mm256_fmadd_pd(_mm256_loadu_pd(&A_arr[a_row_offset + kk + 8]),
+                                             _mm256_loadu_pd(&A_arr[b_row_offset + kk + 8]), c_vec3);
+                }
+
+                // Unwrap the c_vecs and sum up the elements in the vector
+                double temp[4];
+                _mm256_storeu_pd(temp, _mm256_add_pd(_mm256_add_pd(c_vec1, c_vec2), c_vec3));
+                c_value += temp[0] + temp[1] + temp[2] + temp[3];
+
+                // Handle residual operations not handled by the SIMD loop
+                for (; kk < k_min; kk++) {
+                    c_value += A_arr[a_row_offset + kk] * A_arr[b_row_offset + kk];
+                }
+
+                // Write back to memory
+                C_arr[c_index] = c_value;
+            }
+        }
+    }
+
+    // Copy the finished block to the strict upper triangle
+    if (mirror_syrk) {
+        for (size_t ii = t.C_row_start; ii < t.C_row_end; ii++) {
+            size_t col_end = min(t.C_col_end, ii);
+            for (size_t jj = t.C_col_start; jj < col_end; jj++) {
+                C_arr[jj * c_stride + ii] = C_arr[ii * c_stride + jj];
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_syrk;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_syrk(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_syrk) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_syrk) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_syrk(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_syrk(Matrix* A, Matrix* C, bool mirror, size_t block_size, size_t NUM_THREADS) {
+
+    if (!A || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A or Matrix C");
+        return -1;
+    }
+
+    if (C->num_rows != A->num_rows || C->num_cols != A->num_rows) {
+        errno = EINVAL;
+        perror("Error: Matrix C has to be n x n for A of n rows");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A and C have to be row-major");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create a Queue filled with all the tasks / blocks to calculate in C
+    Queue* q = preprocessing_syrk(A, C, block_size);
+    if (!q) {
+        return -1;
+    }
+    mirror_syrk = mirror;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_syrk, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_syrk() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_syrk, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_syrk);
+
+    return result;
+}
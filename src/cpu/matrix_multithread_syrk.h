@@ -0,0 +1,48 @@
+/**
+ * @file matrix_multithread_syrk.h
+ *
+ * @brief Contains function prototypes for the symmetric rank-k update
+ * C += A * A^T (SYRK) utilizing the following for improved performance:
+ * - Multithreading
+ * - SIMD registers
+ * - Blocking / tiling method
+ *
+ * @details
+ * Element (i, j) of A * A^T is the dot product of the rows i and j of A.
+ * The kernel of matrix_multithread_9avx.h computes exactly these dot
+ * products on A and B transposed, so A serves as both operands and no
+ * transpose is materialized.
+ *
+ * Since the product is symmetric, Tasks are only created for the blocks
+ * of C on and below the diagonal, and within a diagonal block only the
+ * elements with j <= i are computed. This halves the floating-point
+ * operations compared to a full multiplication. The strict upper
+ * triangle of C is left untouched unless mirroring is requested, in
+ * which case each Task copies its finished block to the transposed
+ * position (these blocks are not owned by any other Task).
+ */
+
+#ifndef MATRIX_MULTITHREAD_SYRK_H
+#define MATRIX_MULTITHREAD_SYRK_H
+
+#include <stdbool.h>
+#include "../shared/matrix.h"
+
+/**
+ * @brief Add A * A^T to the lower triangle (including the diagonal) of C.
+ *
+ * @note Matrix C must be pre-allocated by the caller. As for the double
+ * kernels, the product is added to the values of C. Both matrices have
+ * to be row-major.
+ *
+ * @param A Pointer to the input Matrix (dimensions n x m).
+ * @param C Pointer to the output Matrix (dimensions n x n).
+ * @param mirror true to also write the strict upper triangle (mirrored
+ * from the lower triangle), false to leave it untouched.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_syrk(Matrix* A, Matrix* C, bool mirror, size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_SYRK_H
@@ -0,0 +1,232 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_tile.h"
+#include "../shared/matrix_tile.h"
+#include "../shared/queue.h"
+// For SIMD
+#include <immintrin.h>
+
+/**
+ * @brief Helper function for matrix_multithread_mult_tile(). It creates
+ * a Queue filled with a Task for each tile of Matrix C.
+ *
+ * @param A Pointer to Matrix A (A x B = C).
+ * @param B Pointer to Matrix B.
+ * @param C Pointer to Matrix C.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_tile(Matrix* A, Matrix* B, Matrix* C) {
+
+    size_t T = C->tile_size;
+    size_t num_tile_rows = (C->num_rows + T - 1) / T;
+    size_t num_tile_cols = matrix_tile_num_cols(C);
+
+    Queue* q = queue_create(num_tile_rows * num_tile_cols);
+    if (!q) {
+        return NULL;
+    }
+
+    // Turn each tile in C into a Task (the padded tiles are whole tiles)
+    for (size_t ti = 0; ti < num_tile_rows; ti++) {
+        for (size_t tj = 0; tj < num_tile_cols; tj++) {
+            Task t = task_create(A, B, C, T, ti * T, tj * T, (ti + 1) * T, (tj + 1) * T);
+            queue_add(q, t);
+        }
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to thread_mult_tile(). Adds the product of a
+ * tile of A and a tile of B to a tile of C, all three contiguous and
+ * row-major with a stride of T.
+ *
+ * @param a Pointer to the tile of A.
+ * @param b Pointer to the tile of B.
+ * @param c Pointer to the tile of C.
+ * @param T The tile size (a multiple of TILE_SIZE_ALIGNMENT).
+*/
+void tile_mult_tile(const double* a, const double* b, double* c, size_t T) {
+
+    // Micro-tiles of 4 rows x 8 columns of C in the AVX registers
+    for (size_t ii = 0; ii < T; ii += 4) {
+        for (size_t jj = 0; jj < T; jj += 8) {
+
+            __m256d c_vec[4][2];
+            for (size_t r = 0; r < 4; r++) {
+                c_vec[r][0] = _mm256_load_pd(&c[(ii + r) * T + jj]);
+                c_vec[r][1] = _mm256_load_pd(&c[(ii + r) * T + jj + 4]);
+            }
+
+            for (size_t kk = 0; kk < T; kk++) {
+                __m256d b_vals1 = _mm256_load_pd(&b[kk * T + jj]);
+                __m256d b_vals2 = _mm256_load_pd(&b[kk * T + jj + 4]);
+                for (size_t r = 0; r < 4; r++) {
+                    __m256d a_val = _mm256_broadcast_sd(&a[(ii + r) * T + kk]);
+                    c_vec[r][0] = _mm256_fmadd_pd(a_val, b_vals1, c_vec[r][0]);
+                    c_vec[r][1] = _mm256_fmadd_pd(a_val, b_vals2, c_vec[r][1]);
+                }
+            }
+
+            for (size_t r = 0; r < 4; r++) {
+                _mm256_store_pd(&c[(ii + r) * T + jj], c_vec[r][0]);
+                _mm256_store_pd(&c[(ii + r) * T + jj + 4], c_vec[r][1]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_tile(). This function
+ * encapsulates the Matrix multiplication done by a single thread given
+ * the input Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding tile in Matrix C.
+*/
+void thread_mult_tile(Task t) {
+
+    // Matrices: A x B = C (B is held in B_trans)
+    Matrix* A = t.A;
+    Matrix* B = t.B_trans;
+    Matrix* C = t.C;
+
+    size_t T = t.block_size;
+    size_t ti = t.C_row_start / T;
+    size_t tj = t.C_col_start / T;
+    size_t num_tiles_shared = matrix_tile_num_cols(A);
+
+    double* c = matrix_tile_get(C, ti, tj);
+
+    // Loop goes through the tiles in the shared dimension
+    for (size_t tk = 0; tk < num_tiles_shared; tk++) {
+        tile_mult_tile(matrix_tile_get(A, ti, tk), matrix_tile_get(B, tk, tj), c, T);
+    }
+}
+
+// Mutex lock used to access the Queue
+pthread_mutex_t queue_lock_tile;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a tile of Matrix C that
+ * needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_tile(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_tile) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_tile) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform Matrix multiplication with the Task
+            thread_mult_tile(t);
+        }
+    }
+
+    return NULL;
+}
+
+int matrix_multithread_mult_tile(Matrix* A, Matrix* B, Matrix* C, size_t NUM_THREADS) {
+
+    if (!A || !B || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Check if Matrix multiplication is valid given matrices
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for multiplication\n");
+        return -1;
+    }
+
+    if (A->layout != MATRIX_TILE_MAJOR || B->layout != MATRIX_TILE_MAJOR || C->layout != MATRIX_TILE_MAJOR ||
+        A->tile_size != C->tile_size || B->tile_size != C->tile_size) {
+        errno = EINVAL;
+        perror("Error: The matrices have to be tile-major with the same tile size");
+        return -1;
+    }
+
+    if (NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Number of threads cannot be of value 0");
+        return -1;
+    }
+
+    // Create a Queue filled with all the tasks / tiles to calculate in C
+    Queue* q = preprocessing_tile(A, B, C);
+    if (!q) {
+        return -1;
+    }
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_tile, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_tile() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_tile, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_tile);
+
+    return result;
+}
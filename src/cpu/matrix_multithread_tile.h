@@ -0,0 +1,48 @@
+/**
+ * @file matrix_multithread_tile.h
+ *
+ * @brief Contains function prototypes for Matrix multiplication of
+ * tile-major matrices (see matrix_tile.h) utilizing the following for
+ * improved performance:
+ * - Multithreading
+ * - SIMD registers (FMA)
+ * - Tiles stored as contiguous regions
+ *
+ * @details
+ * A Task corresponds to one tile of C. For each tile in the shared
+ * dimension, the tile of A and the tile of B are each a single
+ * contiguous region of tile_size * tile_size doubles, so the kernel
+ * streams three regions instead of touching tile_size rows (and pages)
+ * of each Matrix as the row-major kernels do. The tile size plays the
+ * role of the block size: no B_trans is needed since a micro-tile of
+ * 4 rows x 8 columns of C stays in AVX registers while each element of
+ * the A tile is broadcast and multiplied with 8 contiguous elements of
+ * a row of the B tile. The tiles are padded with zeros, so there are no
+ * residual rows or columns to handle.
+ *
+ * As in matrix_multithread_9avx.h, a single Queue hands out the Tasks.
+ */
+
+#ifndef MATRIX_MULTITHREAD_TILE_H
+#define MATRIX_MULTITHREAD_TILE_H
+
+#include "../shared/matrix.h"
+
+/**
+ * @brief Matrix multiply the two tile-major matrices A and B.
+ * Matrix A is the left-Matrix and Matrix B is the right-Matrix.
+ *
+ * @note Matrix C must be pre-allocated by the caller (for example with
+ * matrix_tile_create()). The product is added to the values of C. All
+ * three matrices have to be tile-major with the same tile size.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the output Matrix (dimensions n x p) where
+ * the result will be stored.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_mult_tile(Matrix* A, Matrix* B, Matrix* C, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_TILE_H
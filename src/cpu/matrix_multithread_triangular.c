@@ -0,0 +1,355 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "matrix_multithread_triangular.h"
+#include "matrix_multithread_9avx.h"
+#include "../shared/queue.h"
+#include "../shared/task.h"
+#include "../shared/matrix_utils.h"
+
+// The operands of the current call (Task only describes the columns of B)
+Matrix* T_tri = NULL;
+Matrix* B_tri = NULL;
+Matrix* B_trans_tri = NULL;
+TriangleType uplo_tri = TRIANGLE_LOWER;
+bool unit_diagonal_tri = false;
+bool is_solve_tri = false;
+
+/**
+ * @brief Helper function for matrix_multithread_trmm() and
+ * matrix_multithread_trsm(). It creates B transposed (filled by the
+ * Tasks, freed at the end of the call) and a Queue filled with a Task
+ * for each block of columns of B.
+ *
+ * @param B Pointer to Matrix B.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @return Pointer to the Queue, or NULL if an error occured.
+*/
+Queue* preprocessing_tri(Matrix* B, size_t block_size) {
+
+    B_trans_tri = matrix_create_with(pattern_zero, NULL, B->num_cols, B->num_rows);
+    if (!B_trans_tri) {
+        return NULL;
+    }
+
+    size_t p = B->num_cols;
+    Queue* q = queue_create((p + block_size - 1) / block_size);
+    if (!q) {
+        matrix_free(B_trans_tri);
+        B_trans_tri = NULL;
+        return NULL;
+    }
+
+    // The rows of a Task are the whole of B, see thread_mult_tri()
+    for (size_t j = 0; j < p; j += block_size) {
+        queue_add(q, task_create(T_tri, B_trans_tri, B, block_size,
+                                 0, j, B->num_rows, min(j + block_size, p)));
+    }
+
+    return q;
+}
+
+/**
+ * @brief Helper function to thread_mult_tri(). Computes the GEMM tile
+ * B[I_start..I_end-1][cols] += T[I_start..I_end-1][k_start..k_end-1] *
+ * B_trans[cols][k_start..k_end-1]^T with thread_mult_9avx() on views.
+*/
+void gemm_tile_tri(Task t, size_t I_start, size_t I_end, size_t k_start, size_t k_end) {
+
+    if (k_start >= k_end) {
+        return;
+    }
+
+    // Views of the columns k_start..k_end-1 (rows keep their index)
+    Matrix T_view = *T_tri;
+    T_view.values = &T_tri->values[k_start];
+    T_view.num_cols = k_end - k_start;
+    T_view.owns_rows = false;
+
+    Matrix B_trans_view = *B_trans_tri;
+    B_trans_view.values = &B_trans_tri->values[k_start];
+    B_trans_view.num_cols = k_end - k_start;
+    B_trans_view.owns_rows = false;
+
+    thread_mult_9avx(task_create(&T_view, &B_trans_view, B_tri, t.block_size,
+                                 I_start, t.C_col_start, I_end, t.C_col_end));
+}
+
+/**
+ * @brief Helper function to thread_mult_tri(). Adds the product of the
+ * diagonal block I of T (only its triangle) and the original rows
+ * I_start..I_end-1 of B to B.
+*/
+void trmm_diagonal_tri(Task t, size_t I_start, size_t I_end) {
+
+    size_t t_stride = T_tri->stride;
+    size_t b_stride = B_tri->stride;
+    size_t bt_stride = B_trans_tri->stride;
+
+    for (size_t jj = t.C_col_start; jj < t.C_col_end; jj++) {
+        const double* b_col = &B_trans_tri->values[jj * bt_stride];
+        for (size_t ii = I_start; ii < I_end; ii++) {
+
+            const double* t_row = &T_tri->values[ii * t_stride];
+            size_t k_start = (uplo_tri == TRIANGLE_LOWER) ? I_start : ii + 1;
+            size_t k_end = (uplo_tri == TRIANGLE_LOWER) ? ii : I_end;
+
+            double sum = unit_diagonal_tri ? b_col[ii] : t_row[ii] * b_col[ii];
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                sum += t_row[kk] * b_col[kk];
+            }
+            B_tri->values[ii * b_stride + jj] += sum;
+        }
+    }
+}
+
+/**
+ * @brief Helper function to thread_mult_tri(). Solves the diagonal
+ * block I of T for the rows I_start..I_end-1 of B (already updated by
+ * the finished blocks) and stores the negated solution in B transposed.
+*/
+void trsm_diagonal_tri(Task t, size_t I_start, size_t I_end) {
+
+    size_t t_stride = T_tri->stride;
+    size_t b_stride = B_tri->stride;
+    size_t bt_stride = B_trans_tri->stride;
+    size_t num_rows = I_end - I_start;
+
+    for (size_t jj = t.C_col_start; jj < t.C_col_end; jj++) {
+        double* y = &B_trans_tri->values[jj * bt_stride];
+
+        // Forward substitution for lower, backward substitution for upper
+        for (size_t r = 0; r < num_rows; r++) {
+
+            size_t ii = (uplo_tri == TRIANGLE_LOWER) ? I_start + r : I_end - 1 - r;
+            const double* t_row = &T_tri->values[ii * t_stride];
+            size_t k_start = (uplo_tri == TRIANGLE_LOWER) ? I_start : ii + 1;
+            size_t k_end = (uplo_tri == TRIANGLE_LOWER) ? ii : I_end;
+
+            // y holds -x, so this is b_i - sum of T[i][k] * x_k
+            double sum = B_tri->values[ii * b_stride + jj];
+            for (size_t kk = k_start; kk < k_end; kk++) {
+                sum += t_row[kk] * y[kk];
+            }
+            y[ii] = unit_diagonal_tri ? -sum : -sum / t_row[ii];
+        }
+    }
+}
+
+/**
+ * @brief Helper function to process_tasks_tri(). Computes the columns
+ * of B described by Task t.
+ *
+ * @param t The Task passed as value that contains the information
+ * about the corresponding columns of Matrix B.
+*/
+void thread_mult_tri(Task t) {
+
+    size_t n = T_tri->num_rows;
+    size_t b_stride = B_tri->stride;
+    size_t bt_stride = B_trans_tri->stride;
+    double* B_arr = B_tri->values;
+    double* B_trans_arr = B_trans_tri->values;
+
+    // TRMM reads the original B from B transposed and accumulates into B
+    if (!is_solve_tri) {
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = t.C_col_start; j < t.C_col_end; j++) {
+                B_trans_arr[j * bt_stride + i] = B_arr[i * b_stride + j];
+                B_arr[i * b_stride + j] = 0.0;
+            }
+        }
+    }
+
+    // The diagonal blocks, top-down for lower and bottom-up for upper
+    size_t num_blocks = (n + t.block_size - 1) / t.block_size;
+    for (size_t b = 0; b < num_blocks; b++) {
+
+        size_t block = (uplo_tri == TRIANGLE_LOWER) ? b : num_blocks - 1 - b;
+        size_t I_start = block * t.block_size;
+        size_t I_end = min(I_start + t.block_size, n);
+
+        // The off-diagonal blocks of the block row of T
+        if (uplo_tri == TRIANGLE_LOWER) {
+            gemm_tile_tri(t, I_start, I_end, 0, I_start);
+        } else {
+            gemm_tile_tri(t, I_start, I_end, I_end, n);
+        }
+
+        if (is_solve_tri) {
+            trsm_diagonal_tri(t, I_start, I_end);
+        } else {
+            trmm_diagonal_tri(t, I_start, I_end);
+        }
+    }
+
+    // TRSM: B = X = -(B transposed)^T
+    if (is_solve_tri) {
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = t.C_col_start; j < t.C_col_end; j++) {
+                B_arr[i * b_stride + j] = -B_trans_arr[j * bt_stride + i];
+            }
+        }
+    }
+}
+
+pthread_mutex_t queue_lock_tri;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a block of columns of
+ * Matrix B that needs to be calculated.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_tri(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_tri) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_tri) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Perform the triangular operation with the Task
+            thread_mult_tri(t);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for matrix_multithread_trmm() and
+ * matrix_multithread_trsm(). Validates the arguments and runs the
+ * threads.
+ *
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int run_tri(Matrix* T, Matrix* B, TriangleType uplo, bool unit_diagonal, bool is_solve,
+            size_t block_size, size_t NUM_THREADS) {
+
+    if (!T || !B) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix T or Matrix B");
+        return -1;
+    }
+
+    if (T->num_rows != T->num_cols || T->num_cols != B->num_rows) {
+        errno = EINVAL;
+        perror("Error: T has to be n x n and B n x p");
+        return -1;
+    }
+
+    if (T->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices T and B have to be row-major");
+        return -1;
+    }
+
+    if (block_size == 0 || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Block size and number of threads cannot be of value 0");
+        return -1;
+    }
+
+    if (is_solve && !unit_diagonal) {
+        for (size_t i = 0; i < T->num_rows; i++) {
+            if (T->values[i * T->stride + i] == 0.0) {
+                errno = EINVAL;
+                perror("Error: The triangular Matrix is singular (zero on the diagonal)");
+                return -1;
+            }
+        }
+    }
+
+    T_tri = T;
+    uplo_tri = uplo;
+    unit_diagonal_tri = unit_diagonal;
+    is_solve_tri = is_solve;
+
+    // Create B transposed and a Queue filled with all the column blocks of B
+    Queue* q = preprocessing_tri(B, block_size);
+    if (!q) {
+        T_tri = NULL;
+        return -1;
+    }
+    B_tri = B;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_tri, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_tri() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_tri, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+    matrix_free(B_trans_tri);
+    T_tri = NULL;
+    B_tri = NULL;
+    B_trans_tri = NULL;
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_tri);
+
+    return result;
+}
+
+int matrix_multithread_trmm(Matrix* T, Matrix* B, TriangleType uplo, bool unit_diagonal,
+                            size_t block_size, size_t NUM_THREADS) {
+
+    return run_tri(T, B, uplo, unit_diagonal, false, block_size, NUM_THREADS);
+}
+
+int matrix_multithread_trsm(Matrix* T, Matrix* B, TriangleType uplo, bool unit_diagonal,
+                            size_t block_size, size_t NUM_THREADS) {
+
+    return run_tri(T, B, uplo, unit_diagonal, true, block_size, NUM_THREADS);
+}
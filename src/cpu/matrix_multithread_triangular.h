@@ -0,0 +1,78 @@
+/**
+ * @file matrix_multithread_triangular.h
+ *
+ * @brief Contains function prototypes for the triangular multiply
+ * B := T * B (TRMM) and the triangular solve B := T^-1 * B (TRSM) with a
+ * lower or upper triangular Matrix T, utilizing the following for
+ * improved performance:
+ * - Multithreading
+ * - SIMD registers (the tile kernel of matrix_multithread_9avx.h)
+ * - Blocking / tiling method
+ *
+ * @details
+ * The columns of B are independent, so each Task owns a block of
+ * block_size columns of B and walks down (lower) or up (upper) the
+ * diagonal blocks of T. Inside a Task, the columns of B are kept as
+ * rows of B transposed, which turns every element of the result into a
+ * dot product of a row of T and a row of B transposed.
+ *
+ * For the diagonal block I (rows I_start..I_end-1) of a Task:
+ * - The off-diagonal part (columns 0..I_start-1 of T for lower,
+ *   I_end..n-1 for upper) is a plain GEMM tile. It is computed by
+ *   thread_mult_9avx() on views into T and B transposed.
+ * - The diagonal block is handled by a small kernel that only visits
+ *   the triangle (TRMM) or runs a forward / backward substitution
+ *   (TRSM).
+ *
+ * For TRSM, B transposed holds the negated solution X of the finished
+ * blocks, such that the GEMM tile (which adds) computes B_I - T_IK * X_K.
+ *
+ * Only the triangle of T given by uplo is read. With unit_diagonal, the
+ * diagonal of T is not read either and taken as 1.
+ */
+
+#ifndef MATRIX_MULTITHREAD_TRIANGULAR_H
+#define MATRIX_MULTITHREAD_TRIANGULAR_H
+
+#include <stdbool.h>
+#include "../shared/matrix.h"
+
+// Which triangle of T is used
+typedef enum {
+    TRIANGLE_LOWER = 0, // = 0 to be able to loop through enums
+    TRIANGLE_UPPER
+} TriangleType;
+
+/**
+ * @brief Overwrite B with T * B for the triangular Matrix T.
+ *
+ * @param T Pointer to the triangular Matrix (dimensions n x n).
+ * @param B Pointer to the Matrix (dimensions n x p) that is overwritten
+ * with the product.
+ * @param uplo The triangle of T to use.
+ * @param unit_diagonal true to take the diagonal of T as 1.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_trmm(Matrix* T, Matrix* B, TriangleType uplo, bool unit_diagonal,
+                            size_t block_size, size_t NUM_THREADS);
+
+/**
+ * @brief Overwrite B with the solution X of T * X = B for the triangular
+ * Matrix T.
+ *
+ * @param T Pointer to the triangular Matrix (dimensions n x n). Unless
+ * unit_diagonal is set, its diagonal must not contain zeros.
+ * @param B Pointer to the Matrix (dimensions n x p) that is overwritten
+ * with the solution.
+ * @param uplo The triangle of T to use.
+ * @param unit_diagonal true to take the diagonal of T as 1.
+ * @param block_size The block size used in the blocking / tiling method.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_multithread_trsm(Matrix* T, Matrix* B, TriangleType uplo, bool unit_diagonal,
+                            size_t block_size, size_t NUM_THREADS);
+
+#endif // MATRIX_MULTITHREAD_TRIANGULAR_H
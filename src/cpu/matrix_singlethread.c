@@ -4,6 +4,7 @@
 #include "matrix_singlethread.h"
 #include "../shared/matrix.h"
 #include "../shared/matrix_utils.h"
+#include "../shared/stats.h"
 
 void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size) {
 
@@ -33,6 +34,12 @@ void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size
         return;
     }
 
+    if (A->layout != MATRIX_ROW_MAJOR || B->layout != MATRIX_ROW_MAJOR || C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The matrices A, B and C have to be row-major");
+        return;
+    }
+
     size_t min_nm = min(n, m);
     if (block_size == 0) {
         errno = EINVAL;
@@ -44,18 +51,21 @@ void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size
     size_t smallest_dimension = min(min_nm, p);
     block_size = (block_size > smallest_dimension) ? smallest_dimension : block_size;
 
+    uint64_t stats_start = now_ns();
+
     // Create a new Matrix that is the transpose of Matrix B
-    double* B_trans_arr = NULL;
-    int result = posix_memalign((void**)&B_trans_arr, 64, sizeof(double) * B->num_rows * B->num_cols);
-    if (result != 0) {
-        perror("Error: Allocation of B transposed array failed");
+    size_t b_trans_stride = matrix_row_stride(B->num_rows);
+    size_t mapped_size = 0;
+    double* B_trans_arr = matrix_alloc_values(B->num_cols * b_trans_stride, &mapped_size);
+    if (!B_trans_arr) {
         return;
     }
+    stats_record_bytes(STATS_SINGLETHREAD, sizeof(double) * B->num_cols * b_trans_stride, 0);
 
     // Insert transposed values and Allocate Matrix
     for (size_t i = 0; i < B->num_rows; i++) {
         for (size_t j = 0; j < B->num_cols; j++) {
-            B_trans_arr[j * B->num_rows + i] = B->values[i * B->num_cols + j];
+            B_trans_arr[j * b_trans_stride + i] = B->values[i * B->stride + j];
         }
     }
 
@@ -63,6 +73,10 @@ void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size
     double* A_arr = A->values;
     double* C_arr = C->values;
 
+    // Extract the row strides (equal to the number of columns if not padded)
+    size_t a_stride = A->stride;
+    size_t c_stride = C->stride;
+
     // Iterate over blocks of Matrix C
     for (size_t i = 0; i < n; i += block_size) {
         /* Precompute upper bound to make sure we are
@@ -93,9 +107,9 @@ void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size
                         * to avoid redundant calculations in the inner loop.
                         */
                         size_t kk = 0;
-                        size_t c_index = ii * p + jj;
-                        size_t a_row_offset = ii * m;
-                        size_t b_row_offset = jj * m;
+                        size_t c_index = ii * c_stride + jj;
+                        size_t a_row_offset = ii * a_stride;
+                        size_t b_row_offset = jj * b_trans_stride;
                         for (kk = k; kk + 3 < k_max; kk += 4) {
                             C_arr[c_index] += A_arr[a_row_offset + kk] * B_trans_arr[b_row_offset + kk];
                             C_arr[c_index] += A_arr[a_row_offset + (kk + 1)] * B_trans_arr[b_row_offset + kk + 1];
@@ -111,6 +125,11 @@ void matrix_singlethread_mult(Matrix* A, Matrix* B, Matrix* C, size_t block_size
         }
     }
     // Free the helper B transpose Matrix
-    free(B_trans_arr);
+    matrix_free_values(B_trans_arr, mapped_size);
+
+    // The single thread is busy for the whole call
+    uint64_t wall_ns = now_ns() - stats_start;
+    stats_record_busy(STATS_SINGLETHREAD, wall_ns);
+    stats_record_call(STATS_SINGLETHREAD, n, m, p, 1, wall_ns);
 }
 
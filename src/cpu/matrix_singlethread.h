@@ -37,7 +37,8 @@
  * @brief Matrix multiply the two matrices A and B. Matrix A is the
  * left-Matrix and Matrix B is the right-Matrix.
  *
- * @note Matrix C must be pre-allocated by the caller.
+ * @note Matrix C must be pre-allocated by the caller. All three
+ * matrices have to be row-major.
  *
  * @param A Pointer to the first input Matrix (dimensions n x m).
  * @param B Pointer to the second input Matrix (dimensions m x p).
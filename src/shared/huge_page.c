@@ -0,0 +1,74 @@
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include "huge_page.h"
+
+void* huge_page_alloc(size_t size, size_t* mapped_size) {
+
+    if (size == 0 || !mapped_size) {
+        errno = EINVAL;
+        perror("Error: Invalid argument for huge_page_alloc()");
+        return NULL;
+    }
+
+    // Round the size up to a whole number of huge pages
+    size_t rounded_size = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+#ifdef MAP_HUGETLB
+    // First attempt: pages reserved in hugetlbfs
+    void* ptr = mmap(NULL, rounded_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        *mapped_size = rounded_size;
+        return ptr;
+    }
+#endif
+
+    /*
+     * Second attempt: transparent huge pages. mmap() only guarantees
+     * 4 KB alignment, so an extra huge page is mapped and the unaligned
+     * head and tail are unmapped again.
+     */
+    size_t padded_size = rounded_size + HUGE_PAGE_SIZE;
+    char* region = mmap(NULL, padded_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("Error: mmap() of huge page region failed");
+        return NULL;
+    }
+
+    char* aligned = (char*)(((uintptr_t)region + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+    size_t head = aligned - region;
+    size_t tail = padded_size - head - rounded_size;
+    if (head > 0) {
+        munmap(region, head);
+    }
+    if (tail > 0) {
+        munmap(aligned + rounded_size, tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Not fatal if THP is disabled, the region is still usable
+    madvise(aligned, rounded_size, MADV_HUGEPAGE);
+#endif
+
+    *mapped_size = rounded_size;
+    return aligned;
+}
+
+int huge_page_free(void* ptr, size_t mapped_size) {
+
+    if (!ptr || mapped_size == 0) {
+        errno = EINVAL;
+        perror("Error: Invalid argument for huge_page_free()");
+        return -1;
+    }
+
+    if (munmap(ptr, mapped_size) != 0) {
+        perror("Error: munmap() of huge page region failed");
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file huge_page.h
+ *
+ * @brief Contains functions to allocate large arrays backed by 2 MB
+ * (huge) pages instead of the default 4 KB pages.
+ *
+ * @details
+ * A 4096 x 4096 Matrix of doubles spans 32768 pages of 4 KB. When the
+ * blocked kernels jump between rows of A, B transposed and C, almost
+ * every row touches a new page and the dTLB cannot hold all of the
+ * translations. With 2 MB pages the same Matrix needs 64 entries.
+ *
+ * The allocation is attempted in the following order:
+ * 1. mmap() with MAP_HUGETLB, which uses pages reserved in hugetlbfs
+ *    (/proc/sys/vm/nr_hugepages). Fails if no pages are reserved.
+ * 2. An anonymous mmap() region aligned to 2 MB with
+ *    madvise(MADV_HUGEPAGE), which asks the kernel to back the region
+ *    with transparent huge pages (THP).
+ * 3. If both fail, NULL is returned and the caller is expected to
+ *    fall back to posix_memalign().
+ */
+
+#ifndef HUGE_PAGE_H
+#define HUGE_PAGE_H
+
+#include <stddef.h>
+
+// The size of a huge page on x86-64
+#define HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+/**
+ * @brief Allocate a memory region of at least size bytes that is
+ * aligned to HUGE_PAGE_SIZE and backed by huge pages if possible.
+ *
+ * @param size The number of bytes to allocate.
+ * @param mapped_size Pointer where the size of the mapped region is
+ * stored. It has to be passed on to huge_page_free().
+ * @return A pointer to the region, or NULL if an error occured.
+*/
+void* huge_page_alloc(size_t size, size_t* mapped_size);
+
+/**
+ * @brief Free a memory region allocated by huge_page_alloc().
+ *
+ * @param ptr The pointer returned by huge_page_alloc().
+ * @param mapped_size The mapped size returned by huge_page_alloc().
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int huge_page_free(void* ptr, size_t mapped_size);
+
+#endif // HUGE_PAGE_H
@@ -4,6 +4,71 @@
 #include <stdbool.h>
 #include <string.h>
 #include "matrix.h"
+#include "huge_page.h"
+
+// Allocation policy for the Matrix arrays (see matrix_set_huge_pages())
+bool matrix_use_huge_pages = false;
+
+void matrix_set_huge_pages(bool enable) {
+    matrix_use_huge_pages = enable;
+}
+
+// Row padding policy for the Matrix arrays (see matrix_set_padded_stride())
+bool matrix_use_padded_stride = false;
+
+void matrix_set_padded_stride(bool enable) {
+    matrix_use_padded_stride = enable;
+}
+
+size_t matrix_row_stride(size_t num_cols) {
+
+    if (!matrix_use_padded_stride) {
+        return num_cols;
+    }
+
+    // Round up to a whole cache line (8 doubles = 64 bytes)
+    size_t stride = (num_cols + 7) & ~(size_t)7;
+
+    // Rows that are a multiple of 4 KB alias in the cache sets
+    if ((stride * sizeof(double)) % 4096 == 0) {
+        stride += 8;
+    }
+
+    return stride;
+}
+
+double* matrix_alloc_values(size_t num_values, size_t* mapped_size) {
+
+    size_t size = sizeof(double) * num_values;
+    *mapped_size = 0;
+
+    if (matrix_use_huge_pages && size >= HUGE_PAGE_SIZE) {
+        double* values = huge_page_alloc(size, mapped_size);
+        if (values) {
+            return values;
+        }
+        // Fall back to posix_memalign()
+        *mapped_size = 0;
+    }
+
+    double* values = NULL;
+    int result = posix_memalign((void**)&values, 64, size);
+    if (result != 0) {
+        perror("Error: Allocation of Matrix array failed");
+        return NULL;
+    }
+
+    return values;
+}
+
+void matrix_free_values(double* values, size_t mapped_size) {
+
+    if (mapped_size != 0) {
+        huge_page_free(values, mapped_size);
+    } else {
+        free(values);
+    }
+}
 
 Matrix* matrix_create_from_1D_array(size_t num_rows, size_t num_cols,
                                 const double arr_values[num_rows * num_cols]) {
@@ -14,24 +79,30 @@ Matrix* matrix_create_from_1D_array(size_t num_rows, size_t num_cols,
         return NULL;
     }
 
-    // Allocate a 1D array with size determined by num_rows and num_cols
-    double* values = NULL;
-    int result = posix_memalign((void**)&values, 64, sizeof(double) * num_rows * num_cols);
-    if (result != 0) {
-        perror("Error: Allocation of Matrix array failed");
+    // Allocate a 1D array with size determined by num_rows and the row stride
+    size_t stride = matrix_row_stride(num_cols);
+    size_t mapped_size = 0;
+    double* values = matrix_alloc_values(num_rows * stride, &mapped_size);
+    if (!values) {
         return NULL;
     }
 
     // Initialize row values according to input-array
-    for (size_t i = 0; i < num_rows * num_cols; i++) {
-        values[i] = arr_values[i];
+    for (size_t i = 0; i < num_rows; i++) {
+        for (size_t j = 0; j < num_cols; j++) {
+            values[i * stride + j] = arr_values[i * num_cols + j];
+        }
+        // Zero the padding at the end of the row
+        for (size_t j = num_cols; j < stride; j++) {
+            values[i * stride + j] = 0.0;
+        }
     }
 
     // Create the Matrix
     Matrix* m = (Matrix*)malloc(sizeof(Matrix));
     if (!m) {
         // free allocated matrix array elements before returning
-        free(values);
+        matrix_free_values(values, mapped_size);
         perror("Error: Allocation of the Matrix failed");
         return NULL;
     }
@@ -40,7 +111,12 @@ Matrix* matrix_create_from_1D_array(size_t num_rows, size_t num_cols,
     m->values = values;
     m->num_rows = num_rows;
     m->num_cols = num_cols;
+    m->stride = stride;
     m->owns_rows = true;
+    m->from_arena = false;
+    m->mapped_size = mapped_size;
+    m->layout = MATRIX_ROW_MAJOR;
+    m->tile_size = 0;
 
     return m;
 }
@@ -54,18 +130,22 @@ Matrix* matrix_create_from_2D_array(size_t num_rows, size_t num_cols,
         return NULL;
     }
 
-    // Allocate a 1D array with size determined by num_rows and num_cols
-    double* values = NULL;
-    int result = posix_memalign((void**)&values, 64, sizeof(double) * num_rows * num_cols);
-    if (result != 0) {
-        perror("Error: Allocation of Matrix array failed");
+    // Allocate a 1D array with size determined by num_rows and the row stride
+    size_t stride = matrix_row_stride(num_cols);
+    size_t mapped_size = 0;
+    double* values = matrix_alloc_values(num_rows * stride, &mapped_size);
+    if (!values) {
         return NULL;
     }
 
     // Initialize row values according to input-array
     for (size_t i = 0; i < num_rows; i++) {
         for (size_t j = 0; j < num_cols; j++) {
-            values[i * num_cols + j] = arr_values[i][j];
+            values[i * stride + j] = arr_values[i][j];
+        }
+        // Zero the padding at the end of the row
+        for (size_t j = num_cols; j < stride; j++) {
+            values[i * stride + j] = 0.0;
         }
     }
 
@@ -73,7 +153,7 @@ Matrix* matrix_create_from_2D_array(size_t num_rows, size_t num_cols,
     Matrix* m = (Matrix*)malloc(sizeof(Matrix));
     if (!m) {
         // free allocated matrix array elements before returning
-        free(values);
+        matrix_free_values(values, mapped_size);
         perror("Error: Allocation of the Matrix failed");
         return NULL;
     }
@@ -82,7 +162,12 @@ Matrix* matrix_create_from_2D_array(size_t num_rows, size_t num_cols,
     m->values = values;
     m->num_rows = num_rows;
     m->num_cols = num_cols;
+    m->stride = stride;
     m->owns_rows = true;
+    m->from_arena = false;
+    m->mapped_size = mapped_size;
+    m->layout = MATRIX_ROW_MAJOR;
+    m->tile_size = 0;
 
     return m;
 }
@@ -108,11 +193,104 @@ Matrix* matrix_create_from_pointers(size_t num_rows, size_t num_cols,
     m->values = values;
     m->num_rows = num_rows;
     m->num_cols = num_cols;
+    m->stride = num_cols;
     m->owns_rows = true;
+    m->from_arena = false;
+    m->mapped_size = 0;
+    m->layout = MATRIX_ROW_MAJOR;
+    m->tile_size = 0;
 
     return m;
 }
 
+Matrix* matrix_create_col_major_from_pointers(size_t num_rows, size_t num_cols,
+                                              double* values) {
+
+    if (num_rows == 0 || num_cols == 0 || !values) {
+        errno = EINVAL;
+        perror("Error: Either non-zero dimensions or invalid 'values' pointer");
+        return NULL;
+    }
+
+    // Create the Matrix
+    Matrix* m = (Matrix*)malloc(sizeof(Matrix));
+    if (!m) {
+        // Matrix allocation failed
+        perror("Error: Failed to allocate Matrix");
+        return NULL;
+    }
+
+    // Set Matrix member variables (the caller keeps the values)
+    m->values = values;
+    m->num_rows = num_rows;
+    m->num_cols = num_cols;
+    m->stride = num_rows;
+    m->owns_rows = false;
+    m->from_arena = false;
+    m->mapped_size = 0;
+    m->layout = MATRIX_COL_MAJOR;
+    m->tile_size = 0;
+
+    return m;
+}
+
+Matrix* matrix_to_col_major(Matrix* M) {
+
+    if (!M || M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Missing row-major Matrix to convert");
+        return NULL;
+    }
+
+    // The columns are padded like the rows of a row-major Matrix
+    size_t stride = matrix_row_stride(M->num_rows);
+    size_t mapped_size = 0;
+    double* values = matrix_alloc_values(M->num_cols * stride, &mapped_size);
+    if (!values) {
+        return NULL;
+    }
+
+    // Write the columns contiguously, zeroing the padding
+    for (size_t j = 0; j < M->num_cols; j++) {
+        for (size_t i = 0; i < M->num_rows; i++) {
+            values[j * stride + i] = M->values[i * M->stride + j];
+        }
+        for (size_t i = M->num_rows; i < stride; i++) {
+            values[j * stride + i] = 0.0;
+        }
+    }
+
+    // Create the Matrix
+    Matrix* m = (Matrix*)malloc(sizeof(Matrix));
+    if (!m) {
+        // free allocated matrix array elements before returning
+        matrix_free_values(values, mapped_size);
+        perror("Error: Allocation of the Matrix failed");
+        return NULL;
+    }
+
+    // Set Matrix member variables
+    m->values = values;
+    m->num_rows = M->num_rows;
+    m->num_cols = M->num_cols;
+    m->stride = stride;
+    m->owns_rows = true;
+    m->from_arena = false;
+    m->mapped_size = mapped_size;
+    m->layout = MATRIX_COL_MAJOR;
+    m->tile_size = 0;
+
+    return m;
+}
+
+size_t matrix_index(Matrix* M, size_t i, size_t j) {
+
+    if (M->layout == MATRIX_COL_MAJOR) {
+        return j * M->stride + i;
+    }
+    return i * M->stride + j;
+}
+
 double* pattern_zero(double* values, void* args, size_t num) {
 
     if (!values) {
@@ -149,6 +327,24 @@ double* pattern_random_between(double* values, void* args, size_t num) {
     return values;
 }
 
+double* matrix_apply_pattern(double* (*pattern)(double* values, void* args, size_t num), void* args,
+                             double* values, size_t num_rows, size_t num_cols, size_t stride) {
+
+    if (stride == num_cols) {
+        return pattern(values, args, num_rows * num_cols);
+    }
+
+    // Row by row, in the same order as without padding
+    for (size_t i = 0; i < num_rows; i++) {
+        double* row = &values[i * stride];
+        if (!pattern(row, args, num_cols)) {
+            return NULL;
+        }
+        memset(&row[num_cols], 0, sizeof(double) * (stride - num_cols));
+    }
+    return values;
+}
+
 Matrix* matrix_create_with(double* (*pattern)(double* values, void* args, size_t num), void* args, size_t num_rows, size_t num_cols) {
 
     if (num_rows == 0 || num_cols == 0 || !pattern) {
@@ -157,19 +353,18 @@ Matrix* matrix_create_with(double* (*pattern)(double* values, void* args, size_t
         return NULL;
     }
 
-    // Allocate a 1D array with size determined by num_rows and num_cols
-    // double* values = (double*)calloc(num_rows * num_cols, sizeof(double));
-    double* values = NULL;
-    int result = posix_memalign((void**)&values, 64, num_rows * num_cols * sizeof(double));
-    if (result != 0) {
-        perror("Error: Allocation failed for Matrix array");
+    // Allocate a 1D array with size determined by num_rows and the row stride
+    size_t stride = matrix_row_stride(num_cols);
+    size_t mapped_size = 0;
+    double* values = matrix_alloc_values(num_rows * stride, &mapped_size);
+    if (!values) {
         return NULL;
     }
 
-    // Apply the pattern to the whole array
-    values = pattern(values, args, num_rows * num_cols);
-    if (!values) {
+    // Apply the pattern to the elements, the padding is zeroed
+    if (!matrix_apply_pattern(pattern, args, values, num_rows, num_cols, stride)) {
         // Something went wrong
+        matrix_free_values(values, mapped_size);
         return NULL;
     }
 
@@ -177,7 +372,7 @@ Matrix* matrix_create_with(double* (*pattern)(double* values, void* args, size_t
     Matrix* m = (Matrix*)malloc(sizeof(Matrix));
     if (!m) {
         // free allocated matrix array values before returning
-        free(values);
+        matrix_free_values(values, mapped_size);
         perror("Error: Allocation of the Matrix failed");
         return NULL;
     }
@@ -186,7 +381,12 @@ Matrix* matrix_create_with(double* (*pattern)(double* values, void* args, size_t
     m->values = values;
     m->num_rows = num_rows;
     m->num_cols = num_cols;
+    m->stride = stride;
     m->owns_rows = true;
+    m->from_arena = false;
+    m->mapped_size = mapped_size;
+    m->layout = MATRIX_ROW_MAJOR;
+    m->tile_size = 0;
 
     return m;
 }
@@ -269,7 +469,7 @@ int matrix_print(Matrix* m) {
         for (size_t j = 0; j < m->num_cols; j++) {
 
             // Retrieve Matrix element
-            double val = m->values[i * m->num_cols + j];
+            double val = m->values[i * m->stride + j];
             // Auxiliary buffer to place element into (+1 for null terminator)
             char temp[12];
 
@@ -334,8 +534,13 @@ int matrix_free(Matrix* m) {
         return -1;
     }
 
+    if (m->from_arena) {
+        // The Arena owns both the Matrix and its values
+        return 0;
+    }
+
     if (m->owns_rows) {
-        free(m->values);
+        matrix_free_values(m->values, m->mapped_size);
     }
     free(m);
 
@@ -19,7 +19,15 @@
  *      multiple pointers.
  *
  * The member variables num_rows and num_cols makes it clear how to
- * interpret the 1D array.
+ * interpret the 1D array. Row i starts at values[i * stride], where
+ * stride is equal to num_cols unless padded rows have been enabled
+ * through matrix_set_padded_stride().
+ *
+ * Optionally, a Matrix can be stored tile-major (see matrix_tile.h) or
+ * column-major, where column j starts at values[j * stride] (the layout
+ * of Fortran and of BLAS with CblasColMajor). The layout member tells
+ * which of the storage modes is used, all functions in this file and
+ * the kernels expect MATRIX_ROW_MAJOR unless stated otherwise.
  */
 
 #ifndef MATRIX_H
@@ -28,6 +36,15 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+/**
+ * @brief The storage modes of the values of a Matrix.
+*/
+typedef enum {
+    MATRIX_ROW_MAJOR = 0, // = 0 to be able to loop through enums
+    MATRIX_TILE_MAJOR,
+    MATRIX_COL_MAJOR,
+} MatrixLayout;
+
 typedef struct {
     // A pointer pointing to the double values on the heap.
     double* values;
@@ -36,11 +53,89 @@ typedef struct {
     size_t num_rows;
     // The number of columns in the Matrix
     size_t num_cols;
+    // The number of doubles between the start of two consecutive rows
+    // (columns if column-major)
+    size_t stride;
     // true if the Matrix owns the rows and should free them
     bool owns_rows;
+    // true if the Matrix was allocated in an Arena (see matrix_arena.h)
+    bool from_arena;
+    // Size of the mmap() region backing values, 0 if posix_memalign() was used
+    size_t mapped_size;
+    // The storage mode of values (see matrix_tile.h for MATRIX_TILE_MAJOR)
+    MatrixLayout layout;
+    // The width and height of a tile if tile-major, 0 if row-major
+    size_t tile_size;
 
 } Matrix;
 
+/**
+ * @brief Set whether the Matrix creation functions should back large
+ * Matrix arrays with 2 MB huge pages (see huge_page.h). Only arrays
+ * of at least one huge page are affected. If the huge page allocation
+ * fails, the default posix_memalign() allocation is used.
+ *
+ * @note This is a process-wide setting and is disabled by default.
+ *
+ * @param enable true to use huge pages for large Matrix arrays.
+*/
+void matrix_set_huge_pages(bool enable);
+
+/**
+ * @brief Set whether the Matrix creation functions should pad the rows
+ * to a stride that avoids cache-set aliasing.
+ *
+ * @details
+ * With a row length that is a multiple of 4 KB (e.g. 512, 1024 or 2048
+ * doubles), the same column in consecutive rows maps to the same L1
+ * and L2 cache set. The kernels read several rows of A and B transposed
+ * in the same inner loop, so these rows evict each other even though
+ * the cache is far from full. Padding the rows by a cache line shifts
+ * each row to a different set.
+ *
+ * @note This is a process-wide setting and is disabled by default.
+ * Matrices created with matrix_create_from_pointers() are never padded.
+ *
+ * @param enable true to pad the rows of newly created matrices.
+*/
+void matrix_set_padded_stride(bool enable);
+
+/**
+ * @brief Determine the row stride (in doubles) for a new Matrix with
+ * num_cols columns given the current padding setting. Without padding,
+ * this is num_cols. With padding, num_cols is rounded up to a whole
+ * cache line (8 doubles), and a cache line is added if the row length
+ * is a multiple of 4 KB.
+ *
+ * @param num_cols The number of columns in the Matrix.
+ * @return The row stride in doubles.
+*/
+size_t matrix_row_stride(size_t num_cols);
+
+/**
+ * @brief Allocate an array of doubles the way the Matrix creation
+ * functions do. Arrays of at least one huge page are backed by huge
+ * pages if enabled through matrix_set_huge_pages(). Otherwise, or if the
+ * huge page allocation fails, posix_memalign() with a 64-byte alignment
+ * is used. Used for Matrix arrays created by the kernels themselves
+ * (e.g. B transposed).
+ *
+ * @param num_values The number of doubles in the array.
+ * @param mapped_size Pointer where the mapped size is stored (the
+ * mapped_size of a Matrix using the array). Set to 0 if the array was
+ * allocated with posix_memalign().
+ * @return A pointer to the array, or NULL if an error occured.
+*/
+double* matrix_alloc_values(size_t num_values, size_t* mapped_size);
+
+/**
+ * @brief Free an array from matrix_alloc_values().
+ *
+ * @param values The array to free.
+ * @param mapped_size The mapped size from matrix_alloc_values().
+*/
+void matrix_free_values(double* values, size_t mapped_size);
+
 /**
  * @brief Create a Matrix from a static 1D array.
  *
@@ -107,6 +202,46 @@ Matrix* matrix_create_from_pointers(
     double* values
 );
 
+/**
+ * @brief Create a column-major Matrix from a pointer pointing to an
+ * array on the heap, for example an array handed over by Fortran code.
+ * Column j starts at values[j * num_rows].
+ *
+ * @note This function does not take ownership of values, matrix_free()
+ * only frees the Matrix itself. The caller is responsible for freeing
+ * the memory allocated for values.
+ *
+ * @param num_rows The number of rows in the Matrix.
+ * @param num_cols The number of columns in the Matrix.
+ * @param values A pointer to the allocated array containing the
+ * elements of the Matrix column by column.
+ * @return A pointer to the created Matrix object, or NULL if an error occured.
+*/
+Matrix* matrix_create_col_major_from_pointers(
+    size_t num_rows,
+    size_t num_cols,
+    double* values
+);
+
+/**
+ * @brief Copy a row-major Matrix into a new column-major Matrix.
+ *
+ * @param M Pointer to the row-major Matrix.
+ * @return A pointer to the column-major Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_to_col_major(Matrix* M);
+
+/**
+ * @brief Retrieve the index of element (i, j) in the values of a
+ * row-major or column-major Matrix.
+ *
+ * @param M Pointer to the Matrix.
+ * @param i The row of the element.
+ * @param j The column of the element.
+ * @return The index of the element.
+*/
+size_t matrix_index(Matrix* M, size_t i, size_t j);
+
 /**
  * @brief A pattern used by matrix_create_with() to
  * fill the internal Matrix array with zeros.
@@ -135,6 +270,23 @@ double* pattern_zero(double* values, void* args, size_t num);
  */
 double* pattern_random_between(double* values, void* args, size_t num);
 
+/**
+ * @brief Apply a pattern to the num_cols elements of each row of values
+ * and zero the padding up to stride. Without padding, the pattern is
+ * applied once to the whole array. Either way, a pattern such as
+ * pattern_random_between produces the same elements.
+ *
+ * @param pattern A function pointer to the pattern to apply.
+ * @param args Arguments for the pattern function.
+ * @param values The internal array of the Matrix (num_rows x stride).
+ * @param num_rows The number of rows in the Matrix.
+ * @param num_cols The number of columns in the Matrix.
+ * @param stride The number of doubles between the start of two rows.
+ * @return Return the pointer to values, or NULL if the pattern failed.
+ */
+double* matrix_apply_pattern(double* (*pattern)(double* values, void* args, size_t num), void* args,
+                             double* values, size_t num_rows, size_t num_cols, size_t stride);
+
 /**
  * @brief Create a Matrix given the pattern in the function argument.
  * Available patterns: pattern_zero, pattern_random_between.
@@ -182,6 +334,9 @@ int matrix_print(Matrix* m);
 /**
  * @brief Free the allocated Matrix from the heap.
  *
+ * @note A Matrix allocated in an Arena is left untouched, since
+ * it is released by arena_reset() or arena_free().
+ *
  * @param m1 Pointer to the Matrix.
  * @return A value of zero for success and -1 if an error occured.
 */
@@ -0,0 +1,187 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "matrix_arena.h"
+
+/**
+ * @brief Helper function to round size up to a multiple of
+ * ARENA_ALIGNMENT.
+ *
+ * @param size The size in bytes.
+ * @return The rounded up size in bytes.
+*/
+size_t arena_align_up(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Helper function to allocate a single slab with a 64-byte
+ * aligned memory region.
+ *
+ * @param capacity The size of the memory region in bytes.
+ * @return A pointer to the slab, or NULL if an error occured.
+*/
+ArenaSlab* arena_slab_create(size_t capacity) {
+
+    ArenaSlab* slab = (ArenaSlab*)malloc(sizeof(ArenaSlab));
+    if (!slab) {
+        perror("Error: Allocation of ArenaSlab failed");
+        return NULL;
+    }
+
+    char* memory = NULL;
+    int result = posix_memalign((void**)&memory, ARENA_ALIGNMENT, capacity);
+    if (result != 0) {
+        perror("Error: Allocation of ArenaSlab memory failed");
+        free(slab);
+        return NULL;
+    }
+
+    // Set member variables
+    slab->next = NULL;
+    slab->capacity = capacity;
+    slab->memory = memory;
+
+    return slab;
+}
+
+Arena* arena_create(size_t slab_size) {
+
+    if (slab_size == 0) {
+        errno = EINVAL;
+        perror("Error: The slab size has to be greater than 0");
+        return NULL;
+    }
+
+    Arena* a = (Arena*)malloc(sizeof(Arena));
+    if (!a) {
+        perror("Error: Allocation of Arena failed");
+        return NULL;
+    }
+
+    slab_size = arena_align_up(slab_size);
+    ArenaSlab* slab = arena_slab_create(slab_size);
+    if (!slab) {
+        free(a);
+        return NULL;
+    }
+
+    // Set member variables
+    a->head = slab;
+    a->current = slab;
+    a->offset = 0;
+    a->slab_size = slab_size;
+
+    return a;
+}
+
+void* arena_alloc(Arena* a, size_t size) {
+
+    if (!a || size == 0) {
+        errno = EINVAL;
+        perror("Error: Missing Arena or allocation size is 0");
+        return NULL;
+    }
+
+    size = arena_align_up(size);
+
+    // Move on to the next slab(s) until the allocation fits
+    while (a->offset + size > a->current->capacity) {
+
+        ArenaSlab* next = a->current->next;
+        if (!next) {
+            // Chain a new slab that is large enough for the allocation
+            size_t capacity = (size > a->slab_size) ? size : a->slab_size;
+            next = arena_slab_create(capacity);
+            if (!next) {
+                return NULL;
+            }
+            a->current->next = next;
+        }
+
+        a->current = next;
+        a->offset = 0;
+    }
+
+    // Bump the offset
+    void* ptr = a->current->memory + a->offset;
+    a->offset += size;
+
+    return ptr;
+}
+
+int arena_reset(Arena* a) {
+
+    if (!a) {
+        errno = EINVAL;
+        perror("Error: Arena argument missing");
+        return -1;
+    }
+
+    // The chained slabs are kept and reused from the start
+    a->current = a->head;
+    a->offset = 0;
+
+    return 0;
+}
+
+int arena_free(Arena* a) {
+
+    if (!a) {
+        errno = EINVAL;
+        perror("Error: Arena argument missing");
+        return -1;
+    }
+
+    ArenaSlab* slab = a->head;
+    while (slab) {
+        ArenaSlab* next = slab->next;
+        free(slab->memory);
+        free(slab);
+        slab = next;
+    }
+    free(a);
+
+    return 0;
+}
+
+Matrix* matrix_create_with_arena(Arena* a,
+    double* (*pattern)(double* values, void* args, size_t num),
+    void* args, size_t num_rows, size_t num_cols) {
+
+    if (!a || num_rows == 0 || num_cols == 0 || !pattern) {
+        errno = EINVAL;
+        perror("Error: Invalid argument for matrix_create_with_arena()");
+        return NULL;
+    }
+
+    // Place the Matrix struct and its values in a single allocation
+    size_t stride = matrix_row_stride(num_cols);
+    size_t header_size = arena_align_up(sizeof(Matrix));
+    char* memory = (char*)arena_alloc(a, header_size + sizeof(double) * num_rows * stride);
+    if (!memory) {
+        return NULL;
+    }
+    Matrix* m = (Matrix*)memory;
+    double* values = (double*)(memory + header_size);
+
+    // Apply the pattern to the elements, the padding is zeroed
+    if (!matrix_apply_pattern(pattern, args, values, num_rows, num_cols, stride)) {
+        // Something went wrong
+        return NULL;
+    }
+
+    // Set Matrix member variables
+    m->values = values;
+    m->num_rows = num_rows;
+    m->num_cols = num_cols;
+    m->stride = stride;
+    m->owns_rows = false;
+    m->from_arena = true;
+    m->mapped_size = 0;
+    m->layout = MATRIX_ROW_MAJOR;
+    m->tile_size = 0;
+
+    return m;
+}
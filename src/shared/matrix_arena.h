@@ -0,0 +1,121 @@
+/**
+ * @file matrix_arena.h
+ *
+ * @brief Contains an arena (bump) allocator for Matrix objects and
+ * their arrays.
+ *
+ * @details
+ * Every matrix_create_* function in matrix.h performs two heap
+ * allocations (posix_memalign() for the values and malloc() for the
+ * Matrix struct) and matrix_free() releases them one at a time. When
+ * many temporary matrices are created and destroyed, the allocator
+ * calls (and their locks) become noticeable.
+ *
+ * An Arena hands out memory from large 64-byte aligned slabs by
+ * bumping an offset. The Matrix struct and its values are placed next
+ * to each other in the same slab. Nothing is freed individually;
+ * instead arena_reset() makes all the memory available again in O(1).
+ * If a slab runs out of space, a new slab is chained onto the Arena.
+ * The slabs are kept across resets, so a steady-state workload stops
+ * calling the system allocator altogether.
+ *
+ * @note An Arena is not thread-safe. The intended usage is one Arena
+ * per request (or per thread) that is reset when the request is done.
+ */
+
+#ifndef MATRIX_ARENA_H
+#define MATRIX_ARENA_H
+
+#include <stddef.h>
+#include "matrix.h"
+
+// The alignment of every allocation in the Arena (a cache line)
+#define ARENA_ALIGNMENT 64
+
+typedef struct ArenaSlab {
+
+    // The next slab in the chain (NULL if this is the last one)
+    struct ArenaSlab* next;
+
+    // The capacity of the memory region in bytes
+    size_t capacity;
+
+    // The 64-byte aligned memory region that allocations are taken from
+    char* memory;
+
+} ArenaSlab;
+
+typedef struct {
+
+    // The first slab in the chain
+    ArenaSlab* head;
+
+    // The slab that allocations are currently taken from
+    ArenaSlab* current;
+
+    // Number of bytes used in the current slab
+    size_t offset;
+
+    // The capacity used when a new slab is chained onto the Arena
+    size_t slab_size;
+
+} Arena;
+
+/**
+ * @brief Create an Arena on the heap with a first slab of the
+ * given size.
+ *
+ * @param slab_size The size in bytes of each slab.
+ * @return A pointer to the Arena, or NULL if an error occured.
+*/
+Arena* arena_create(size_t slab_size);
+
+/**
+ * @brief Allocate size bytes from the Arena. The returned pointer
+ * is aligned to ARENA_ALIGNMENT bytes.
+ *
+ * @param a The Arena to allocate from.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the memory, or NULL if an error occured.
+*/
+void* arena_alloc(Arena* a, size_t size);
+
+/**
+ * @brief Release every allocation made from the Arena in O(1). The
+ * slabs are kept so that they can be reused by later allocations.
+ *
+ * @note Every Matrix created from the Arena is invalid after a reset.
+ *
+ * @param a The Arena to reset.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int arena_reset(Arena* a);
+
+/**
+ * @brief Free the Arena and all of its slabs.
+ *
+ * @param a The Arena to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int arena_free(Arena* a);
+
+/**
+ * @brief Create a Matrix in the Arena given the pattern in the
+ * function argument. See matrix_create_with() in matrix.h.
+ *
+ * @note The Matrix is released by arena_reset() or arena_free().
+ * Calling matrix_free() on it is allowed, but does nothing.
+ *
+ * @param a The Arena to allocate the Matrix and its values from.
+ * @param pattern A function pointer to the pattern to be used during
+ * Matrix generation.
+ * @param args Arguments for the pattern function.
+ * @param num_rows The number of rows in the Matrix.
+ * @param num_cols The number of columns in the Matrix.
+ * @return A pointer to the created Matrix object, or NULL if an error occured.
+*/
+Matrix* matrix_create_with_arena(Arena* a,
+    double* (*pattern)(double* values, void* args, size_t num),
+    void* args, size_t num_rows, size_t num_cols);
+
+#endif // MATRIX_ARENA_H
@@ -0,0 +1,124 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_bit.h"
+
+MatrixBit* matrix_bit_create(size_t num_rows, size_t num_cols) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    MatrixBit* M = (MatrixBit*)malloc(sizeof(MatrixBit));
+    if (!M) {
+        perror("Error: Allocation of the MatrixBit failed");
+        return NULL;
+    }
+
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    size_t num_words = (num_cols + 63) / 64;
+    M->stride = (num_words + BIT_ROW_ALIGNMENT - 1) / BIT_ROW_ALIGNMENT * BIT_ROW_ALIGNMENT;
+
+    M->words = NULL;
+    size_t num_bytes = sizeof(uint64_t) * num_rows * M->stride;
+    if (posix_memalign((void**)&M->words, 64, num_bytes) != 0) {
+        perror("Error: Allocation of the MatrixBit words failed");
+        free(M);
+        return NULL;
+    }
+    memset(M->words, 0, num_bytes);
+
+    return M;
+}
+
+int matrix_bit_free(MatrixBit* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no MatrixBit to free");
+        return -1;
+    }
+
+    free(M->words);
+    free(M);
+
+    return 0;
+}
+
+bool matrix_bit_get(MatrixBit* M, size_t i, size_t j) {
+
+    return (M->words[i * M->stride + j / 64] >> (j % 64)) & 1;
+}
+
+void matrix_bit_set(MatrixBit* M, size_t i, size_t j, bool value) {
+
+    uint64_t bit = (uint64_t)1 << (j % 64);
+    if (value) {
+        M->words[i * M->stride + j / 64] |= bit;
+    } else {
+        M->words[i * M->stride + j / 64] &= ~bit;
+    }
+}
+
+MatrixBit* matrix_to_bit(Matrix* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to convert");
+        return NULL;
+    }
+
+    if (M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to convert has to be row-major");
+        return NULL;
+    }
+
+    MatrixBit* B = matrix_bit_create(M->num_rows, M->num_cols);
+    if (!B) {
+        return NULL;
+    }
+
+    // Build each word in a register
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const double* row = &M->values[i * M->stride];
+        uint64_t* bit_row = &B->words[i * B->stride];
+        for (size_t w = 0; w * 64 < M->num_cols; w++) {
+            size_t j_end = (w * 64 + 64 < M->num_cols) ? w * 64 + 64 : M->num_cols;
+            uint64_t word = 0;
+            for (size_t j = w * 64; j < j_end; j++) {
+                word |= (uint64_t)(row[j] != 0.0) << (j % 64);
+            }
+            bit_row[w] = word;
+        }
+    }
+
+    return B;
+}
+
+Matrix* matrix_from_bit(MatrixBit* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing MatrixBit to convert");
+        return NULL;
+    }
+
+    Matrix* D = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    if (!D) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const uint64_t* bit_row = &M->words[i * M->stride];
+        for (size_t j = 0; j < M->num_cols; j++) {
+            D->values[i * D->stride + j] = (double)((bit_row[j / 64] >> (j % 64)) & 1);
+        }
+    }
+
+    return D;
+}
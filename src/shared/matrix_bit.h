@@ -0,0 +1,96 @@
+/**
+ * @file matrix_bit.h
+ *
+ * @brief Contains a bit-packed boolean Matrix and the conversions from
+ * and to a (double) Matrix.
+ *
+ * @details
+ * Element (i, j) is bit j % 64 of word j / 64 of row i. Rows are padded
+ * with zero bits to a multiple of BIT_ROW_ALIGNMENT words (256 bits), so
+ * a row can be processed in whole AVX2 registers, and the words are
+ * 64-byte aligned. A boolean Matrix takes 1/64 of the memory of the same
+ * Matrix of doubles.
+ */
+
+#ifndef MATRIX_BIT_H
+#define MATRIX_BIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+// Rows are padded to a multiple of this many words (one AVX2 register)
+#define BIT_ROW_ALIGNMENT 4
+
+typedef struct {
+
+    // The packed bits, 64 elements per word
+    uint64_t* words;
+
+    // The dimensions of the Matrix (in elements)
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of words between the start of two consecutive rows
+    size_t stride;
+
+} MatrixBit;
+
+/**
+ * @brief Create a MatrixBit on the heap with all elements false.
+ *
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @return A pointer to the MatrixBit, or NULL if an error occured.
+*/
+MatrixBit* matrix_bit_create(size_t num_rows, size_t num_cols);
+
+/**
+ * @brief Free the MatrixBit from memory.
+ *
+ * @param M The MatrixBit to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_bit_free(MatrixBit* M);
+
+/**
+ * @brief Retrieve the element at row i and column j.
+ *
+ * @param M Pointer to the MatrixBit.
+ * @param i The row.
+ * @param j The column.
+ * @return The element.
+*/
+bool matrix_bit_get(MatrixBit* M, size_t i, size_t j);
+
+/**
+ * @brief Set the element at row i and column j.
+ *
+ * @param M Pointer to the MatrixBit.
+ * @param i The row.
+ * @param j The column.
+ * @param value The new element.
+*/
+void matrix_bit_set(MatrixBit* M, size_t i, size_t j, bool value);
+
+/**
+ * @brief Convert a Matrix into a new MatrixBit. Elements that are not
+ * zero are true.
+ *
+ * @note The Matrix has to be row-major.
+ *
+ * @param M Pointer to the Matrix.
+ * @return A pointer to the MatrixBit, or NULL if an error occured.
+*/
+MatrixBit* matrix_to_bit(Matrix* M);
+
+/**
+ * @brief Convert a MatrixBit into a new Matrix of 1.0 (true) and 0.0
+ * (false).
+ *
+ * @param M Pointer to the MatrixBit.
+ * @return A pointer to the Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_from_bit(MatrixBit* M);
+
+#endif // MATRIX_BIT_H
@@ -0,0 +1,118 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_complex.h"
+
+MatrixComplex* matrix_complex_create(size_t num_rows, size_t num_cols) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    MatrixComplex* M = (MatrixComplex*)malloc(sizeof(MatrixComplex));
+    if (!M) {
+        perror("Error: Allocation of the MatrixComplex failed");
+        return NULL;
+    }
+
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    // Two elements fill an AVX register
+    M->stride = (num_cols + 1) & ~(size_t)1;
+
+    M->values = NULL;
+    size_t num_bytes = 2 * sizeof(double) * num_rows * M->stride;
+    if (posix_memalign((void**)&M->values, 64, num_bytes) != 0) {
+        perror("Error: Allocation of the MatrixComplex values failed");
+        free(M);
+        return NULL;
+    }
+    memset(M->values, 0, num_bytes);
+
+    return M;
+}
+
+int matrix_complex_free(MatrixComplex* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no MatrixComplex to free");
+        return -1;
+    }
+
+    free(M->values);
+    free(M);
+
+    return 0;
+}
+
+MatrixComplex* matrix_complex_from_parts(Matrix* re, Matrix* im) {
+
+    if (!re) {
+        errno = EINVAL;
+        perror("Error: Missing the Matrix with the real parts");
+        return NULL;
+    }
+
+    if (im && (im->num_rows != re->num_rows || im->num_cols != re->num_cols)) {
+        errno = EINVAL;
+        perror("Error: The real and imaginary parts differ in dimensions");
+        return NULL;
+    }
+
+    if (re->layout != MATRIX_ROW_MAJOR || (im && im->layout != MATRIX_ROW_MAJOR)) {
+        errno = EINVAL;
+        perror("Error: The real and imaginary parts have to be row-major");
+        return NULL;
+    }
+
+    MatrixComplex* M = matrix_complex_create(re->num_rows, re->num_cols);
+    if (!M) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < re->num_rows; i++) {
+        double* row = &M->values[2 * i * M->stride];
+        for (size_t j = 0; j < re->num_cols; j++) {
+            row[2 * j] = re->values[i * re->stride + j];
+            row[2 * j + 1] = im ? im->values[i * im->stride + j] : 0.0;
+        }
+    }
+
+    return M;
+}
+
+int matrix_complex_split(MatrixComplex* M, Matrix* re, Matrix* im) {
+
+    if (!M || !re || !im) {
+        errno = EINVAL;
+        perror("Error: Missing either the MatrixComplex or one of its parts");
+        return -1;
+    }
+
+    if (re->num_rows != M->num_rows || re->num_cols != M->num_cols ||
+        im->num_rows != M->num_rows || im->num_cols != M->num_cols) {
+        errno = EINVAL;
+        perror("Error: The parts do not match the dimensions of the MatrixComplex");
+        return -1;
+    }
+
+    if (re->layout != MATRIX_ROW_MAJOR || im->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The real and imaginary parts have to be row-major");
+        return -1;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const double* row = &M->values[2 * i * M->stride];
+        for (size_t j = 0; j < M->num_cols; j++) {
+            re->values[i * re->stride + j] = row[2 * j];
+            im->values[i * im->stride + j] = row[2 * j + 1];
+        }
+    }
+
+    return 0;
+}
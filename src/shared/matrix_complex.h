@@ -0,0 +1,80 @@
+/**
+ * @file matrix_complex.h
+ *
+ * @brief Contains a Matrix with complex double elements and the
+ * conversions from and to a pair of real matrices.
+ *
+ * @details
+ * The elements are stored interleaved: element (i, j) has its real part
+ * at values[2 * (i * stride + j)] and its imaginary part right after it.
+ * This is the layout of double complex arrays in C and of cblas_zgemm,
+ * and a 256-bit AVX register holds two whole elements.
+ *
+ * The stride (in complex elements) is rounded up to an even number and
+ * the padding is zero, such that the kernel in
+ * matrix_multithread_complex.h can always process two elements at once.
+ */
+
+#ifndef MATRIX_COMPLEX_H
+#define MATRIX_COMPLEX_H
+
+#include <stddef.h>
+#include "matrix.h"
+
+typedef struct {
+
+    // The interleaved real and imaginary parts
+    double* values;
+
+    // The dimensions of the Matrix
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of complex elements between the start of two consecutive rows
+    size_t stride;
+
+} MatrixComplex;
+
+/**
+ * @brief Create a zero-filled MatrixComplex on the heap.
+ *
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @return A pointer to the MatrixComplex, or NULL if an error occured.
+*/
+MatrixComplex* matrix_complex_create(size_t num_rows, size_t num_cols);
+
+/**
+ * @brief Free the MatrixComplex from memory.
+ *
+ * @param M The MatrixComplex to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_complex_free(MatrixComplex* M);
+
+/**
+ * @brief Create a MatrixComplex from its real and imaginary parts.
+ *
+ * @note Both parts have to be row-major.
+ *
+ * @param re Pointer to the Matrix holding the real parts.
+ * @param im Pointer to the Matrix holding the imaginary parts
+ * (same dimensions as re), or NULL for a real MatrixComplex.
+ * @return A pointer to the MatrixComplex, or NULL if an error occured.
+*/
+MatrixComplex* matrix_complex_from_parts(Matrix* re, Matrix* im);
+
+/**
+ * @brief Split a MatrixComplex into its real and imaginary parts.
+ *
+ * @note Both matrices must be pre-allocated by the caller with the
+ * dimensions of M and have to be row-major.
+ *
+ * @param M Pointer to the MatrixComplex.
+ * @param re Pointer to the Matrix receiving the real parts.
+ * @param im Pointer to the Matrix receiving the imaginary parts.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_complex_split(MatrixComplex* M, Matrix* re, Matrix* im);
+
+#endif // MATRIX_COMPLEX_H
@@ -0,0 +1,122 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "matrix_csr.h"
+
+MatrixCSR* matrix_csr_create(size_t num_rows, size_t num_cols, size_t nnz) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    MatrixCSR* M = (MatrixCSR*)malloc(sizeof(MatrixCSR));
+    if (!M) {
+        perror("Error: Allocation of the MatrixCSR failed");
+        return NULL;
+    }
+
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    M->nnz = nnz;
+
+    // At least one element such that an empty Matrix still has valid arrays
+    M->values = (double*)malloc(sizeof(double) * (nnz ? nnz : 1));
+    M->col_indices = (size_t*)malloc(sizeof(size_t) * (nnz ? nnz : 1));
+    M->row_ptr = (size_t*)calloc(num_rows + 1, sizeof(size_t));
+    if (!M->values || !M->col_indices || !M->row_ptr) {
+        perror("Error: Allocation of the MatrixCSR arrays failed");
+        free(M->values);
+        free(M->col_indices);
+        free(M->row_ptr);
+        free(M);
+        return NULL;
+    }
+
+    return M;
+}
+
+int matrix_csr_free(MatrixCSR* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no MatrixCSR to free");
+        return -1;
+    }
+
+    free(M->values);
+    free(M->col_indices);
+    free(M->row_ptr);
+    free(M);
+
+    return 0;
+}
+
+MatrixCSR* matrix_to_csr(Matrix* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to convert");
+        return NULL;
+    }
+
+    if (M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to convert has to be row-major");
+        return NULL;
+    }
+
+    // First pass: count the nonzeros
+    size_t nnz = 0;
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const double* row = &M->values[i * M->stride];
+        for (size_t j = 0; j < M->num_cols; j++) {
+            nnz += (row[j] != 0.0);
+        }
+    }
+
+    MatrixCSR* S = matrix_csr_create(M->num_rows, M->num_cols, nnz);
+    if (!S) {
+        return NULL;
+    }
+
+    // Second pass: fill the arrays row by row
+    size_t index = 0;
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const double* row = &M->values[i * M->stride];
+        S->row_ptr[i] = index;
+        for (size_t j = 0; j < M->num_cols; j++) {
+            if (row[j] != 0.0) {
+                S->values[index] = row[j];
+                S->col_indices[index] = j;
+                index++;
+            }
+        }
+    }
+    S->row_ptr[M->num_rows] = index;
+
+    return S;
+}
+
+Matrix* matrix_from_csr(MatrixCSR* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing MatrixCSR to convert");
+        return NULL;
+    }
+
+    Matrix* D = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    if (!D) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t index = M->row_ptr[i]; index < M->row_ptr[i + 1]; index++) {
+            D->values[i * D->stride + M->col_indices[index]] = M->values[index];
+        }
+    }
+
+    return D;
+}
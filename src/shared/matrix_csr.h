@@ -0,0 +1,75 @@
+/**
+ * @file matrix_csr.h
+ *
+ * @brief Contains a sparse Matrix in the compressed sparse row (CSR)
+ * format and the conversions from and to a dense Matrix.
+ *
+ * @details
+ * The nonzeros of row i are values[row_ptr[i]..row_ptr[i + 1] - 1] with
+ * their columns in col_indices at the same positions, sorted by column.
+ * row_ptr has num_rows + 1 entries, row_ptr[num_rows] equals nnz.
+ */
+
+#ifndef MATRIX_CSR_H
+#define MATRIX_CSR_H
+
+#include <stddef.h>
+#include "matrix.h"
+
+typedef struct {
+
+    // The nonzero values and their columns (nnz elements each)
+    double* values;
+    size_t* col_indices;
+
+    // The start of each row in values (num_rows + 1 elements)
+    size_t* row_ptr;
+
+    // The dimensions of the Matrix
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of stored nonzeros
+    size_t nnz;
+
+} MatrixCSR;
+
+/**
+ * @brief Create a MatrixCSR on the heap with room for nnz nonzeros.
+ * row_ptr is zero-filled, values and col_indices are not initialized.
+ *
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @param nnz The number of nonzeros.
+ * @return A pointer to the MatrixCSR, or NULL if an error occured.
+*/
+MatrixCSR* matrix_csr_create(size_t num_rows, size_t num_cols, size_t nnz);
+
+/**
+ * @brief Free the MatrixCSR from memory.
+ *
+ * @param M The MatrixCSR to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_csr_free(MatrixCSR* M);
+
+/**
+ * @brief Convert a dense Matrix into a new MatrixCSR. Only the elements
+ * that are not exactly zero are stored.
+ *
+ * @note The Matrix has to be row-major.
+ *
+ * @param M Pointer to the Matrix.
+ * @return A pointer to the MatrixCSR, or NULL if an error occured.
+*/
+MatrixCSR* matrix_to_csr(Matrix* M);
+
+/**
+ * @brief Convert a MatrixCSR into a new dense Matrix.
+ *
+ * @param M Pointer to the MatrixCSR.
+ * @return A pointer to the Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_from_csr(MatrixCSR* M);
+
+#endif // MATRIX_CSR_H
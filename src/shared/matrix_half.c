@@ -0,0 +1,137 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_half.h"
+// For the F16C conversions
+#include <immintrin.h>
+
+// Rows are padded to a multiple of this many elements (32 bytes)
+#define HALF_ROW_ALIGNMENT 16
+
+uint16_t half_from_double(double x, HalfFormat format) {
+
+    float f = (float)x;
+
+    if (format == HALF_FP16) {
+        return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+    }
+
+    // bf16 is the upper half of fp32, rounded to nearest even
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        // Keep NaN a (quiet) NaN
+        return (uint16_t)((bits >> 16) | 0x0040);
+    }
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return (uint16_t)(bits >> 16);
+}
+
+double half_to_double(uint16_t h, HalfFormat format) {
+
+    if (format == HALF_FP16) {
+        return _cvtsh_ss(h);
+    }
+
+    uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+MatrixHalf* matrix_half_create(HalfFormat format, size_t num_rows, size_t num_cols) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    MatrixHalf* M = (MatrixHalf*)malloc(sizeof(MatrixHalf));
+    if (!M) {
+        perror("Error: Allocation of the MatrixHalf failed");
+        return NULL;
+    }
+
+    M->format = format;
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    M->stride = (num_cols + HALF_ROW_ALIGNMENT - 1) / HALF_ROW_ALIGNMENT * HALF_ROW_ALIGNMENT;
+
+    M->values = NULL;
+    size_t num_bytes = sizeof(uint16_t) * num_rows * M->stride;
+    if (posix_memalign((void**)&M->values, 64, num_bytes) != 0) {
+        perror("Error: Allocation of the MatrixHalf values failed");
+        free(M);
+        return NULL;
+    }
+    // The bit pattern 0 is +0.0 in both formats
+    memset(M->values, 0, num_bytes);
+
+    return M;
+}
+
+int matrix_half_free(MatrixHalf* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no MatrixHalf to free");
+        return -1;
+    }
+
+    free(M->values);
+    free(M);
+
+    return 0;
+}
+
+MatrixHalf* matrix_to_half(Matrix* M, HalfFormat format) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to convert");
+        return NULL;
+    }
+
+    if (M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to convert has to be row-major");
+        return NULL;
+    }
+
+    MatrixHalf* H = matrix_half_create(format, M->num_rows, M->num_cols);
+    if (!H) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            H->values[i * H->stride + j] = half_from_double(M->values[i * M->stride + j], format);
+        }
+    }
+
+    return H;
+}
+
+Matrix* matrix_from_half(MatrixHalf* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing MatrixHalf to convert");
+        return NULL;
+    }
+
+    Matrix* D = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    if (!D) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            D->values[i * D->stride + j] = half_to_double(M->values[i * M->stride + j], M->format);
+        }
+    }
+
+    return D;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file matrix_half.h
+ *
+ * @brief Contains a Matrix with 16-bit floating-point elements (bf16 or
+ * IEEE fp16) and the conversions from and to a double Matrix.
+ *
+ * @details
+ * A double Matrix moves 8 bytes per element, a MatrixHalf 2 bytes. For
+ * memory-bound shapes, the kernel in matrix_multithread_half.h converts
+ * the elements to fp32 on the fly inside the AVX registers and
+ * accumulates in fp32 or fp64.
+ *
+ * - HALF_BF16 keeps the 8 exponent bits of fp32 (same range) and
+ *   7 mantissa bits. Conversion from fp32 rounds to nearest even.
+ * - HALF_FP16 has 5 exponent bits (max 65504) and 10 mantissa bits.
+ *   The conversions use the F16C instructions (round to nearest even).
+ *
+ * The rows are padded with zeros to a multiple of 16 elements (32 bytes)
+ * such that the kernel can process whole registers without a scalar tail.
+ */
+
+#ifndef MATRIX_HALF_H
+#define MATRIX_HALF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "matrix.h"
+
+// The 16-bit floating-point format of a MatrixHalf
+typedef enum {
+    HALF_BF16 = 0, // = 0 to be able to loop through enums
+    HALF_FP16
+} HalfFormat;
+
+typedef struct {
+
+    // The raw 16-bit values
+    uint16_t* values;
+    HalfFormat format;
+
+    // The dimensions of the Matrix
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of elements between the start of two consecutive rows
+    size_t stride;
+
+} MatrixHalf;
+
+/**
+ * @brief Convert a double to the 16-bit format (via fp32).
+ *
+ * @param x The value to convert.
+ * @param format The 16-bit format.
+ * @return The raw 16-bit value.
+*/
+uint16_t half_from_double(double x, HalfFormat format);
+
+/**
+ * @brief Convert a 16-bit value to double.
+ *
+ * @param h The raw 16-bit value.
+ * @param format The 16-bit format.
+ * @return The value as double.
+*/
+double half_to_double(uint16_t h, HalfFormat format);
+
+/**
+ * @brief Create a zero-filled MatrixHalf on the heap.
+ *
+ * @param format The 16-bit format.
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @return A pointer to the MatrixHalf, or NULL if an error occured.
+*/
+MatrixHalf* matrix_half_create(HalfFormat format, size_t num_rows, size_t num_cols);
+
+/**
+ * @brief Free the MatrixHalf from memory.
+ *
+ * @param M The MatrixHalf to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_half_free(MatrixHalf* M);
+
+/**
+ * @brief Convert a double Matrix into a new MatrixHalf.
+ *
+ * @note The Matrix has to be row-major.
+ *
+ * @param M Pointer to the Matrix.
+ * @param format The 16-bit format.
+ * @return A pointer to the MatrixHalf, or NULL if an error occured.
+*/
+MatrixHalf* matrix_to_half(Matrix* M, HalfFormat format);
+
+/**
+ * @brief Convert a MatrixHalf into a new double Matrix.
+ *
+ * @param M Pointer to the MatrixHalf.
+ * @return A pointer to the Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_from_half(MatrixHalf* M);
+
+#endif // MATRIX_HALF_H
@@ -0,0 +1,351 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_quant.h"
+
+// Rows are padded to a multiple of this many bytes (one AVX2 register)
+#define QUANT_ROW_ALIGNMENT 32
+
+size_t quant_type_size(QuantType type) {
+    return (type == QUANT_INT16) ? sizeof(int16_t) : sizeof(int8_t);
+}
+
+/**
+ * @brief Helper function to round x to the nearest integer (halfway
+ * cases away from zero) without depending on libm.
+*/
+long quant_round(double x) {
+    return (x >= 0) ? (long)(x + 0.5) : -(long)(-x + 0.5);
+}
+
+/**
+ * @brief Helper function to determine the number of scales and zero
+ * points for the given granularity.
+*/
+size_t quant_num_params(QuantGranularity granularity, size_t num_rows, size_t num_cols) {
+
+    switch (granularity) {
+        case QUANT_PER_ROW: return num_rows;
+        case QUANT_PER_COL: return num_cols;
+        default: return 1;
+    }
+}
+
+QuantMatrix* quant_matrix_create(QuantType type, size_t num_rows, size_t num_cols,
+                                 QuantGranularity granularity) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    QuantMatrix* M = (QuantMatrix*)malloc(sizeof(QuantMatrix));
+    if (!M) {
+        perror("Error: Allocation of the QuantMatrix failed");
+        return NULL;
+    }
+
+    // Pad the rows to whole AVX2 registers
+    size_t elements_per_register = QUANT_ROW_ALIGNMENT / quant_type_size(type);
+    M->stride = (num_cols + elements_per_register - 1) / elements_per_register * elements_per_register;
+    M->type = type;
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    M->granularity = granularity;
+    M->num_params = quant_num_params(granularity, num_rows, num_cols);
+
+    M->values = NULL;
+    size_t num_bytes = quant_type_size(type) * num_rows * M->stride;
+    int result = posix_memalign(&M->values, 64, num_bytes);
+    M->scales = (double*)malloc(sizeof(double) * M->num_params);
+    M->zero_points = (int32_t*)calloc(M->num_params, sizeof(int32_t));
+    if (result != 0 || !M->scales || !M->zero_points) {
+        perror("Error: Allocation of the QuantMatrix arrays failed");
+        if (result == 0) { free(M->values); }
+        free(M->scales);
+        free(M->zero_points);
+        free(M);
+        return NULL;
+    }
+    memset(M->values, 0, num_bytes);
+    for (size_t c = 0; c < M->num_params; c++) {
+        M->scales[c] = 1.0;
+    }
+
+    return M;
+}
+
+int quant_matrix_free(QuantMatrix* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no QuantMatrix to free");
+        return -1;
+    }
+
+    free(M->values);
+    free(M->scales);
+    free(M->zero_points);
+    free(M);
+
+    return 0;
+}
+
+int32_t quant_matrix_get(QuantMatrix* M, size_t i, size_t j) {
+
+    size_t index = i * M->stride + j;
+    switch (M->type) {
+        case QUANT_UINT8: return ((uint8_t*)M->values)[index];
+        case QUANT_INT8: return ((int8_t*)M->values)[index];
+        default: return ((int16_t*)M->values)[index];
+    }
+}
+
+/**
+ * @brief Helper function to store the quantized value q at row i and
+ * column j (q has already been clamped to the range of the type).
+*/
+void quant_matrix_set(QuantMatrix* M, size_t i, size_t j, int32_t q) {
+
+    size_t index = i * M->stride + j;
+    switch (M->type) {
+        case QUANT_UINT8: ((uint8_t*)M->values)[index] = (uint8_t)q; break;
+        case QUANT_INT8: ((int8_t*)M->values)[index] = (int8_t)q; break;
+        default: ((int16_t*)M->values)[index] = (int16_t)q; break;
+    }
+}
+
+/**
+ * @brief Helper function to retrieve the index of the scale and zero
+ * point used by row i and column j.
+*/
+size_t quant_param_index(QuantGranularity granularity, size_t i, size_t j) {
+
+    switch (granularity) {
+        case QUANT_PER_ROW: return i;
+        case QUANT_PER_COL: return j;
+        default: return 0;
+    }
+}
+
+QuantMatrix* matrix_quantize(Matrix* M, QuantType type, QuantGranularity granularity,
+                             int num_bits) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to quantize");
+        return NULL;
+    }
+
+    if (M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to quantize has to be row-major");
+        return NULL;
+    }
+
+    // See the note in matrix_quant.h for the 7 bit limit of QUANT_UINT8
+    int max_bits = (type == QUANT_UINT8) ? 7 : (type == QUANT_INT8) ? 8 : 16;
+    int min_bits = (type == QUANT_UINT8) ? 1 : 2;
+    if (num_bits < min_bits || num_bits > max_bits) {
+        errno = EINVAL;
+        perror("Error: Invalid number of bits for the quantization type");
+        return NULL;
+    }
+
+    QuantMatrix* Q = quant_matrix_create(type, M->num_rows, M->num_cols, granularity);
+    if (!Q) {
+        return NULL;
+    }
+
+    // Determine the range of each channel (including 0)
+    double* min_values = (double*)calloc(Q->num_params, sizeof(double));
+    double* max_values = (double*)calloc(Q->num_params, sizeof(double));
+    if (!min_values || !max_values) {
+        perror("Error: Allocation of the quantization ranges failed");
+        free(min_values);
+        free(max_values);
+        quant_matrix_free(Q);
+        return NULL;
+    }
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            size_t c = quant_param_index(granularity, i, j);
+            double x = M->values[i * M->stride + j];
+            if (x < min_values[c]) { min_values[c] = x; }
+            if (x > max_values[c]) { max_values[c] = x; }
+        }
+    }
+
+    // Asymmetric for unsigned types and symmetric for signed types
+    int32_t q_min, q_max;
+    if (type == QUANT_UINT8) {
+        q_min = 0;
+        q_max = (1 << num_bits) - 1;
+    } else {
+        q_max = (1 << (num_bits - 1)) - 1;
+        q_min = -q_max;
+    }
+    for (size_t c = 0; c < Q->num_params; c++) {
+        if (type == QUANT_UINT8) {
+            double range = max_values[c] - min_values[c];
+            Q->scales[c] = (range > 0) ? range / (q_max - q_min) : 1.0;
+            Q->zero_points[c] = (int32_t)quant_round(q_min - min_values[c] / Q->scales[c]);
+        } else {
+            double abs_max = (-min_values[c] > max_values[c]) ? -min_values[c] : max_values[c];
+            Q->scales[c] = (abs_max > 0) ? abs_max / q_max : 1.0;
+            Q->zero_points[c] = 0;
+        }
+    }
+
+    // Quantize every value
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            size_t c = quant_param_index(granularity, i, j);
+            double x = M->values[i * M->stride + j];
+            long q = quant_round(x / Q->scales[c]) + Q->zero_points[c];
+            q = (q < q_min) ? q_min : (q > q_max) ? q_max : q;
+            quant_matrix_set(Q, i, j, (int32_t)q);
+        }
+    }
+
+    free(min_values);
+    free(max_values);
+
+    return Q;
+}
+
+Matrix* matrix_dequantize(QuantMatrix* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: Missing QuantMatrix to dequantize");
+        return NULL;
+    }
+
+    Matrix* D = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    if (!D) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        for (size_t j = 0; j < M->num_cols; j++) {
+            size_t c = quant_param_index(M->granularity, i, j);
+            D->values[i * D->stride + j] = M->scales[c] * (quant_matrix_get(M, i, j) - M->zero_points[c]);
+        }
+    }
+
+    return D;
+}
+
+MatrixInt32* matrix_int32_create(size_t num_rows, size_t num_cols) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+
+    MatrixInt32* M = (MatrixInt32*)malloc(sizeof(MatrixInt32));
+    if (!M) {
+        perror("Error: Allocation of the MatrixInt32 failed");
+        return NULL;
+    }
+
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    M->stride = num_cols;
+    M->values = (int32_t*)calloc(num_rows * num_cols, sizeof(int32_t));
+    if (!M->values) {
+        perror("Error: Allocation of the MatrixInt32 values failed");
+        free(M);
+        return NULL;
+    }
+
+    return M;
+}
+
+int matrix_int32_free(MatrixInt32* M) {
+
+    if (!M) {
+        errno = EINVAL;
+        perror("Error: There is no MatrixInt32 to free");
+        return -1;
+    }
+
+    free(M->values);
+    free(M);
+
+    return 0;
+}
+
+int matrix_dequantize_product(QuantMatrix* A, QuantMatrix* B, MatrixInt32* C_int, Matrix* C) {
+
+    if (!A || !B || !C_int || !C) {
+        errno = EINVAL;
+        perror("Error: Missing either QuantMatrix A, B or Matrix C_int, C");
+        return -1;
+    }
+
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+    if (B->num_rows != m || C_int->num_rows != n || C_int->num_cols != p ||
+        C->num_rows != n || C->num_cols != p) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for dequantization");
+        return -1;
+    }
+
+    if (C->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: Matrix C has to be row-major");
+        return -1;
+    }
+
+    if (A->granularity == QUANT_PER_COL || B->granularity == QUANT_PER_ROW) {
+        errno = EINVAL;
+        perror("Error: A has to be quantized per tensor or row and B per tensor or column");
+        return -1;
+    }
+
+    // Row sums of A and column sums of B for the zero point correction
+    int64_t* row_sums = (int64_t*)calloc(n, sizeof(int64_t));
+    int64_t* col_sums = (int64_t*)calloc(p, sizeof(int64_t));
+    if (!row_sums || !col_sums) {
+        perror("Error: Allocation of the zero point sums failed");
+        free(row_sums);
+        free(col_sums);
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t k = 0; k < m; k++) {
+            row_sums[i] += quant_matrix_get(A, i, k);
+        }
+    }
+    for (size_t k = 0; k < m; k++) {
+        for (size_t j = 0; j < p; j++) {
+            col_sums[j] += quant_matrix_get(B, k, j);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        size_t a_param = quant_param_index(A->granularity, i, 0);
+        double scale_a = A->scales[a_param];
+        int64_t zero_a = A->zero_points[a_param];
+        for (size_t j = 0; j < p; j++) {
+            size_t b_param = quant_param_index(B->granularity, 0, j);
+            int64_t zero_b = B->zero_points[b_param];
+            int64_t sum = (int64_t)C_int->values[i * C_int->stride + j]
+                          - zero_b * row_sums[i] - zero_a * col_sums[j]
+                          + (int64_t)m * zero_a * zero_b;
+            C->values[i * C->stride + j] = scale_a * B->scales[b_param] * (double)sum;
+        }
+    }
+
+    free(row_sums);
+    free(col_sums);
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file matrix_quant.h
+ *
+ * @brief Contains integer (quantized) matrices and the helpers to
+ * quantize a double Matrix and to dequantize the result of an integer
+ * Matrix multiplication (see matrix_multithread_int.h).
+ *
+ * @details
+ * A real value x is represented by an integer q through an affine
+ * mapping with a scale s and a zero point z:
+ *
+ *     x = s * (q - z)        q = clamp(round(x / s) + z)
+ *
+ * The scale and zero point are either shared by the whole Matrix
+ * (QUANT_PER_TENSOR) or there is one pair per row (QUANT_PER_ROW) or
+ * per column (QUANT_PER_COL). QUANT_UINT8 is quantized asymmetrically
+ * (the zero point maps the minimum to 0), QUANT_INT8 and QUANT_INT16
+ * symmetrically (zero point 0).
+ *
+ * The rows are padded with zeros to a multiple of 32 bytes such that
+ * the AVX2 kernels can process whole rows without a scalar tail.
+ *
+ * @note The AVX2 instruction _mm256_maddubs_epi16 used for
+ * QUANT_UINT8 x QUANT_INT8 adds two u8 x s8 products with int16
+ * saturation. To keep the products exact, QUANT_UINT8 matrices should
+ * be quantized with at most 7 bits (255 * 128 * 2 overflows int16,
+ * 127 * 128 * 2 does not). matrix_quantize() enforces this.
+ * For QUANT_INT16, the int32 accumulators hold m * max|a| * max|b|,
+ * so the number of bits has to be chosen such that this stays below
+ * 2^31 for the inner dimension m.
+ */
+
+#ifndef MATRIX_QUANT_H
+#define MATRIX_QUANT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "matrix.h"
+
+// Integer type of the values in a QuantMatrix
+typedef enum {
+    QUANT_UINT8 = 0, // = 0 to be able to loop through enums
+    QUANT_INT8,
+    QUANT_INT16
+} QuantType;
+
+// Which values share a scale and zero point
+typedef enum {
+    QUANT_PER_TENSOR = 0,
+    QUANT_PER_ROW,
+    QUANT_PER_COL
+} QuantGranularity;
+
+typedef struct {
+
+    // The integer values (uint8_t, int8_t or int16_t depending on type)
+    void* values;
+    QuantType type;
+
+    // The dimensions of the Matrix
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of elements between the start of two consecutive rows
+    size_t stride;
+
+    // Scales and zero points (1, num_rows or num_cols of them)
+    QuantGranularity granularity;
+    double* scales;
+    int32_t* zero_points;
+    size_t num_params;
+
+} QuantMatrix;
+
+typedef struct {
+
+    // The int32 values of the Matrix
+    int32_t* values;
+
+    // The dimensions of the Matrix
+    size_t num_rows;
+    size_t num_cols;
+
+    // The number of elements between the start of two consecutive rows
+    size_t stride;
+
+} MatrixInt32;
+
+/**
+ * @brief Retrieve the size in bytes of a single element of type.
+ *
+ * @param type The QuantType.
+ * @return The size in bytes.
+*/
+size_t quant_type_size(QuantType type);
+
+/**
+ * @brief Create a zero-filled QuantMatrix on the heap with scales of 1
+ * and zero points of 0.
+ *
+ * @param type The integer type of the values.
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @param granularity Which values share a scale and zero point.
+ * @return A pointer to the QuantMatrix, or NULL if an error occured.
+*/
+QuantMatrix* quant_matrix_create(QuantType type, size_t num_rows, size_t num_cols,
+                                 QuantGranularity granularity);
+
+/**
+ * @brief Free the QuantMatrix from memory.
+ *
+ * @param M The QuantMatrix to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int quant_matrix_free(QuantMatrix* M);
+
+/**
+ * @brief Retrieve the integer value at row i and column j as int32.
+ *
+ * @param M Pointer to the QuantMatrix.
+ * @param i The row.
+ * @param j The column.
+ * @return The value.
+*/
+int32_t quant_matrix_get(QuantMatrix* M, size_t i, size_t j);
+
+/**
+ * @brief Quantize a double Matrix. The range of each channel is
+ * extended to include 0 such that 0 is represented exactly.
+ *
+ * @note The Matrix has to be row-major.
+ *
+ * @param M Pointer to the Matrix to quantize.
+ * @param type The integer type of the result.
+ * @param granularity Which values share a scale and zero point.
+ * @param num_bits The number of bits to use (1-7 for QUANT_UINT8,
+ * 2-8 for QUANT_INT8 and 2-16 for QUANT_INT16).
+ * @return A pointer to the QuantMatrix, or NULL if an error occured.
+*/
+QuantMatrix* matrix_quantize(Matrix* M, QuantType type, QuantGranularity granularity,
+                             int num_bits);
+
+/**
+ * @brief Dequantize a QuantMatrix into a new double Matrix.
+ *
+ * @param M Pointer to the QuantMatrix.
+ * @return A pointer to the Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_dequantize(QuantMatrix* M);
+
+/**
+ * @brief Create a zero-filled MatrixInt32 on the heap.
+ *
+ * @param num_rows The number of rows.
+ * @param num_cols The number of columns.
+ * @return A pointer to the MatrixInt32, or NULL if an error occured.
+*/
+MatrixInt32* matrix_int32_create(size_t num_rows, size_t num_cols);
+
+/**
+ * @brief Free the MatrixInt32 from memory.
+ *
+ * @param M The MatrixInt32 to free.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_int32_free(MatrixInt32* M);
+
+/**
+ * @brief Convert the integer product C_int = A x B of two quantized
+ * matrices into the real product C. The zero points are corrected with
+ * the row sums of A and the column sums of B:
+ *
+ *     C[i][j] = sa_i * sb_j * (C_int[i][j] - zb_j * rowsum(A)_i
+ *                              - za_i * colsum(B)_j + m * za_i * zb_j)
+ *
+ * @note A can only be quantized per tensor or per row and B per tensor
+ * or per column, otherwise the scales cannot be factored out of the sum.
+ * C has to be row-major.
+ *
+ * @param A Pointer to the quantized left Matrix (n x m).
+ * @param B Pointer to the quantized right Matrix (m x p).
+ * @param C_int Pointer to the integer product (n x p).
+ * @param C Pointer to the pre-allocated double result (n x p).
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int matrix_dequantize_product(QuantMatrix* A, QuantMatrix* B, MatrixInt32* C_int, Matrix* C);
+
+#endif // MATRIX_QUANT_H
@@ -0,0 +1,307 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include "matrix_tile.h"
+#include "queue.h"
+#include "matrix_utils.h"
+
+/**
+ * @brief Helper function to allocate a tile-major Matrix, used by
+ * matrix_tile_create() and the converters.
+ *
+ * @param num_rows The number of rows in the Matrix.
+ * @param num_cols The number of columns in the Matrix.
+ * @param tile_size The width and height of a tile.
+ * @param fill_zero true to zero the values, the converters write every
+ * value (including the padding) themselves.
+ * @return A pointer to the created Matrix object, or NULL if an error occured.
+ */
+Matrix* allocate_tile(size_t num_rows, size_t num_cols, size_t tile_size, bool fill_zero) {
+
+    if (num_rows == 0 || num_cols == 0) {
+        errno = EINVAL;
+        perror("Error: Both dimensions have to be greater than 0");
+        return NULL;
+    }
+    if (tile_size == 0 || tile_size % TILE_SIZE_ALIGNMENT != 0) {
+        errno = EINVAL;
+        perror("Error: The tile size has to be a non-zero multiple of TILE_SIZE_ALIGNMENT");
+        return NULL;
+    }
+
+    Matrix* M = (Matrix*)malloc(sizeof(Matrix));
+    if (!M) {
+        perror("Error: Allocation of the Matrix failed");
+        return NULL;
+    }
+
+    // Whole tiles, the edge tiles are padded
+    size_t num_tile_rows = (num_rows + tile_size - 1) / tile_size;
+    size_t num_tile_cols = (num_cols + tile_size - 1) / tile_size;
+    size_t num_bytes = sizeof(double) * num_tile_rows * num_tile_cols * tile_size * tile_size;
+
+    M->values = NULL;
+    if (posix_memalign((void**)&M->values, 64, num_bytes) != 0) {
+        perror("Error: Allocation of Matrix array failed");
+        free(M);
+        return NULL;
+    }
+    if (fill_zero) {
+        memset(M->values, 0, num_bytes);
+    }
+
+    M->num_rows = num_rows;
+    M->num_cols = num_cols;
+    M->stride = tile_size;
+    M->owns_rows = true;
+    M->from_arena = false;
+    M->mapped_size = 0;
+    M->layout = MATRIX_TILE_MAJOR;
+    M->tile_size = tile_size;
+
+    return M;
+}
+
+Matrix* matrix_tile_create(size_t num_rows, size_t num_cols, size_t tile_size) {
+
+    return allocate_tile(num_rows, num_cols, tile_size, true);
+}
+
+size_t matrix_tile_num_cols(Matrix* M) {
+
+    return (M->num_cols + M->tile_size - 1) / M->tile_size;
+}
+
+double* matrix_tile_get(Matrix* M, size_t ti, size_t tj) {
+
+    return &M->values[(ti * matrix_tile_num_cols(M) + tj) * M->tile_size * M->tile_size];
+}
+
+size_t matrix_tile_index(Matrix* M, size_t i, size_t j) {
+
+    size_t T = M->tile_size;
+    return (i / T * matrix_tile_num_cols(M) + j / T) * T * T + (i % T) * T + j % T;
+}
+
+// The direction of the current conversion
+bool to_tile_major_tile_convert;
+
+/**
+ * @brief Helper function to process_tasks_tile_convert(). Converts the
+ * tile row of the Task between t.A (source) and t.C (destination), the
+ * tile-major side is walked sequentially.
+ *
+ * @param t The Task passed as value, C_row_start and C_row_end are the
+ * rows of the tile row.
+*/
+void thread_convert_tile(Task t) {
+
+    // The row-major and the tile-major Matrix
+    Matrix* R = to_tile_major_tile_convert ? t.A : t.C;
+    Matrix* M = to_tile_major_tile_convert ? t.C : t.A;
+
+    size_t T = M->tile_size;
+    size_t ti = t.C_row_start / T;
+    size_t num_tile_cols = matrix_tile_num_cols(M);
+    size_t r_stride = R->stride;
+
+    for (size_t tj = 0; tj < num_tile_cols; tj++) {
+        double* tile = matrix_tile_get(M, ti, tj);
+        size_t col = tj * T;
+        size_t width = min(T, R->num_cols - col);
+
+        for (size_t r = 0; r < T; r++) {
+            size_t row = t.C_row_start + r;
+            double* tile_row = &tile[r * T];
+
+            if (!to_tile_major_tile_convert) {
+                if (row < t.C_row_end) {
+                    memcpy(&R->values[row * r_stride + col], tile_row, sizeof(double) * width);
+                }
+            } else if (row < t.C_row_end) {
+                memcpy(tile_row, &R->values[row * r_stride + col], sizeof(double) * width);
+                memset(&tile_row[width], 0, sizeof(double) * (T - width));
+            } else {
+                // Padding rows of the bottom tiles
+                memset(tile_row, 0, sizeof(double) * T);
+            }
+        }
+    }
+}
+
+// Mutex lock used to access the Queue
+pthread_mutex_t queue_lock_tile_convert;
+
+/**
+ * @brief Function used by the threads. A thread will access the Queue
+ * and retrieve a Task object that describes a tile row to convert.
+ *
+ * @param arg A pointer to the Queue.
+ *
+ * @return In both cases of success and failure, it returns NULL.
+ * Failures are however logged using perror.
+*/
+void* process_tasks_tile_convert(void* arg) {
+
+    // Extract argument
+    Queue* q = (Queue*) arg;
+
+    // Keep going until the Queue is empty (true due to mutex for Queue)
+    while (true) {
+
+        Task t;
+        bool is_empty;
+
+        // Lock the Queue with the mutex before accessing
+        if (pthread_mutex_lock(&queue_lock_tile_convert) != 0) {
+            perror("Error: Mutex lock failed");
+            return NULL;
+        }
+
+        // Retrieve Queue data
+        is_empty = queue_is_empty(q);
+        if (!is_empty) {
+            t = queue_get(q);
+        }
+
+        // Unlock the Queue
+        if(pthread_mutex_unlock(&queue_lock_tile_convert) != 0) {
+            perror("Error: Mutex unlock failed");
+            return NULL;
+        }
+
+        if (is_empty) {
+            // Queue is empty, leave
+            break;
+        } else {
+            // Convert the tile row of the Task
+            thread_convert_tile(t);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function for the converters. Converts all tile rows
+ * from src to dst with NUM_THREADS threads.
+ *
+ * @param src Pointer to the source Matrix.
+ * @param dst Pointer to the destination Matrix.
+ * @param to_tile_major true if dst is the tile-major Matrix.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int convert_tile(Matrix* src, Matrix* dst, bool to_tile_major, size_t NUM_THREADS) {
+
+    size_t T = to_tile_major ? dst->tile_size : src->tile_size;
+    size_t n = src->num_rows;
+
+    Queue* q = queue_create((n + T - 1) / T);
+    if (!q) {
+        return -1;
+    }
+
+    // A Task for each tile row
+    for (size_t i = 0; i < n; i += T) {
+        Task t = {0};
+        t.A = src;
+        t.C = dst;
+        t.block_size = T;
+        t.C_row_start = i;
+        t.C_row_end = min(i + T, n);
+        t.C_col_end = src->num_cols;
+        t.is_valid = true;
+        queue_add(q, t);
+    }
+
+    to_tile_major_tile_convert = to_tile_major;
+
+    // Initialize the mutex for the Queue
+    pthread_mutex_init(&queue_lock_tile_convert, NULL);
+
+    // Create array to hold threads
+    pthread_t threads[NUM_THREADS];
+    size_t num_created = 0;
+    int result = 0;
+
+    // Assign each thread to the process_tasks_tile_convert() function
+    for (; num_created < NUM_THREADS; num_created++) {
+        if (pthread_create(&threads[num_created], NULL, process_tasks_tile_convert, q) != 0) {
+            perror("Error: Creating thread failed");
+            result = -1;
+            break;
+        }
+    }
+
+    // The created threads finish the Queue even if a creation failed
+    for (size_t i = 0; i < num_created; i++) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            perror("Error: pthread_join failed");
+            result = -1;
+        }
+    }
+
+    // Free allocated memory
+    queue_free(q);
+
+    // Destory the Queue mutex
+    pthread_mutex_destroy(&queue_lock_tile_convert);
+
+    return result;
+}
+
+Matrix* matrix_to_tile_major(Matrix* M, size_t tile_size, size_t NUM_THREADS) {
+
+    if (!M || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to convert or no threads");
+        return NULL;
+    }
+    if (M->layout != MATRIX_ROW_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to convert has to be row-major");
+        return NULL;
+    }
+
+    Matrix* D = allocate_tile(M->num_rows, M->num_cols, tile_size, false);
+    if (!D) {
+        return NULL;
+    }
+
+    if (convert_tile(M, D, true, NUM_THREADS) != 0) {
+        matrix_free(D);
+        return NULL;
+    }
+
+    return D;
+}
+
+Matrix* matrix_from_tile_major(Matrix* M, size_t NUM_THREADS) {
+
+    if (!M || NUM_THREADS == 0) {
+        errno = EINVAL;
+        perror("Error: Missing Matrix to convert or no threads");
+        return NULL;
+    }
+    if (M->layout != MATRIX_TILE_MAJOR) {
+        errno = EINVAL;
+        perror("Error: The Matrix to convert has to be tile-major");
+        return NULL;
+    }
+
+    Matrix* D = matrix_create_with(pattern_zero, NULL, M->num_rows, M->num_cols);
+    if (!D) {
+        return NULL;
+    }
+
+    if (convert_tile(M, D, false, NUM_THREADS) != 0) {
+        matrix_free(D);
+        return NULL;
+    }
+
+    return D;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file matrix_tile.h
+ * @brief Tile-major storage of a Matrix
+ * This file contains the functions to create a Matrix with the
+ * MATRIX_TILE_MAJOR layout and to convert between the row-major and the
+ * tile-major layout.
+ *
+ * @details
+ * A row-major block of block_size x block_size elements spans block_size
+ * separate rows, which are block_size separate streams for the hardware
+ * prefetcher and (for large matrices) block_size separate pages in the
+ * TLB. In the tile-major layout, the Matrix is split into tiles of
+ * tile_size x tile_size elements and each tile is one contiguous region
+ * of tile_size * tile_size doubles:
+ *  - The tiles are stored by tile rows, tile (ti, tj) is tile number
+ *  ti * num_tile_cols + tj.
+ *  - Inside a tile, the elements are row-major with a stride of
+ *  tile_size, so a tile can be handed to a row-major kernel as is.
+ *  - The tiles at the right and bottom edges are padded with zeros to
+ *  full tiles. Zeros do not change a product, so the kernels consuming
+ *  the layout never handle partial tiles.
+ *
+ * Element (i, j) is found at index
+ * ((i / T) * num_tile_cols + j / T) * T * T + (i % T) * T + j % T,
+ * where T is the tile size. The stride member of a tile-major Matrix is
+ * the tile size.
+ */
+
+#ifndef MATRIX_TILE_H
+#define MATRIX_TILE_H
+
+#include "matrix.h"
+
+// The tile size has to be a multiple of this number (a cache line of doubles)
+#define TILE_SIZE_ALIGNMENT 8
+
+/**
+ * @brief Create a zero-filled Matrix with the MATRIX_TILE_MAJOR layout.
+ *
+ * @param num_rows The number of rows in the Matrix.
+ * @param num_cols The number of columns in the Matrix.
+ * @param tile_size The width and height of a tile, a non-zero multiple
+ * of TILE_SIZE_ALIGNMENT.
+ * @return A pointer to the created Matrix object, or NULL if an error occured.
+*/
+Matrix* matrix_tile_create(size_t num_rows, size_t num_cols, size_t tile_size);
+
+/**
+ * @brief Retrieve the number of tile columns of a tile-major Matrix.
+ *
+ * @param M Pointer to the tile-major Matrix.
+ * @return The number of tiles in a tile row.
+*/
+size_t matrix_tile_num_cols(Matrix* M);
+
+/**
+ * @brief Retrieve a pointer to the first element of tile (ti, tj) of a
+ * tile-major Matrix. The tile is row-major with a stride of tile_size.
+ *
+ * @param M Pointer to the tile-major Matrix.
+ * @param ti The tile row.
+ * @param tj The tile column.
+ * @return Pointer to the tile.
+*/
+double* matrix_tile_get(Matrix* M, size_t ti, size_t tj);
+
+/**
+ * @brief Retrieve the index of element (i, j) in the values of a
+ * tile-major Matrix.
+ *
+ * @param M Pointer to the tile-major Matrix.
+ * @param i The row of the element.
+ * @param j The column of the element.
+ * @return The index of the element.
+*/
+size_t matrix_tile_index(Matrix* M, size_t i, size_t j);
+
+/**
+ * @brief Convert a row-major Matrix to a new tile-major Matrix. Each
+ * thread converts whole tile rows, writing the tiles sequentially.
+ *
+ * @param M Pointer to the row-major Matrix.
+ * @param tile_size The width and height of a tile, a non-zero multiple
+ * of TILE_SIZE_ALIGNMENT.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A pointer to the tile-major Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_to_tile_major(Matrix* M, size_t tile_size, size_t NUM_THREADS);
+
+/**
+ * @brief Convert a tile-major Matrix to a new row-major Matrix. Each
+ * thread converts whole tile rows, the padding is dropped.
+ *
+ * @param M Pointer to the tile-major Matrix.
+ * @param NUM_THREADS The number of threads to utilize.
+ * @return A pointer to the row-major Matrix, or NULL if an error occured.
+*/
+Matrix* matrix_from_tile_major(Matrix* M, size_t NUM_THREADS);
+
+#endif // MATRIX_TILE_H
@@ -1,6 +1,7 @@
 #include "matrix_utils.h"
 #include <errno.h>
 #include <stdlib.h>
+#include <time.h>
 #include <cblas.h>
 
 long random_between(long min, long max) {
@@ -42,6 +43,17 @@ int matrix_mult_openblas(double *A, double *B, double *C, size_t n, size_t m, si
     return 0;
 }
 
+uint64_t now_ns() {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+double now_seconds() {
+    return now_ns() * 1e-9;
+}
+
 long min(long a, long b) {
     return (a < b) ? a : b;
 }
@@ -1,6 +1,7 @@
 #ifndef MATRIX_UTILS_H
 #define MATRIX_UTILS_H
 
+#include <stdint.h>
 #include "matrix.h"
 
 /**
@@ -42,6 +43,20 @@ Matrix* generate_matrix(long VALUES_MIN, long VALUES_MAX,
  */
 int matrix_mult_openblas(double *A, double *B, double *C, size_t n, size_t m, size_t p);
 
+/**
+ * @brief Retrieve the current time from a monotonic clock.
+ *
+ * @return The time in nanoseconds.
+ */
+uint64_t now_ns();
+
+/**
+ * @brief Retrieve the current time from a monotonic clock.
+ *
+ * @return The time in seconds.
+ */
+double now_seconds();
+
 /**
  * @brief Determines the smallest of the two input integer values.
  * @param a The first integer.
@@ -0,0 +1,116 @@
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "matrix_verification.h"
+
+/**
+ * @brief Helper function for matrix_verify_freivalds(). Computes the
+ * Matrix-vector product y = M x v together with y_abs = |M| x |v|.
+ *
+ * @param M Pointer to the Matrix (row-major or column-major).
+ * @param v The input vector (num_cols elements).
+ * @param v_abs The absolute input vector (num_cols elements).
+ * @param y The output vector (num_rows elements).
+ * @param y_abs The absolute output vector (num_rows elements).
+*/
+void freivalds_matrix_vector_mult(Matrix* M, const double* v,
+                                  const double* v_abs, double* y,
+                                  double* y_abs) {
+
+    // The distance between two consecutive elements of a row
+    size_t col_step = (M->layout == MATRIX_COL_MAJOR) ? M->stride : 1;
+
+    for (size_t i = 0; i < M->num_rows; i++) {
+        const double* row = &M->values[matrix_index(M, i, 0)];
+        double sum = 0.0;
+        double sum_abs = 0.0;
+        for (size_t j = 0; j < M->num_cols; j++) {
+            sum += row[j * col_step] * v[j];
+            sum_abs += fabs(row[j * col_step]) * v_abs[j];
+        }
+        y[i] = sum;
+        y_abs[i] = sum_abs;
+    }
+}
+
+int matrix_verify_freivalds(Matrix* A, Matrix* B, Matrix* C,
+                            size_t num_trials, double tolerance,
+                            unsigned int seed) {
+
+    if (!A || !B || !C || !A->values || !B->values || !C->values) {
+        errno = EINVAL;
+        perror("Error: Missing either Matrix A, B or Matrix C");
+        return -1;
+    }
+
+    // Extract Matrix dimensions
+    size_t n = A->num_rows;
+    size_t m = A->num_cols;
+    size_t p = B->num_cols;
+
+    // Check if the matrices are valid for the multiplication
+    if (A->num_cols != B->num_rows ||
+        C->num_rows != A->num_rows ||
+        C->num_cols != B->num_cols) {
+        errno = EINVAL;
+        perror("Error: Matrix dimensions are not valid for verification");
+        return -1;
+    }
+
+    if (num_trials == 0 || tolerance < 0.0) {
+        errno = EINVAL;
+        perror("Error: num_trials has to be non-zero and tolerance non-negative");
+        return -1;
+    }
+
+    /*
+     * Workspace for a single trial:
+     * r, r_abs (p), B x r and |B| x |r| (m),
+     * A x (B x r), |A| x (|B| x |r|), C x r and |C| x |r| (n).
+     */
+    size_t workspace_size = 2 * p + 2 * m + 4 * n;
+    double* workspace = NULL;
+    int result = posix_memalign((void**)&workspace, 64, sizeof(double) * workspace_size);
+    if (result != 0) {
+        perror("Error: Allocation of Freivalds workspace failed");
+        return -1;
+    }
+    double* r = workspace;
+    double* r_abs = r + p;
+    double* Br = r_abs + p;
+    double* Br_abs = Br + m;
+    double* ABr = Br_abs + m;
+    double* ABr_abs = ABr + n;
+    double* Cr = ABr_abs + n;
+    double* Cr_abs = Cr + n;
+
+    int status = 0;
+    for (size_t trial = 0; trial < num_trials && status == 0; trial++) {
+
+        // Draw a random vector with elements uniform in [-1, 1]
+        for (size_t j = 0; j < p; j++) {
+            r[j] = 2.0 * ((double)rand_r(&seed) / RAND_MAX) - 1.0;
+            r_abs[j] = fabs(r[j]);
+        }
+
+        // Right-hand side: A x (B x r)
+        freivalds_matrix_vector_mult(B, r, r_abs, Br, Br_abs);
+        freivalds_matrix_vector_mult(A, Br, Br_abs, ABr, ABr_abs);
+
+        // Left-hand side: C x r
+        freivalds_matrix_vector_mult(C, r, r_abs, Cr, Cr_abs);
+
+        // Compare each row against its rounding error bound
+        for (size_t i = 0; i < n; i++) {
+            double bound = tolerance * (ABr_abs[i] + Cr_abs[i]);
+            if (fabs(Cr[i] - ABr[i]) > bound) {
+                status = 1;
+                break;
+            }
+        }
+    }
+
+    free(workspace);
+    return status;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file matrix_verification.h
+ *
+ * @brief Contains function prototypes for cheap, probabilistic
+ * verification of a Matrix multiplication result.
+ *
+ * @details
+ * Recomputing A x B with a reference implementation and comparing
+ * every element costs as much as the multiplication itself. Freivalds'
+ * algorithm instead picks a random vector r (p elements) and checks
+ * that C x r equals A x (B x r). Both sides are computed with
+ * Matrix-vector products, so a single trial costs O(nm + mp + np)
+ * instead of O(nmp).
+ *
+ * If C != A x B, a trial with a random r exposes the difference with
+ * high probability. Repeating the check num_trials times with
+ * independent vectors lowers the chance of a false "correct" further.
+ *
+ * Since the values are doubles, the two sides are compared with a
+ * relative tolerance. The tolerance is scaled by the same products
+ * computed on absolute values (|C| x |r| and |A| x (|B| x |r|)), which
+ * bounds the magnitude of the rounding error in each row.
+ */
+
+#ifndef MATRIX_VERIFICATION_H
+#define MATRIX_VERIFICATION_H
+
+#include "matrix.h"
+
+// Relative tolerance that accepts the rounding errors of double sums
+#define FREIVALDS_DEFAULT_TOLERANCE 1e-10
+
+/**
+ * @brief Verify that C = A x B using Freivalds' algorithm.
+ *
+ * @note The kernels in src/cpu accumulate into C, so C is expected
+ * to have been zero before the multiplication that is verified.
+ *
+ * The random vectors are drawn with rand_r() from seed such that the
+ * global rand() sequence (used for Matrix generation) is left untouched.
+ * The matrices can be row-major or column-major.
+ *
+ * @param A Pointer to the first input Matrix (dimensions n x m).
+ * @param B Pointer to the second input Matrix (dimensions m x p).
+ * @param C Pointer to the result Matrix to verify (dimensions n x p).
+ * @param num_trials The number of random vectors to check with.
+ * @param tolerance The relative tolerance, see
+ * FREIVALDS_DEFAULT_TOLERANCE.
+ * @param seed The seed used to generate the random vectors.
+ * @return A value of zero if C is consistent with A x B, 1 if a
+ * mismatch was detected and -1 if an error occured.
+*/
+int matrix_verify_freivalds(Matrix* A, Matrix* B, Matrix* C,
+                            size_t num_trials, double tolerance,
+                            unsigned int seed);
+
+#endif // MATRIX_VERIFICATION_H
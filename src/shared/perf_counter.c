@@ -0,0 +1,52 @@
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include "perf_counter.h"
+
+int perf_counter_open(uint32_t type, uint64_t config) {
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int perf_counter_open_cache_misses(uint64_t cache, uint64_t op) {
+    return perf_counter_open(PERF_TYPE_HW_CACHE, cache | (op << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+void perf_counter_start(int fd) {
+
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+long long perf_counter_stop(int fd) {
+
+    long long count = -1;
+    if (fd < 0) {
+        return -1;
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        return -1;
+    }
+    return count;
+}
+
+void perf_counter_close(int fd) {
+
+    if (fd >= 0) {
+        close(fd);
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file perf_counter.h
+ *
+ * @brief Contains functions to count hardware events (e.g. cache and
+ * dTLB misses) of a measured section with perf_event_open().
+ *
+ * @details
+ * A counter counts the user-space events of this process and of the
+ * threads it creates after the counter has been opened, so the misses
+ * of the worker threads of a multiplication are included. Usage:
+ *
+ *     int fd = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+ *     perf_counter_start(fd);
+ *     ... work ...
+ *     long long misses = perf_counter_stop(fd);
+ *     perf_counter_close(fd);
+ *
+ * If a counter is not available (no PMU in a virtual machine, or a
+ * restrictive /proc/sys/kernel/perf_event_paranoid), the file
+ * descriptor is -1. All functions accept it, and perf_counter_stop()
+ * returns -1 for it.
+ */
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <stdint.h>
+#include <linux/perf_event.h>
+
+/**
+ * @brief Open a disabled counter of the given event.
+ *
+ * @param type The perf event type (e.g. PERF_TYPE_HARDWARE).
+ * @param config The event of the given type.
+ * @return The file descriptor of the counter, or -1 if not available.
+*/
+int perf_counter_open(uint32_t type, uint64_t config);
+
+/**
+ * @brief Open a disabled counter of the misses of a cache operation.
+ *
+ * @param cache The cache (e.g. PERF_COUNT_HW_CACHE_DTLB).
+ * @param op The operation, PERF_COUNT_HW_CACHE_OP_READ or
+ * PERF_COUNT_HW_CACHE_OP_WRITE.
+ * @return The file descriptor of the counter, or -1 if not available.
+*/
+int perf_counter_open_cache_misses(uint64_t cache, uint64_t op);
+
+/**
+ * @brief Reset and enable a counter.
+ *
+ * @param fd The file descriptor of the counter, or -1.
+*/
+void perf_counter_start(int fd);
+
+/**
+ * @brief Disable a counter and read its value.
+ *
+ * @param fd The file descriptor of the counter, or -1.
+ * @return The number of counted events, or -1 if not available.
+*/
+long long perf_counter_stop(int fd);
+
+/**
+ * @brief Close a counter.
+ *
+ * @param fd The file descriptor of the counter, or -1.
+*/
+void perf_counter_close(int fd);
+
+#endif // PERF_COUNTER_H
@@ -0,0 +1,215 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+
+const double STATS_BUCKET_BOUNDS[STATS_NUM_BUCKETS - 1] = {
+    1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.0, 10.0, 100.0
+};
+
+// The cumulative statistics, only accessed through atomic operations
+KernelStats stats_kernels[STATS_NUM_KERNELS];
+
+/**
+ * @brief Helper function to atomically add value to counter.
+ *
+ * @param counter Pointer to the shared counter.
+ * @param value The value to add.
+*/
+void stats_add(uint64_t* counter, uint64_t value) {
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+void stats_record_call(StatsKernel kernel, size_t n, size_t m, size_t p,
+                       size_t num_threads, uint64_t wall_ns) {
+
+    if (kernel >= STATS_NUM_KERNELS) {
+        return;
+    }
+    KernelStats* s = &stats_kernels[kernel];
+
+    stats_add(&s->calls, 1);
+    stats_add(&s->flops, 2 * (uint64_t)n * m * p);
+    stats_add(&s->wall_ns, wall_ns);
+    stats_add(&s->thread_available_ns, wall_ns * num_threads);
+
+    // Find the histogram bucket for the wall time
+    double wall_seconds = wall_ns * 1e-9;
+    size_t bucket = 0;
+    while (bucket < STATS_NUM_BUCKETS - 1 && wall_seconds > STATS_BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    stats_add(&s->wall_buckets[bucket], 1);
+}
+
+void stats_record_bytes(StatsKernel kernel, size_t b_trans_bytes, size_t queue_bytes) {
+
+    if (kernel >= STATS_NUM_KERNELS) {
+        return;
+    }
+    stats_add(&stats_kernels[kernel].b_trans_bytes, b_trans_bytes);
+    stats_add(&stats_kernels[kernel].queue_bytes, queue_bytes);
+}
+
+void stats_record_busy(StatsKernel kernel, uint64_t busy_ns) {
+
+    if (kernel >= STATS_NUM_KERNELS) {
+        return;
+    }
+    stats_add(&stats_kernels[kernel].thread_busy_ns, busy_ns);
+}
+
+int stats_snapshot(StatsSnapshot* snapshot) {
+
+    if (!snapshot) {
+        errno = EINVAL;
+        perror("Error: Missing StatsSnapshot argument");
+        return -1;
+    }
+
+    // Load each counter atomically (the snapshot is not a single atomic copy)
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        KernelStats* src = &stats_kernels[k];
+        KernelStats* dst = &snapshot->kernels[k];
+        dst->calls = __atomic_load_n(&src->calls, __ATOMIC_RELAXED);
+        dst->flops = __atomic_load_n(&src->flops, __ATOMIC_RELAXED);
+        dst->wall_ns = __atomic_load_n(&src->wall_ns, __ATOMIC_RELAXED);
+        for (size_t b = 0; b < STATS_NUM_BUCKETS; b++) {
+            dst->wall_buckets[b] = __atomic_load_n(&src->wall_buckets[b], __ATOMIC_RELAXED);
+        }
+        dst->b_trans_bytes = __atomic_load_n(&src->b_trans_bytes, __ATOMIC_RELAXED);
+        dst->queue_bytes = __atomic_load_n(&src->queue_bytes, __ATOMIC_RELAXED);
+        dst->thread_busy_ns = __atomic_load_n(&src->thread_busy_ns, __ATOMIC_RELAXED);
+        dst->thread_available_ns = __atomic_load_n(&src->thread_available_ns, __ATOMIC_RELAXED);
+    }
+
+    return 0;
+}
+
+void stats_reset() {
+
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        uint64_t* counters = (uint64_t*)&stats_kernels[k];
+        for (size_t i = 0; i < sizeof(KernelStats) / sizeof(uint64_t); i++) {
+            __atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+const char* stats_kernel_name(StatsKernel kernel) {
+
+    switch (kernel) {
+        case STATS_SINGLETHREAD: return "singlethread";
+        case STATS_MULTITHREAD: return "multithread";
+        case STATS_MULTITHREAD_3AVX: return "multithread_3avx";
+        case STATS_MULTITHREAD_9AVX: return "multithread_9avx";
+        case STATS_MULTITHREAD_9AVX_PREFETCH: return "multithread_9avx_prefetch";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Helper function to write a counter metric for every kernel.
+ *
+ * @param file The file to write to.
+ * @param name The name of the metric.
+ * @param help The description of the metric.
+ * @param snapshot The statistics.
+ * @param offset The byte offset of the counter in KernelStats.
+ * @param scale Factor applied to the counter (e.g. 1e-9 for seconds).
+*/
+void stats_write_counter(FILE* file, const char* name, const char* help,
+                         const StatsSnapshot* snapshot, size_t offset, double scale) {
+
+    fprintf(file, "# HELP %s %s\n", name, help);
+    fprintf(file, "# TYPE %s counter\n", name);
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        uint64_t value = *(const uint64_t*)((const char*)&snapshot->kernels[k] + offset);
+        if (scale == 1.0) {
+            fprintf(file, "%s{kernel=\"%s\"} %llu\n", name, stats_kernel_name(k), (unsigned long long)value);
+        } else {
+            fprintf(file, "%s{kernel=\"%s\"} %.9f\n", name, stats_kernel_name(k), value * scale);
+        }
+    }
+}
+
+int stats_dump_prometheus(const char* filename) {
+
+    if (!filename) {
+        errno = EINVAL;
+        perror("Error: Missing filename for stats dump");
+        return -1;
+    }
+
+    StatsSnapshot snapshot;
+    stats_snapshot(&snapshot);
+
+    // Write to a temporary file and rename it to make the update atomic
+    size_t tmp_size = strlen(filename) + 5;
+    char* tmp_filename = (char*)malloc(tmp_size);
+    if (!tmp_filename) {
+        perror("Error: Allocation of temporary filename failed");
+        return -1;
+    }
+    snprintf(tmp_filename, tmp_size, "%s.tmp", filename);
+
+    FILE* file = fopen(tmp_filename, "w");
+    if (!file) {
+        perror("Error: Opening stats file failed");
+        free(tmp_filename);
+        return -1;
+    }
+
+    stats_write_counter(file, "matmul_calls_total", "Number of Matrix multiplications.",
+                        &snapshot, offsetof(KernelStats, calls), 1.0);
+    stats_write_counter(file, "matmul_flops_total", "Floating-point operations performed (2nmp per call).",
+                        &snapshot, offsetof(KernelStats, flops), 1.0);
+    stats_write_counter(file, "matmul_b_trans_bytes_total", "Bytes allocated for B transposed.",
+                        &snapshot, offsetof(KernelStats, b_trans_bytes), 1.0);
+    stats_write_counter(file, "matmul_queue_bytes_total", "Bytes allocated for the Task Queue.",
+                        &snapshot, offsetof(KernelStats, queue_bytes), 1.0);
+    stats_write_counter(file, "matmul_thread_busy_seconds_total", "Time the threads spent computing Tasks.",
+                        &snapshot, offsetof(KernelStats, thread_busy_ns), 1e-9);
+    stats_write_counter(file, "matmul_thread_available_seconds_total", "Wall time multiplied by the number of threads.",
+                        &snapshot, offsetof(KernelStats, thread_available_ns), 1e-9);
+
+    // Thread utilization as a gauge (busy / available)
+    fprintf(file, "# HELP matmul_thread_utilization Fraction of the available thread time spent on Tasks.\n");
+    fprintf(file, "# TYPE matmul_thread_utilization gauge\n");
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        const KernelStats* s = &snapshot.kernels[k];
+        double utilization = (s->thread_available_ns > 0) ?
+            (double)s->thread_busy_ns / s->thread_available_ns : 0.0;
+        fprintf(file, "matmul_thread_utilization{kernel=\"%s\"} %.6f\n", stats_kernel_name(k), utilization);
+    }
+
+    // Wall time histogram with cumulative buckets
+    fprintf(file, "# HELP matmul_wall_seconds Wall time per Matrix multiplication.\n");
+    fprintf(file, "# TYPE matmul_wall_seconds histogram\n");
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        const KernelStats* s = &snapshot.kernels[k];
+        const char* name = stats_kernel_name(k);
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < STATS_NUM_BUCKETS - 1; b++) {
+            cumulative += s->wall_buckets[b];
+            fprintf(file, "matmul_wall_seconds_bucket{kernel=\"%s\",le=\"%g\"} %llu\n",
+                    name, STATS_BUCKET_BOUNDS[b], (unsigned long long)cumulative);
+        }
+        cumulative += s->wall_buckets[STATS_NUM_BUCKETS - 1];
+        fprintf(file, "matmul_wall_seconds_bucket{kernel=\"%s\",le=\"+Inf\"} %llu\n",
+                name, (unsigned long long)cumulative);
+        fprintf(file, "matmul_wall_seconds_sum{kernel=\"%s\"} %.9f\n", name, s->wall_ns * 1e-9);
+        fprintf(file, "matmul_wall_seconds_count{kernel=\"%s\"} %llu\n",
+                name, (unsigned long long)s->calls);
+    }
+
+    if (fclose(file) != 0 || rename(tmp_filename, filename) != 0) {
+        perror("Error: Writing stats file failed");
+        free(tmp_filename);
+        return -1;
+    }
+
+    free(tmp_filename);
+    return 0;
+}
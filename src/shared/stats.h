@@ -0,0 +1,135 @@
+/**
+ * @file stats.h
+ *
+ * @brief Contains cumulative runtime statistics for the Matrix
+ * multiplication kernels, intended for monitoring a running process.
+ *
+ * @details
+ * For every kernel the following is accumulated:
+ * - The number of calls and the number of floating-point operations
+ *   (2 * n * m * p per call).
+ * - A histogram of the wall time per call.
+ * - The bytes allocated for the transpose of B and for the Queue.
+ * - The time the worker threads spent computing Tasks (busy) and the
+ *   time they were available (wall time x number of threads). Their
+ *   ratio is the thread utilization.
+ *
+ * The worker threads accumulate their busy time in a local counter and
+ * add it to the shared statistics once, when they run out of Tasks.
+ * All shared counters are updated with relaxed atomic additions, so the
+ * statistics can be updated and read from any thread without locks.
+ *
+ * stats_snapshot() copies the counters into a StatsSnapshot and
+ * stats_dump_prometheus() writes them in the Prometheus text
+ * exposition format (e.g. for the node_exporter textfile collector).
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The kernels that report statistics
+typedef enum {
+    STATS_SINGLETHREAD = 0, // = 0 to be able to loop through enums
+    STATS_MULTITHREAD,
+    STATS_MULTITHREAD_3AVX,
+    STATS_MULTITHREAD_9AVX,
+    STATS_MULTITHREAD_9AVX_PREFETCH,
+    STATS_NUM_KERNELS
+} StatsKernel;
+
+// Upper bounds (in seconds) of the wall time histogram buckets. The
+// last bucket counts every call above the last bound (+Inf).
+#define STATS_NUM_BUCKETS 9
+extern const double STATS_BUCKET_BOUNDS[STATS_NUM_BUCKETS - 1];
+
+typedef struct {
+
+    // Number of calls and floating-point operations
+    uint64_t calls;
+    uint64_t flops;
+
+    // Total wall time and the histogram of the wall time per call
+    uint64_t wall_ns;
+    uint64_t wall_buckets[STATS_NUM_BUCKETS];
+
+    // Bytes allocated for B transposed and the Queue
+    uint64_t b_trans_bytes;
+    uint64_t queue_bytes;
+
+    // Time the threads spent on Tasks and the time they were available
+    uint64_t thread_busy_ns;
+    uint64_t thread_available_ns;
+
+} KernelStats;
+
+typedef struct {
+
+    KernelStats kernels[STATS_NUM_KERNELS];
+
+} StatsSnapshot;
+
+/**
+ * @brief Record a finished call to a kernel.
+ *
+ * @param kernel The kernel that was called.
+ * @param n The row dimension of A and C.
+ * @param m The column dimension of A and row dimension of B.
+ * @param p The column dimension of B and C.
+ * @param num_threads The number of threads used by the call.
+ * @param wall_ns The wall time of the call in nanoseconds.
+*/
+void stats_record_call(StatsKernel kernel, size_t n, size_t m, size_t p,
+                       size_t num_threads, uint64_t wall_ns);
+
+/**
+ * @brief Record the bytes allocated by a call to a kernel.
+ *
+ * @param kernel The kernel that allocated the memory.
+ * @param b_trans_bytes The bytes allocated for B transposed.
+ * @param queue_bytes The bytes allocated for the Queue.
+*/
+void stats_record_bytes(StatsKernel kernel, size_t b_trans_bytes, size_t queue_bytes);
+
+/**
+ * @brief Add the busy time accumulated by a worker thread.
+ *
+ * @param kernel The kernel the thread worked for.
+ * @param busy_ns The time the thread spent computing Tasks.
+*/
+void stats_record_busy(StatsKernel kernel, uint64_t busy_ns);
+
+/**
+ * @brief Copy the current statistics into snapshot.
+ *
+ * @param snapshot Pointer to the StatsSnapshot to fill.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int stats_snapshot(StatsSnapshot* snapshot);
+
+/**
+ * @brief Reset all statistics to zero.
+*/
+void stats_reset();
+
+/**
+ * @brief Retrieve the name of a kernel as used in the Prometheus labels.
+ *
+ * @param kernel The kernel.
+ * @return The name as a static string.
+*/
+const char* stats_kernel_name(StatsKernel kernel);
+
+/**
+ * @brief Write a snapshot of the statistics to filename in the
+ * Prometheus text exposition format. The file is written to a
+ * temporary file first and renamed, so readers never see a partial file.
+ *
+ * @param filename The path of the file to write.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int stats_dump_prometheus(const char* filename);
+
+#endif // STATS_H
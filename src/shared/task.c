@@ -25,6 +25,7 @@ Task task_create(Matrix* A, Matrix* B_trans, Matrix* C, size_t block_size,
     t.C_row_end = C_row_end;
     t.C_col_end = C_col_end;
     t.is_valid = true;
+    t.context = NULL;
 
     return t;
 }
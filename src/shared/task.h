@@ -22,6 +22,9 @@ typedef struct {
     // Validity variable: true = "valid Task" and false = empty or invalid task
     bool is_valid;
 
+    // State shared by the Tasks of one multiplication (kernel specific), or NULL
+    void* context;
+
 } Task;
 
 /**
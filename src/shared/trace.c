@@ -0,0 +1,256 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace.h"
+#include "matrix_utils.h"
+
+// Global tracer state, set by trace_start() and trace_stop()
+bool trace_enabled = false;
+size_t trace_events_per_thread = 0;
+
+// Registry of all ring buffers, protected by trace_registry_lock
+TraceBuffer* trace_registry = NULL;
+size_t trace_next_thread_id = 0;
+pthread_mutex_t trace_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// The ring buffer of the calling thread (NULL until its first event)
+__thread TraceBuffer* trace_local_buffer = NULL;
+
+// Key whose destructor releases the buffer of an exiting thread
+pthread_key_t trace_buffer_key;
+pthread_once_t trace_buffer_key_once = PTHREAD_ONCE_INIT;
+bool trace_buffer_key_created = false;
+
+// Time of trace_start(), used to make the timestamps start at zero
+uint64_t trace_epoch_ns = 0;
+
+/**
+ * @brief Helper function used as the destructor of trace_buffer_key.
+ * Releases the ring buffer of an exiting thread, such that the next
+ * thread to register takes it over. The events are kept.
+ *
+ * @param arg A pointer to the TraceBuffer.
+*/
+void trace_release_thread(void* arg) {
+
+    TraceBuffer* buffer = (TraceBuffer*)arg;
+    pthread_mutex_lock(&trace_registry_lock);
+    buffer->in_use = false;
+    pthread_mutex_unlock(&trace_registry_lock);
+}
+
+/**
+ * @brief Helper function to create trace_buffer_key (once).
+*/
+void trace_create_key() {
+
+    if (pthread_key_create(&trace_buffer_key, trace_release_thread) != 0) {
+        perror("Error: Creating the key of the TraceBuffers failed");
+        return;
+    }
+    trace_buffer_key_created = true;
+}
+
+/**
+ * @brief Helper function to assign a ring buffer to the calling thread:
+ * a released buffer of the registry with the current capacity, or a
+ * new one added to the registry.
+ *
+ * @return A pointer to the buffer, or NULL if an error occured.
+*/
+TraceBuffer* trace_register_thread() {
+
+    pthread_once(&trace_buffer_key_once, trace_create_key);
+
+    // Take over the buffer of a thread that has exited
+    pthread_mutex_lock(&trace_registry_lock);
+    TraceBuffer* buffer = trace_registry;
+    while (buffer && (buffer->in_use || buffer->capacity != trace_events_per_thread)) {
+        buffer = buffer->next;
+    }
+    if (buffer) {
+        buffer->in_use = true;
+    }
+    pthread_mutex_unlock(&trace_registry_lock);
+
+    if (!buffer) {
+        buffer = (TraceBuffer*)malloc(sizeof(TraceBuffer));
+        if (!buffer) {
+            perror("Error: Allocation of TraceBuffer failed");
+            return NULL;
+        }
+
+        buffer->capacity = trace_events_per_thread;
+        buffer->count = 0;
+        buffer->in_use = true;
+        buffer->events = (TraceEvent*)malloc(sizeof(TraceEvent) * buffer->capacity);
+        if (!buffer->events) {
+            perror("Error: Allocation of TraceBuffer events failed");
+            free(buffer);
+            return NULL;
+        }
+
+        // Add the buffer to the registry
+        pthread_mutex_lock(&trace_registry_lock);
+        buffer->thread_id = trace_next_thread_id++;
+        buffer->next = trace_registry;
+        trace_registry = buffer;
+        pthread_mutex_unlock(&trace_registry_lock);
+    }
+
+    // The destructor only runs for threads that exit with a non-NULL value
+    if (trace_buffer_key_created) {
+        pthread_setspecific(trace_buffer_key, buffer);
+    }
+
+    return buffer;
+}
+
+int trace_start(size_t events_per_thread) {
+
+    if (events_per_thread == 0) {
+        errno = EINVAL;
+        perror("Error: The number of events per thread has to be greater than 0");
+        return -1;
+    }
+
+    trace_events_per_thread = events_per_thread;
+    trace_epoch_ns = now_ns();
+    trace_enabled = true;
+
+    return 0;
+}
+
+void trace_stop() {
+    trace_enabled = false;
+}
+
+bool trace_is_enabled() {
+    return trace_enabled;
+}
+
+uint64_t trace_begin() {
+
+    if (!trace_enabled) {
+        return 0;
+    }
+    return now_ns();
+}
+
+void trace_end(uint64_t start_ns, const char* name, const char* category,
+               long arg0, long arg1) {
+
+    if (!trace_enabled || start_ns == 0) {
+        return;
+    }
+    uint64_t end_ns = now_ns();
+
+    if (!trace_local_buffer) {
+        trace_local_buffer = trace_register_thread();
+        if (!trace_local_buffer) {
+            return;
+        }
+    }
+    TraceBuffer* buffer = trace_local_buffer;
+
+    // Overwrite the oldest event if the ring buffer is full
+    TraceEvent* e = &buffer->events[buffer->count % buffer->capacity];
+    e->name = name;
+    e->category = category;
+    e->start_ns = start_ns;
+    e->duration_ns = end_ns - start_ns;
+    e->arg0 = arg0;
+    e->arg1 = arg1;
+    buffer->count++;
+}
+
+size_t trace_num_buffers() {
+
+    size_t num_buffers = 0;
+    pthread_mutex_lock(&trace_registry_lock);
+    for (TraceBuffer* buffer = trace_registry; buffer; buffer = buffer->next) {
+        num_buffers++;
+    }
+    pthread_mutex_unlock(&trace_registry_lock);
+
+    return num_buffers;
+}
+
+int trace_dump_chrome_json(const char* filename) {
+
+    if (!filename) {
+        errno = EINVAL;
+        perror("Error: Missing filename for trace dump");
+        return -1;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        perror("Error: Opening trace file failed");
+        return -1;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+
+    pthread_mutex_lock(&trace_registry_lock);
+    for (TraceBuffer* buffer = trace_registry; buffer; buffer = buffer->next) {
+
+        // Name the thread in the viewer
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+                "\"args\":{\"name\":\"thread %zu\"}}",
+                first ? "" : ",\n", buffer->thread_id, buffer->thread_id);
+        first = false;
+
+        // Oldest event first, in case the ring buffer has wrapped
+        size_t num_events = (buffer->count < buffer->capacity) ? buffer->count : buffer->capacity;
+        size_t oldest = buffer->count - num_events;
+        for (size_t i = 0; i < num_events; i++) {
+
+            TraceEvent* e = &buffer->events[(oldest + i) % buffer->capacity];
+
+            // Chrome expects microseconds
+            double ts_us = (double)(e->start_ns - trace_epoch_ns) / 1000.0;
+            double dur_us = (double)e->duration_ns / 1000.0;
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+                    "\"dur\":%.3f,\"pid\":1,\"tid\":%zu,\"args\":{\"row\":%ld,\"col\":%ld}}",
+                    e->name, e->category, ts_us, dur_us, buffer->thread_id,
+                    e->arg0, e->arg1);
+        }
+    }
+    pthread_mutex_unlock(&trace_registry_lock);
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    if (fclose(file) != 0) {
+        perror("Error: Closing trace file failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+void trace_free() {
+
+    trace_enabled = false;
+
+    pthread_mutex_lock(&trace_registry_lock);
+    TraceBuffer* buffer = trace_registry;
+    while (buffer) {
+        TraceBuffer* next = buffer->next;
+        free(buffer->events);
+        free(buffer);
+        buffer = next;
+    }
+    trace_registry = NULL;
+    trace_next_thread_id = 0;
+    pthread_mutex_unlock(&trace_registry_lock);
+
+    // Only the calling thread's pointer can be cleared here. Other
+    // threads must have exited (see the note in trace.h).
+    trace_local_buffer = NULL;
+    if (trace_buffer_key_created) {
+        pthread_setspecific(trace_buffer_key, NULL);
+    }
+}
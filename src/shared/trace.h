@@ -0,0 +1,147 @@
+/**
+ * @file trace.h
+ *
+ * @brief Contains an opt-in tracer that records timestamped events per
+ * thread and exports them in the Chrome trace-event JSON format, which
+ * can be loaded into Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * @details
+ * Each thread records into its own ring buffer, so recording an event
+ * never takes a lock. The buffer is assigned (under a mutex) the first
+ * time a thread records an event. The buffers outlive the threads such
+ * that the worker threads of a multiplication can be dumped after they
+ * have been joined. When a thread exits, its buffer is released and
+ * taken over by the next thread that records an event, which appends to
+ * the same "tid". The number of buffers is thus the largest number of
+ * threads recording at once, not the number of threads ever created. If
+ * a ring buffer is full, the oldest events are overwritten.
+ *
+ * Every event is a "complete" event (ph = "X") with a start time, a
+ * duration and two integer arguments (e.g. the tile coordinates of a
+ * Task). Usage:
+ *
+ *     uint64_t start = trace_begin();
+ *     ... work ...
+ *     trace_end(start, "task", "compute", C_row_start, C_col_start);
+ *
+ * When tracing is disabled, trace_begin() and trace_end() return after
+ * checking a single flag. The kernels only trace per Task and per phase,
+ * never per element, so the overhead is negligible.
+ *
+ * @note The name and category strings are stored as pointers and must
+ * be string literals (or otherwise outlive the tracer).
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+
+    // Static strings describing the event
+    const char* name;
+    const char* category;
+
+    // Start time and duration in nanoseconds
+    uint64_t start_ns;
+    uint64_t duration_ns;
+
+    // Event specific arguments (e.g. tile coordinates)
+    long arg0;
+    long arg1;
+
+} TraceEvent;
+
+typedef struct TraceBuffer {
+
+    // The next registered buffer (NULL if this is the last one)
+    struct TraceBuffer* next;
+
+    // The id of the thread that owns the buffer (Chrome "tid")
+    size_t thread_id;
+
+    // The ring buffer of events
+    TraceEvent* events;
+
+    // The capacity of the ring buffer (in events)
+    size_t capacity;
+
+    // The total number of events recorded (may exceed capacity)
+    size_t count;
+
+    // Whether a running thread records into the buffer
+    bool in_use;
+
+} TraceBuffer;
+
+/**
+ * @brief Enable tracing. Every thread that records an event gets a
+ * ring buffer holding events_per_thread events.
+ *
+ * @param events_per_thread The capacity of each ring buffer.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int trace_start(size_t events_per_thread);
+
+/**
+ * @brief Disable tracing. The recorded events are kept until
+ * trace_free() is called.
+*/
+void trace_stop();
+
+/**
+ * @brief Determine if tracing is enabled.
+ *
+ * @return true if tracing is enabled.
+*/
+bool trace_is_enabled();
+
+/**
+ * @brief Retrieve the start time of an event.
+ *
+ * @return The current time in nanoseconds, or 0 if tracing is disabled.
+*/
+uint64_t trace_begin();
+
+/**
+ * @brief Record a complete event from start_ns until now into the
+ * ring buffer of the calling thread. Does nothing if tracing is
+ * disabled or if start_ns is 0.
+ *
+ * @param start_ns The start time returned by trace_begin().
+ * @param name The name of the event.
+ * @param category The category of the event.
+ * @param arg0 The first event argument (exported as "row").
+ * @param arg1 The second event argument (exported as "col").
+*/
+void trace_end(uint64_t start_ns, const char* name, const char* category,
+               long arg0, long arg1);
+
+/**
+ * @brief Determine the number of ring buffers in the registry.
+ *
+ * @return The number of buffers.
+*/
+size_t trace_num_buffers();
+
+/**
+ * @brief Write every recorded event to filename as Chrome trace-event
+ * JSON. Tracing should be stopped (or all traced threads joined)
+ * before dumping.
+ *
+ * @param filename The path of the JSON file to write.
+ * @return A value of zero for success and -1 if an error occured.
+*/
+int trace_dump_chrome_json(const char* filename);
+
+/**
+ * @brief Disable tracing and free every ring buffer.
+ *
+ * @note Must not be called while traced threads are still running.
+*/
+void trace_free();
+
+#endif // TRACE_H
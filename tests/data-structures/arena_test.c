@@ -0,0 +1,56 @@
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_arena.h"
+#include <stdint.h>
+#include <stdio.h>
+
+void print_stats(Arena* a) {
+
+    size_t num_slabs = 0;
+    for (ArenaSlab* slab = a->head; slab; slab = slab->next) {
+        num_slabs++;
+    }
+
+    printf("%s\n", "Arena stats");
+    printf("%s %zu\n", "slabs", num_slabs);
+    printf("%s %zu\n", "slab_size", a->slab_size);
+    printf("%s %zu\n", "offset", a->offset);
+    printf("%s %d\n", "current is head", a->current == a->head);
+    printf("\n");
+}
+
+int main() {
+
+    printf("%s\n\n", "--------STARTING arena_test.c--------");
+
+    printf("%s\n", "Creating the arena");
+    Arena* a = arena_create(1024);
+    print_stats(a);
+
+    printf("%s\n", "Creating a zero Matrix in the arena");
+    Matrix* m1 = matrix_create_with_arena(a, pattern_zero, NULL, 3, 2);
+    matrix_print(m1);
+    printf("%s %d\n", "values 64-byte aligned", ((uintptr_t)m1->values % 64) == 0);
+    print_stats(a);
+
+    printf("%s\n", "Creating a Matrix larger than a slab");
+    int rand_args[2] = {10, 20};
+    Matrix* m2 = matrix_create_with_arena(a, pattern_random_between, rand_args, 20, 20);
+    printf("%s %d\n", "values 64-byte aligned", ((uintptr_t)m2->values % 64) == 0);
+    print_stats(a);
+
+    printf("%s\n", "matrix_free() on an arena Matrix is a no-op");
+    printf("%s %d\n", "matrix_free returned", matrix_free(m2));
+
+    printf("%s\n", "Resetting the arena (slabs are kept)");
+    arena_reset(a);
+    print_stats(a);
+
+    printf("%s\n", "Reusing the arena after the reset");
+    Matrix* m3 = matrix_create_with_arena(a, pattern_zero, NULL, 2, 2);
+    printf("%s %d\n", "reuses first allocation", m3 == m1);
+    print_stats(a);
+
+    arena_free(a);
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/huge_page.h"
+#include <stdint.h>
+#include <stdio.h>
+
+int main() {
+
+    printf("%s\n\n", "--------STARTING huge_page_test.c--------");
+
+    printf("%s\n", "Creating a large Matrix without huge pages");
+    Matrix* m1 = matrix_create_with(pattern_zero, NULL, 1024, 1024);
+    printf("%s %zu\n", "mapped_size", m1->mapped_size);
+    matrix_free(m1);
+
+    printf("%s\n", "Creating a large Matrix with huge pages");
+    matrix_set_huge_pages(true);
+    Matrix* m2 = matrix_create_with(pattern_zero, NULL, 1024, 1024);
+    printf("%s %zu\n", "mapped_size", m2->mapped_size);
+    printf("%s %d\n", "values 2 MB aligned", ((uintptr_t)m2->values % HUGE_PAGE_SIZE) == 0);
+    m2->values[1024 * 1024 - 1] = 1.0;
+    printf("%s %d\n", "matrix_free returned", matrix_free(m2));
+
+    printf("%s\n", "Creating a small Matrix with huge pages (falls back)");
+    Matrix* m3 = matrix_create_with(pattern_zero, NULL, 10, 10);
+    printf("%s %zu\n", "mapped_size", m3->mapped_size);
+    matrix_free(m3);
+    matrix_set_huge_pages(false);
+
+    return 0;
+}
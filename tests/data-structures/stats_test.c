@@ -0,0 +1,62 @@
+#include "../../src/shared/stats.h"
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_singlethread.h"
+#include "../../src/cpu/matrix_multithread_9avx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+int main() {
+
+    printf("%s\n\n", "--------STARTING stats_test.c--------");
+
+    int rand_args[] = {-10, 10};
+    Matrix* A = matrix_create_with(pattern_random_between, rand_args, 100, 50);
+    Matrix* B = matrix_create_with(pattern_random_between, rand_args, 50, 80);
+    Matrix* C = matrix_create_with(pattern_zero, NULL, 100, 80);
+
+    printf("%s\n", "Running 2 singlethread and 3 multithread_9avx multiplications");
+    stats_reset();
+    for (int i = 0; i < 2; i++) {
+        matrix_singlethread_mult(A, B, C, 32);
+    }
+    for (int i = 0; i < 3; i++) {
+        matrix_multithread_mult_9avx(A, B, C, 32, 4);
+    }
+
+    StatsSnapshot snapshot;
+    stats_snapshot(&snapshot);
+    for (size_t k = 0; k < STATS_NUM_KERNELS; k++) {
+        KernelStats* s = &snapshot.kernels[k];
+        if (s->calls == 0) {
+            continue;
+        }
+        printf("%-28s calls %llu flops %llu b_trans_bytes %llu utilization %s\n",
+               stats_kernel_name(k), (unsigned long long)s->calls,
+               (unsigned long long)s->flops, (unsigned long long)s->b_trans_bytes,
+               (s->thread_busy_ns <= s->thread_available_ns) ? "<= 1" : "> 1");
+    }
+
+    // Dump into a temporary file, which is removed again
+    char path[] = "/tmp/stats_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("Error: mkstemp failed");
+        return 1;
+    }
+    close(fd);
+    printf("%s\n", "Dumping the statistics into a temporary file");
+    printf("%s %d\n", "stats_dump_prometheus returned", stats_dump_prometheus(path));
+    unlink(path);
+
+    printf("%s\n", "Resetting the statistics");
+    stats_reset();
+    stats_snapshot(&snapshot);
+    printf("%s %llu\n", "multithread_9avx calls", (unsigned long long)snapshot.kernels[STATS_MULTITHREAD_9AVX].calls);
+
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(C);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "../../src/shared/trace.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Keeps both threads of a round alive until each has recorded an event
+pthread_barrier_t barrier;
+
+void* record_events(void* arg) {
+
+    long id = (long)arg;
+    uint64_t first = trace_begin();
+    trace_end(first, "first", "test", id, -1);
+    pthread_barrier_wait(&barrier);
+    for (long i = 0; i < 10; i++) {
+        uint64_t start = trace_begin();
+        trace_end(start, "event", "test", id, i);
+    }
+    return NULL;
+}
+
+int main() {
+
+    printf("%s\n\n", "--------STARTING trace_test.c--------");
+
+    printf("%s\n", "Recording while disabled (nothing is stored)");
+    printf("%s %llu\n", "trace_begin returned", (unsigned long long)trace_begin());
+
+    printf("%s\n", "Recording 11 events in 2 threads with ring buffers of 4 events");
+    pthread_barrier_init(&barrier, NULL, 2);
+    trace_start(4);
+    pthread_t threads[2];
+    for (long i = 0; i < 2; i++) {
+        pthread_create(&threads[i], NULL, record_events, (void*)i);
+    }
+    for (long i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    trace_stop();
+
+    printf("%s\n", "Recording 3 more rounds of 2 threads (the exited threads' buffers are reused)");
+    trace_start(4);
+    for (long round = 0; round < 3; round++) {
+        for (long i = 0; i < 2; i++) {
+            pthread_create(&threads[i], NULL, record_events, (void*)i);
+        }
+        for (long i = 0; i < 2; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    trace_stop();
+    printf("%s %zu\n", "trace_num_buffers returned", trace_num_buffers());
+
+    // Dump into a temporary file, which is removed again
+    char path[] = "/tmp/trace_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd == -1) {
+        perror("Error: mkstemp failed");
+        return 1;
+    }
+    close(fd);
+    printf("%s\n", "Dumping into a temporary file (last 4 events per buffer)");
+    printf("%s %d\n", "trace_dump_chrome_json returned", trace_dump_chrome_json(path));
+    unlink(path);
+    trace_free();
+    printf("%s %zu\n", "trace_num_buffers after trace_free returned", trace_num_buffers());
+    pthread_barrier_destroy(&barrier);
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file matrix_expr_verification.c
+ *
+ * @brief Verifies matrix_multithread_eval_expr() on random dimensions
+ * against the same expressions evaluated step by step with
+ * matrix_mult_naive(): a fused alpha * (A x B) + C x D + bias, independent
+ * products (A x B) x (C x D), a product used twice, a chain of products
+ * that reuses an intermediate Matrix, and an input alone. The number of
+ * allocations, reused buffers, passes and levels are checked too.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_arena.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_expr.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief The product X x Y in a new Matrix.
+ */
+Matrix* product(Matrix* X, Matrix* Y) {
+
+    Matrix* P = matrix_create_with(pattern_zero, NULL, X->num_rows, Y->num_cols);
+    matrix_mult_naive(X, Y, P);
+    return P;
+}
+
+/**
+ * @brief Add coef * Y to X, or coef * the row Y to every row of X if
+ * Y has a single row.
+ */
+void add_scaled(Matrix* X, Matrix* Y, double coef) {
+
+    for (size_t i = 0; i < X->num_rows; i++) {
+        for (size_t j = 0; j < X->num_cols; j++) {
+            size_t y_row = (Y->num_rows == 1) ? 0 : i;
+            X->values[i * X->stride + j] += coef * Y->values[y_row * Y->stride + j];
+        }
+    }
+}
+
+/**
+ * @brief Check the evaluation of root against the expected Matrix and
+ * the statistics of the graph.
+ *
+ * @return A value of zero if everything matches and 1 otherwise.
+ */
+int check(const char* name, ExprGraph* g, ExprNode* root, Matrix* expected, Arena* workspace,
+          size_t block_size, size_t NUM_THREADS, size_t allocations, size_t reused, size_t levels) {
+
+    // The value is added to C, which starts with ones
+    Matrix* C = matrix_create_with(pattern_zero, NULL, expected->num_rows, expected->num_cols);
+    for (size_t i = 0; i < C->num_rows; i++) {
+        for (size_t j = 0; j < C->num_cols; j++) {
+            C->values[i * C->stride + j] = 1.0;
+        }
+    }
+
+    if (matrix_multithread_eval_expr(g, root, C, workspace, block_size, NUM_THREADS) != 0) {
+        printf("Error: The evaluation of %s failed!\n", name);
+        return 1;
+    }
+
+    // The values are integers, so the results have to be exact
+    for (size_t i = 0; i < C->num_rows; i++) {
+        for (size_t j = 0; j < C->num_cols; j++) {
+            double mine = C->values[i * C->stride + j];
+            double eager = expected->values[i * expected->stride + j] + 1.0;
+            if (mine != eager) {
+                printf("Error: %s differs at (%zu, %zu)!\n", name, i, j);
+                printf("%-20s %f\n", "My implementation", mine);
+                printf("%-20s %f\n", "Step by step", eager);
+                return 1;
+            }
+        }
+    }
+
+    if (g->allocations != allocations || g->reused != reused || g->levels != levels) {
+        printf("Error: %s took %zu allocations, %zu reused and %zu levels instead of %zu, %zu and %zu!\n",
+               name, g->allocations, g->reused, g->levels, allocations, reused, levels);
+        return 1;
+    }
+
+    matrix_free(C);
+    return 0;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_expr_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 8;
+    const size_t NUM_THREADS = 4;
+
+    // Matrix generation parameters (small values keep the results exact)
+    const double MIN = -3.0;
+    const double MAX = 3.0;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 70;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    Arena* workspace = arena_create(1 << 20);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions and the block size
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t k = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t block_size = random_between(1, 64);
+        const double alpha = random_between(-3, 3);
+        Arena* used = (i % 2 == 0) ? workspace : NULL;
+        printf("Iteration %zu (n %zu, m %zu, k %zu, p %zu, block size %zu)\n", i, n, m, k, p, block_size);
+
+        Matrix* A = generate_matrix(MIN, MAX, n, m);
+        Matrix* B = generate_matrix(MIN, MAX, m, k);
+        Matrix* D = generate_matrix(MIN, MAX, k, p);
+        Matrix* E = generate_matrix(MIN, MAX, k, k);
+        Matrix* F = generate_matrix(MIN, MAX, n, k);
+        Matrix* bias = generate_matrix(MIN, MAX, 1, k);
+
+        ExprGraph* g = expr_graph_create();
+        ExprNode* a = expr_input(g, A);
+        ExprNode* b = expr_input(g, B);
+        ExprNode* d = expr_input(g, D);
+        ExprNode* e = expr_input(g, E);
+        ExprNode* f = expr_input(g, F);
+        ExprNode* r = expr_input(g, bias);
+
+        // alpha * (A x B) + F x E + bias is a single fused node
+        ExprNode* fused = expr_add_row(g, expr_add(g, expr_scale(g, alpha, expr_mult(g, a, b)), expr_mult(g, f, e)), r);
+        Matrix* expected = product(A, B);
+        Matrix* FE = product(F, E);
+        for (size_t x = 0; x < n * expected->stride; x++) {
+            expected->values[x] *= alpha;
+        }
+        add_scaled(expected, FE, 1.0);
+        add_scaled(expected, bias, 1.0);
+        if (check("alpha * (A x B) + F x E + bias", g, fused, expected, used, block_size, NUM_THREADS, 0, 0, 1) != 0) {
+            return 1;
+        }
+        if (g->passes != 1 || g->eager_allocations != 5 || g->eager_passes != 10) {
+            printf("%s\n", "Error: The fused expression does not take a single pass!");
+            return 1;
+        }
+        matrix_free(expected);
+        matrix_free(FE);
+
+        // (A x B) x (E x D): two independent products, then their product
+        ExprNode* independent = expr_mult(g, expr_mult(g, a, b), expr_mult(g, e, d));
+        Matrix* AB = product(A, B);
+        Matrix* ED = product(E, D);
+        expected = product(AB, ED);
+        if (check("(A x B) x (E x D)", g, independent, expected, used, block_size, NUM_THREADS, 2, 0, 2) != 0) {
+            return 1;
+        }
+        matrix_free(expected);
+        matrix_free(ED);
+
+        // S = A x B used twice: S x E - 2 * S
+        ExprNode* s = expr_mult(g, a, b);
+        ExprNode* shared = expr_add(g, expr_mult(g, s, e), expr_scale(g, -2.0, s));
+        expected = product(AB, E);
+        add_scaled(expected, AB, -2.0);
+        if (check("S x E - 2 * S", g, shared, expected, used, block_size, NUM_THREADS, 1, 0, 2) != 0) {
+            return 1;
+        }
+        matrix_free(expected);
+
+        // (((A x B) x E) x E) x E: the third product reuses the Matrix of the first
+        ExprNode* chain = expr_mult(g, expr_mult(g, expr_mult(g, expr_mult(g, a, b), e), e), e);
+        Matrix* ABE = product(AB, E);
+        Matrix* ABEE = product(ABE, E);
+        expected = product(ABEE, E);
+        if (check("(((A x B) x E) x E) x E", g, chain, expected, used, block_size, NUM_THREADS, 2, 1, 4) != 0) {
+            return 1;
+        }
+        matrix_free(expected);
+        matrix_free(ABE);
+        matrix_free(ABEE);
+
+        // An input alone is added to C
+        if (check("F", g, f, F, used, block_size, NUM_THREADS, 0, 0, 1) != 0) {
+            return 1;
+        }
+
+        // Free the allocated data corresponding to this run
+        arena_reset(workspace);
+        expr_graph_free(g);
+        matrix_free(AB);
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(D);
+        matrix_free(E);
+        matrix_free(F);
+        matrix_free(bias);
+    }
+
+    arena_free(workspace);
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_expr_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file matrix_factor_verification.c
+ *
+ * @brief Verifies matrix_multithread_lu() and matrix_multithread_cholesky()
+ * by reconstructing the factored Matrix (P * A = L * U and A = L * L^T)
+ * with OpenBLAS, and the solves by the residual A * X - B.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_factor.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief Largest absolute difference between X and Y relative to the
+ * largest absolute value in Y.
+ */
+double max_relative_difference(Matrix* X, Matrix* Y) {
+
+    double max_difference = 0.0;
+    double max_value = 0.0;
+    for (size_t i = 0; i < X->num_rows; i++) {
+        for (size_t j = 0; j < X->num_cols; j++) {
+            double y = Y->values[i * Y->stride + j];
+            double difference = fabs(X->values[i * X->stride + j] - y);
+            if (difference > max_difference) { max_difference = difference; }
+            if (fabs(y) > max_value) { max_value = fabs(y); }
+        }
+    }
+    return (max_value > 0) ? max_difference / max_value : max_difference;
+}
+
+/**
+ * @brief Copy the values of Source into Destination (same dimensions).
+ */
+void copy_matrix(Matrix* Source, Matrix* Destination) {
+
+    for (size_t i = 0; i < Source->num_rows; i++) {
+        for (size_t j = 0; j < Source->num_cols; j++) {
+            Destination->values[i * Destination->stride + j] = Source->values[i * Source->stride + j];
+        }
+    }
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_factor_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 8;
+    const size_t BLOCK_SIZE = 32;
+    const size_t NUM_THREADS = 4;
+    // Relative error allowed in the reconstruction and the residual
+    const double APPROXIMATION_THRESHOLD = 1e-10;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+2;
+    const double VALUES_MAX = 1e+2;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 250;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        bool is_cholesky = (i % 2 == 1);
+
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, 20);
+        printf("Iteration %zu (n %zu, p %zu, %s)\n", i, n, p, is_cholesky ? "cholesky" : "lu");
+
+        // Cholesky needs a symmetric positive definite Matrix: G * G^T + n * I
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+        if (is_cholesky) {
+            Matrix* G = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, n, n, n, 1.0,
+                        G->values, G->stride, G->values, G->stride, 0.0, A->values, A->stride);
+            for (size_t d = 0; d < n; d++) {
+                A->values[d * A->stride + d] += n;
+            }
+            matrix_free(G);
+        }
+        Matrix* F = matrix_create_with(pattern_zero, NULL, n, n);
+        Matrix* L = matrix_create_with(pattern_zero, NULL, n, n);
+        Matrix* U = matrix_create_with(pattern_zero, NULL, n, n);
+        Matrix* R = matrix_create_with(pattern_zero, NULL, n, n);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, p);
+        Matrix* X = matrix_create_with(pattern_zero, NULL, n, p);
+        Matrix* AX = matrix_create_with(pattern_zero, NULL, n, p);
+        size_t* pivots = malloc(n * sizeof(size_t));
+        copy_matrix(A, F);
+        copy_matrix(B, X);
+
+        // Factor and split into L and U (U = L^T for Cholesky)
+        int result = is_cholesky
+            ? matrix_multithread_cholesky(F, BLOCK_SIZE, NUM_THREADS)
+            : matrix_multithread_lu(F, pivots, BLOCK_SIZE, NUM_THREADS);
+        if (result != 0) {
+            printf("Error: The factorization failed (%d)\n", result);
+            return 1;
+        }
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < n; c++) {
+                double value = F->values[r * F->stride + c];
+                if (is_cholesky) {
+                    if (c > r && value != 0.0) {
+                        printf("Error: The upper triangle of L is not zero at (%zu, %zu)\n", r, c);
+                        return 1;
+                    }
+                    L->values[r * L->stride + c] = value;
+                    U->values[c * U->stride + r] = value;
+                } else {
+                    L->values[r * L->stride + c] = (c < r) ? value : (c == r) ? 1.0 : 0.0;
+                    U->values[r * U->stride + c] = (c >= r) ? value : 0.0;
+                }
+            }
+        }
+
+        // Reference: A for Cholesky, P * A for LU
+        Matrix* PA = matrix_create_with(pattern_zero, NULL, n, n);
+        copy_matrix(A, PA);
+        if (!is_cholesky) {
+            for (size_t r = 0; r < n; r++) {
+                if (pivots[r] < r || pivots[r] >= n) {
+                    printf("Error: Invalid pivot %zu at step %zu\n", pivots[r], r);
+                    return 1;
+                }
+                for (size_t c = 0; c < n; c++) {
+                    double temp = PA->values[r * PA->stride + c];
+                    PA->values[r * PA->stride + c] = PA->values[pivots[r] * PA->stride + c];
+                    PA->values[pivots[r] * PA->stride + c] = temp;
+                }
+            }
+        }
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0,
+                    L->values, L->stride, U->values, U->stride, 0.0, R->values, R->stride);
+        double reconstruction_error = max_relative_difference(R, PA);
+        if (reconstruction_error > APPROXIMATION_THRESHOLD) {
+            printf("Error: The factors do not reconstruct the Matrix (error %g)\n", reconstruction_error);
+            return 1;
+        }
+
+        // Solve and check the residual
+        result = is_cholesky
+            ? matrix_cholesky_solve(F, X, BLOCK_SIZE, NUM_THREADS)
+            : matrix_lu_solve(F, pivots, X, BLOCK_SIZE, NUM_THREADS);
+        if (result != 0) {
+            printf("Error: The solve failed\n");
+            return 1;
+        }
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, p, n, 1.0,
+                    A->values, A->stride, X->values, X->stride, 0.0, AX->values, AX->stride);
+        double residual = max_relative_difference(AX, B);
+        if (residual > APPROXIMATION_THRESHOLD * n) {
+            printf("Error: The residual of the solve is too large (%g)\n", residual);
+            return 1;
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(F);
+        matrix_free(L);
+        matrix_free(U);
+        matrix_free(R);
+        matrix_free(PA);
+        matrix_free(B);
+        matrix_free(X);
+        matrix_free(AX);
+        free(pivots);
+    }
+
+    // A Matrix that is not positive definite has to be rejected
+    double not_positive_definite[] = {1.0, 2.0, 2.0, 1.0};
+    Matrix* N = matrix_create_from_1D_array(2, 2, not_positive_definite);
+    if (matrix_multithread_cholesky(N, BLOCK_SIZE, NUM_THREADS) != 1) {
+        printf("Error: A Matrix that is not positive definite was not rejected\n");
+        return 1;
+    }
+    matrix_free(N);
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_factor_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file matrix_mult_bit_verification.c
+ *
+ * @brief Verifies the MatrixBit conversions, matrix_multithread_mult_bit()
+ * and matrix_multithread_count_bit() against naive loops on the double
+ * matrices. C starts with random bits to check that the or-and product
+ * is or-ed into C, the counts have to be exact.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_bit.h"
+#include "../../src/shared/matrix_quant.h"
+#include "../../src/cpu/matrix_multithread_bit.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief Generate a Matrix of 0.0 and (non-zero) random values, of which
+ * about density percent are non-zero.
+*/
+Matrix* generate_boolean(size_t rows, size_t cols, int density) {
+
+    Matrix* M = generate_matrix(1, 9, rows, cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (rand() % 100 >= density) {
+                M->values[r * M->stride + c] = 0.0;
+            }
+        }
+    }
+    return M;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_bit_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t BLOCK_SIZE = 48;
+    const size_t NUM_THREADS = 4;
+
+    // Matrix generation parameters
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 1200;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions (the first run crosses several tiles of BIT_TILE_WORDS)
+        const size_t n = (i == 0) ? 70 : random_between(DIMENSIONS_MIN, DIMENSIONS_MAX / 4);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX / 4);
+        const size_t p = (i == 0) ? 2100 : random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const int density = random_between(1, 30);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, density %d%%)\n", i, n, m, p, density);
+
+        Matrix* A = generate_boolean(n, m, density);
+        Matrix* B = generate_boolean(m, p, density);
+        Matrix* C_initial = generate_boolean(n, p, 5);
+
+        // The conversions have to keep the pattern of the non-zeros
+        MatrixBit* A_bit = matrix_to_bit(A);
+        MatrixBit* B_bit = matrix_to_bit(B);
+        MatrixBit* C_bit = matrix_to_bit(C_initial);
+        Matrix* A_back = matrix_from_bit(A_bit);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < m; c++) {
+                bool expected = (A->values[r * A->stride + c] != 0.0);
+                if (A_back->values[r * A_back->stride + c] != (double)expected ||
+                    matrix_bit_get(A_bit, r, c) != expected) {
+                    printf("Error: The MatrixBit conversion differs at (%zu, %zu)!\n", r, c);
+                    return 1;
+                }
+            }
+        }
+
+        MatrixInt32* C_count = matrix_int32_create(n, p);
+        if (matrix_multithread_mult_bit(A_bit, B_bit, C_bit, BLOCK_SIZE, NUM_THREADS) != 0 ||
+            matrix_multithread_count_bit(A_bit, B_bit, C_count, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: The bit products failed\n");
+            return 1;
+        }
+
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+
+                int32_t count = 0;
+                for (size_t k = 0; k < m; k++) {
+                    count += (A->values[r * A->stride + k] != 0.0 && B->values[k * B->stride + c] != 0.0);
+                }
+                bool expected = (C_initial->values[r * C_initial->stride + c] != 0.0) || count > 0;
+
+                if (matrix_bit_get(C_bit, r, c) != expected) {
+                    printf("Error: The or-and product differs at (%zu, %zu)!\n", r, c);
+                    return 1;
+                }
+                if (C_count->values[r * C_count->stride + c] != count) {
+                    printf("Error: The count differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %d\n", "My implementation", C_count->values[r * C_count->stride + c]);
+                    printf("%-20s %d\n", "Naive", count);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C_initial);
+        matrix_free(A_back);
+        matrix_bit_free(A_bit);
+        matrix_bit_free(B_bit);
+        matrix_bit_free(C_bit);
+        matrix_int32_free(C_count);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_bit_verification.c--------");
+
+    return 0;
+}
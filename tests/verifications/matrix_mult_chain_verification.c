@@ -0,0 +1,171 @@
+/**
+ * @file matrix_mult_chain_verification.c
+ *
+ * @brief Verifies matrix_chain_plan() on the textbook chain of six
+ * matrices, whose cheapest order is known, and
+ * matrix_multithread_mult_chain() on random chains against the left to
+ * right product with matrix_mult_naive(), with and without an Arena as
+ * the workspace. The Arena has to grow by the planned workspace bytes,
+ * which count the intermediate products reused once consumed. A
+ * column-major C has to be rejected.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_arena.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_chain.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_chain_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 12;
+    const size_t NUM_THREADS = 4;
+    const size_t CHAIN_MAX = 6;
+
+    // Matrix generation parameters (small values keep the products exact)
+    const double MIN = -2.0;
+    const double MAX = 2.0;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 40;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    // The textbook chain, whose cheapest order is ((A1 (A2 A3)) ((A4 A5) A6)) with 15125 products
+    const size_t textbook_dims[7] = {30, 35, 15, 5, 10, 20, 25};
+    Matrix* textbook[6];
+    for (size_t i = 0; i < 6; i++) {
+        textbook[i] = matrix_create_with(pattern_zero, NULL, textbook_dims[i], textbook_dims[i + 1]);
+    }
+    ChainPlan* plan = matrix_chain_plan(textbook, 6, NULL);
+    matrix_chain_plan_print(plan);
+    if (plan->planned_flops != 2.0 * 15125 || plan->split[0 * 6 + 5] != 2 || plan->split[0 * 6 + 2] != 0 ||
+        plan->split[3 * 6 + 5] != 4) {
+        printf("%s\n", "Error: The plan of the textbook chain is not the cheapest order!");
+        return 1;
+    }
+
+    // A4 x A5 reuses the Matrix of A2 x A3, so three of the four intermediate products are allocated
+    size_t intermediates[4][2] = {{35, 5}, {30, 5}, {5, 20}, {5, 25}};
+    size_t allocated = 0;
+    for (size_t i = 0; i < 4; i++) {
+        if (i == 2) {
+            continue;
+        }
+        size_t header = (sizeof(Matrix) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        size_t values = sizeof(double) * intermediates[i][0] * matrix_row_stride(intermediates[i][1]);
+        allocated += (header + values + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    }
+    if (plan->workspace_bytes != allocated) {
+        printf("Error: The textbook chain needs %zu workspace bytes instead of %zu!\n", plan->workspace_bytes, allocated);
+        return 1;
+    }
+    matrix_chain_plan_free(plan);
+    for (size_t i = 0; i < 6; i++) {
+        matrix_free(textbook[i]);
+    }
+
+    Arena* workspace = arena_create(1 << 20);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate the chain and the block size
+        const size_t num_matrices = random_between(1, CHAIN_MAX);
+        const size_t block_size = random_between(1, 64);
+        size_t dims[CHAIN_MAX + 1];
+        for (size_t d = 0; d <= num_matrices; d++) {
+            dims[d] = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        }
+        printf("Iteration %zu (%zu matrices, block size %zu)\n", i, num_matrices, block_size);
+
+        Matrix* matrices[CHAIN_MAX];
+        for (size_t m = 0; m < num_matrices; m++) {
+            matrices[m] = generate_matrix(MIN, MAX, dims[m], dims[m + 1]);
+        }
+
+        // The left to right product
+        Matrix* C_naive = matrix_create_with(pattern_zero, NULL, dims[0], dims[1]);
+        for (size_t r = 0; r < dims[0]; r++) {
+            for (size_t c = 0; c < dims[1]; c++) {
+                C_naive->values[r * C_naive->stride + c] = matrices[0]->values[r * matrices[0]->stride + c];
+            }
+        }
+        for (size_t m = 1; m < num_matrices; m++) {
+            Matrix* next = matrix_create_with(pattern_zero, NULL, dims[0], dims[m + 1]);
+            matrix_mult_naive(C_naive, matrices[m], next);
+            matrix_free(C_naive);
+            C_naive = next;
+        }
+
+        plan = matrix_chain_plan(matrices, num_matrices, NULL);
+        if (!plan || plan->planned_cost > plan->naive_cost) {
+            printf("%s\n", "Error: The plan is more expensive than the left to right order!");
+            return 1;
+        }
+
+        // Once with the Arena as the workspace, once with the heap
+        for (size_t with_arena = 0; with_arena < 2; with_arena++) {
+            Matrix* C = matrix_create_with(pattern_zero, NULL, dims[0], dims[num_matrices]);
+            Arena* used = with_arena ? workspace : NULL;
+            if (matrix_multithread_mult_chain(matrices, num_matrices, C, plan, used, block_size, NUM_THREADS) != 0) {
+                printf("%s\n", "Error: matrix_multithread_mult_chain() failed!");
+                return 1;
+            }
+
+            // The values are integers, so the products have to be exact
+            for (size_t r = 0; r < C->num_rows; r++) {
+                for (size_t c = 0; c < C->num_cols; c++) {
+                    double mine = C->values[r * C->stride + c];
+                    double naive = C_naive->values[r * C_naive->stride + c];
+                    if (mine != naive) {
+                        printf("Error: The chain product %s differs at (%zu, %zu)!\n",
+                               with_arena ? "with the Arena" : "without a workspace", r, c);
+                        printf("%-20s %f\n", "My implementation", mine);
+                        printf("%-20s %f\n", "Naive", naive);
+                        return 1;
+                    }
+                }
+            }
+
+            // The Arena grows by the planned bytes exactly
+            if (with_arena && workspace->offset != plan->workspace_bytes) {
+                printf("Error: The chain took %zu bytes of the Arena instead of the planned %zu!\n",
+                       workspace->offset, plan->workspace_bytes);
+                return 1;
+            }
+
+            matrix_free(C);
+        }
+        arena_reset(workspace);
+
+        // matrix_multithread_mult_9avx() cannot write a column-major C
+        Matrix* C_row = matrix_create_with(pattern_zero, NULL, dims[0], dims[num_matrices]);
+        Matrix* C_col = matrix_to_col_major(C_row);
+        if (matrix_multithread_mult_chain(matrices, num_matrices, C_col, plan, NULL, block_size, NUM_THREADS) != -1) {
+            printf("%s\n", "Error: A column-major C was not rejected!");
+            return 1;
+        }
+        matrix_free(C_row);
+        matrix_free(C_col);
+
+        // Free the allocated data corresponding to this run
+        matrix_chain_plan_free(plan);
+        for (size_t m = 0; m < num_matrices; m++) {
+            matrix_free(matrices[m]);
+        }
+        matrix_free(C_naive);
+    }
+
+    arena_free(workspace);
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_chain_verification.c--------");
+
+    return 0;
+}
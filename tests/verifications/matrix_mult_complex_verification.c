@@ -0,0 +1,113 @@
+/**
+ * @file matrix_mult_complex_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_complex() with both methods
+ * against cblas_zgemm on random dimensions. C starts with random values
+ * to verify that the product is added to C.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_complex.h"
+#include "../../src/cpu/matrix_multithread_complex.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief Generate a MatrixComplex with random real and imaginary parts.
+ */
+MatrixComplex* generate_complex(double min, double max, size_t num_rows, size_t num_cols) {
+
+    Matrix* re = generate_matrix(min, max, num_rows, num_cols);
+    Matrix* im = generate_matrix(min, max, num_rows, num_cols);
+    MatrixComplex* M = matrix_complex_from_parts(re, im);
+    matrix_free(re);
+    matrix_free(im);
+    return M;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_complex_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t BLOCK_SIZE = 37;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 200;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        ComplexMethod method = (i % 2 == 0) ? COMPLEX_METHOD_DIRECT : COMPLEX_METHOD_3M;
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, %s)\n", i, n, m, p,
+               (method == COMPLEX_METHOD_3M) ? "3M" : "direct");
+
+        // Generate matrices (C_blas is a copy of C)
+        MatrixComplex* A = generate_complex(VALUES_MIN, VALUES_MAX, n, m);
+        MatrixComplex* B = generate_complex(VALUES_MIN, VALUES_MAX, m, p);
+        MatrixComplex* C = generate_complex(VALUES_MIN, VALUES_MAX, n, p);
+        MatrixComplex* C_blas = matrix_complex_create(n, p);
+        if (!A || !B || !C || !C_blas) {
+            printf("Error: Creating the complex matrices failed\n");
+            return 1;
+        }
+        for (size_t k = 0; k < 2 * n * C->stride; k++) {
+            C_blas->values[k] = C->values[k];
+        }
+
+        if (matrix_multithread_mult_complex(A, B, C, method, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_mult_complex() failed\n");
+            return 1;
+        }
+
+        const double one[2] = {1.0, 0.0};
+        cblas_zgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    n, p, m, one,
+                    A->values, A->stride,
+                    B->values, B->stride,
+                    one, C_blas->values, C_blas->stride);
+
+        // Compare result (both parts, skipping the padding)
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < 2 * p; c++) {
+                double mine = C->values[2 * r * C->stride + c];
+                double blas = C_blas->values[2 * r * C_blas->stride + c];
+                if (fabs(mine - blas) > APPROXIMATION_THRESHOLD * (1.0 + fabs(blas))) {
+                    printf("Error: The complex matrix mult result differs at (%zu, %zu)!\n", r, c / 2);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "BLAS implementation", blas);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_complex_free(A);
+        matrix_complex_free(B);
+        matrix_complex_free(C);
+        matrix_complex_free(C_blas);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_complex_verification.c--------");
+
+    return 0;
+}
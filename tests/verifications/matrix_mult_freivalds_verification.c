@@ -0,0 +1,90 @@
+/**
+ * @file matrix_mult_freivalds_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_9avx() using the O(n^2)
+ * Freivalds check instead of a full OpenBLAS recomputation. Every
+ * iteration also corrupts a single element of C to make sure the
+ * check actually detects a wrong result.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_9avx.h"
+#include "../../src/shared/matrix_utils.h"
+#include "../../src/shared/matrix_verification.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_freivalds_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 20;
+    const size_t BLOCK_SIZE = 128;
+    const size_t NUM_THREADS = 16;
+    const size_t NUM_TRIALS = 3;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+6;
+    const double VALUES_MAX = 1e+6;
+    const size_t DIMENSIONS_MIN = 100;
+    const size_t DIMENSIONS_MAX = 1500;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        printf("Iteration %zu\n", i);
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+
+        // Generate matrices
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, m, p);
+
+        // Allocate C Matrix
+        Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+
+        // Do multithread multiplication followed by the Freivalds check
+        int result = matrix_multithread_mult_9avx_checked(A, B, C, BLOCK_SIZE, NUM_THREADS, NUM_TRIALS);
+        if (result != 0) {
+            printf("Error: Freivalds check rejected a correct result!\n");
+
+            matrix_free(A);
+            matrix_free(B);
+            matrix_free(C);
+
+            return 1;
+        }
+
+        // Corrupt a single element and make sure it is detected
+        size_t index = random_between(0, n * p - 1);
+        C->values[index] += fabs(C->values[index]) + 1.0;
+        result = matrix_verify_freivalds(A, B, C, NUM_TRIALS, FREIVALDS_DEFAULT_TOLERANCE, i);
+        if (result != 1) {
+            printf("Error: Freivalds check did not detect a corrupted element!\n");
+
+            matrix_free(A);
+            matrix_free(B);
+            matrix_free(C);
+
+            return 1;
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_freivalds_verification.c--------");
+
+    return 0;
+}
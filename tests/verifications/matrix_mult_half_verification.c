@@ -0,0 +1,126 @@
+/**
+ * @file matrix_mult_half_verification.c
+ *
+ * @brief Verifies the conversions of matrix_half.h on values with a known
+ * 16-bit representation and matrix_multithread_mult_half() for all
+ * combinations of formats and accumulations against a double reference
+ * computed from the converted inputs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_half.h"
+#include "../../src/cpu/matrix_multithread_half.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_half_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 8;
+    const size_t BLOCK_SIZE = 64;
+    const size_t NUM_THREADS = 4;
+    // Relative error (to the sum of absolute products) allowed per accumulation
+    const double FP32_THRESHOLD = 1e-5;
+    const double FP64_THRESHOLD = 1e-12;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+2;
+    const double VALUES_MAX = 1e+2;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Known conversions (raw value and the double it represents)
+    struct { double x; HalfFormat format; uint16_t raw; double back; } known[] = {
+        {1.0, HALF_BF16, 0x3f80, 1.0},
+        {-2.0, HALF_BF16, 0xc000, -2.0},
+        {0.1, HALF_BF16, 0x3dcd, 0.10009765625},
+        {1.0, HALF_FP16, 0x3c00, 1.0},
+        {-2.0, HALF_FP16, 0xc000, -2.0},
+        {0.1, HALF_FP16, 0x2e66, 0.0999755859375},
+        {65504.0, HALF_FP16, 0x7bff, 65504.0},
+    };
+    for (size_t i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+        uint16_t raw = half_from_double(known[i].x, known[i].format);
+        double back = half_to_double(raw, known[i].format);
+        if (raw != known[i].raw || back != known[i].back) {
+            printf("Error: Converting %g gave 0x%04x (%.17g), expected 0x%04x (%.17g)\n",
+                   known[i].x, raw, back, known[i].raw, known[i].back);
+            return 1;
+        }
+    }
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Cycle through all combinations of formats and accumulations
+        HalfFormat a_format = (i % 2 == 0) ? HALF_BF16 : HALF_FP16;
+        HalfFormat b_format = (i % 4 < 2) ? HALF_BF16 : HALF_FP16;
+        HalfAccumulation accumulation = (i % 8 < 4) ? HALF_ACCUMULATE_FP32 : HALF_ACCUMULATE_FP64;
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        printf("Iteration %zu (n %zu, m %zu, p %zu)\n", i, n, m, p);
+
+        // Generate and convert matrices
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, m, p);
+        MatrixHalf* A_h = matrix_to_half(A, a_format);
+        MatrixHalf* B_h = matrix_to_half(B, b_format);
+        Matrix* A_d = matrix_from_half(A_h);
+        Matrix* B_d = matrix_from_half(B_h);
+        Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+        if (!A_h || !B_h || !A_d || !B_d || !C) {
+            printf("Error: Creating the 16-bit matrices failed\n");
+            return 1;
+        }
+
+        if (matrix_multithread_mult_half(A_h, B_h, C, accumulation, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_mult_half() failed\n");
+            return 1;
+        }
+
+        // Compare against the product of the converted inputs
+        double threshold = (accumulation == HALF_ACCUMULATE_FP64) ? FP64_THRESHOLD : FP32_THRESHOLD;
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double expected = 0.0;
+                double magnitude = 0.0;
+                for (size_t k = 0; k < m; k++) {
+                    double product = A_d->values[r * A_d->stride + k] * B_d->values[k * B_d->stride + c];
+                    expected += product;
+                    magnitude += fabs(product);
+                }
+                double mine = C->values[r * C->stride + c];
+                if (fabs(mine - expected) > threshold * (1.0 + magnitude)) {
+                    printf("Error: The product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Reference", expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(A_d);
+        matrix_free(B_d);
+        matrix_half_free(A_h);
+        matrix_half_free(B_h);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_half_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file matrix_mult_int_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_int() for both supported type
+ * combinations. The integer product has to match a scalar reference
+ * exactly, and the dequantized product (matrix_dequantize_product())
+ * has to match the product of the dequantized inputs. A QUANT_UINT8
+ * value above 127 in A, which would saturate the int16 pair sums, has to
+ * be rejected.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_quant.h"
+#include "../../src/cpu/matrix_multithread_int.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_int_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t BLOCK_SIZE = 64;
+    const size_t NUM_THREADS = 4;
+    // Rounding of the double reference of the dequantized product
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+2;
+    const double VALUES_MAX = 1e+2;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Alternate type combinations and granularities
+        QuantType a_type = (i % 2 == 0) ? QUANT_UINT8 : QUANT_INT16;
+        QuantType b_type = (i % 2 == 0) ? QUANT_INT8 : QUANT_INT16;
+        int a_bits = (i % 2 == 0) ? 7 : 12;
+        int b_bits = (i % 2 == 0) ? 8 : 10;
+        QuantGranularity a_granularity = (i % 4 < 2) ? QUANT_PER_TENSOR : QUANT_PER_ROW;
+        QuantGranularity b_granularity = (i % 4 < 2) ? QUANT_PER_TENSOR : QUANT_PER_COL;
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        printf("Iteration %zu (n %zu, m %zu, p %zu)\n", i, n, m, p);
+
+        // Generate and quantize matrices
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, m, p);
+        QuantMatrix* A_q = matrix_quantize(A, a_type, a_granularity, a_bits);
+        QuantMatrix* B_q = matrix_quantize(B, b_type, b_granularity, b_bits);
+        MatrixInt32* C_int = matrix_int32_create(n, p);
+        if (!A_q || !B_q || !C_int) {
+            printf("Error: Creating the quantized matrices failed\n");
+            return 1;
+        }
+
+        if (matrix_multithread_mult_int(A_q, B_q, C_int, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_mult_int() failed\n");
+            return 1;
+        }
+
+        // Compare the integer product against a scalar reference
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                int64_t expected = 0;
+                for (size_t k = 0; k < m; k++) {
+                    expected += (int64_t)quant_matrix_get(A_q, r, k) * quant_matrix_get(B_q, k, c);
+                }
+                if (C_int->values[r * C_int->stride + c] != expected) {
+                    printf("Error: The integer product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %d\n", "My implementation", C_int->values[r * C_int->stride + c]);
+                    printf("%-20s %lld\n", "Reference", (long long)expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Compare the dequantized product against the product of the dequantized inputs
+        Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+        Matrix* A_dq = matrix_dequantize(A_q);
+        Matrix* B_dq = matrix_dequantize(B_q);
+        matrix_dequantize_product(A_q, B_q, C_int, C);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double expected = 0.0;
+                for (size_t k = 0; k < m; k++) {
+                    expected += A_dq->values[r * A_dq->stride + k] * B_dq->values[k * B_dq->stride + c];
+                }
+                double mine = C->values[r * C->stride + c];
+                if (fabs(mine - expected) > APPROXIMATION_THRESHOLD * (1.0 + fabs(expected))) {
+                    printf("Error: The dequantized product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Reference", expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(A_dq);
+        matrix_free(B_dq);
+        quant_matrix_free(A_q);
+        quant_matrix_free(B_q);
+        matrix_int32_free(C_int);
+    }
+
+    // 255 * 127 * 2 saturates the int16 sums of _mm256_maddubs_epi16
+    QuantMatrix* A_q = quant_matrix_create(QUANT_UINT8, 4, 64, QUANT_PER_TENSOR);
+    QuantMatrix* B_q = quant_matrix_create(QUANT_INT8, 64, 4, QUANT_PER_TENSOR);
+    MatrixInt32* C_int = matrix_int32_create(4, 4);
+    if (!A_q || !B_q || !C_int) {
+        printf("Error: Creating the quantized matrices failed\n");
+        return 1;
+    }
+    ((uint8_t*)A_q->values)[0] = 255;
+    if (matrix_multithread_mult_int(A_q, B_q, C_int, BLOCK_SIZE, NUM_THREADS) != -1) {
+        printf("Error: A QUANT_UINT8 value of 255 in A was not rejected!\n");
+        return 1;
+    }
+    quant_matrix_free(A_q);
+    quant_matrix_free(B_q);
+    matrix_int32_free(C_int);
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_int_verification.c--------");
+
+    return 0;
+}
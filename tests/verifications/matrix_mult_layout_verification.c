@@ -0,0 +1,128 @@
+/**
+ * @file matrix_mult_layout_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_9avx() for the four
+ * combinations of row-major and column-major A and B against
+ * matrix_mult_naive() on the row-major matrices. The column-major
+ * copies are made with matrix_to_col_major(), and one of them is also
+ * wrapped with matrix_create_col_major_from_pointers(). The results
+ * are checked with matrix_verify_freivalds() on the mixed layouts too,
+ * and thread_mult_9avx() is also called directly with a column-major A.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_9avx.h"
+#include "../../src/shared/matrix_utils.h"
+#include "../../src/shared/matrix_verification.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_layout_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 8;
+    const size_t NUM_THREADS = 4;
+    const size_t NUM_COMBINATIONS = 4;
+
+    // Matrix generation parameters
+    const double MIN = -10.0;
+    const double MAX = 10.0;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions and the block size
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t block_size = random_between(1, 64);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, block size %zu)\n", i, n, m, p, block_size);
+
+        Matrix* A = generate_matrix(MIN, MAX, n, m);
+        Matrix* B = generate_matrix(MIN, MAX, m, p);
+        Matrix* C_naive = matrix_create_with(pattern_zero, NULL, n, p);
+        matrix_mult_naive(A, B, C_naive);
+
+        // A column-major A is a copy, B is also wrapped without ownership
+        Matrix* A_col = matrix_to_col_major(A);
+        Matrix* B_col_copy = matrix_to_col_major(B);
+        Matrix* B_col = matrix_create_col_major_from_pointers(m, p, B_col_copy->values);
+        B_col->stride = B_col_copy->stride;
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < m; c++) {
+                if (A_col->values[matrix_index(A_col, r, c)] != A->values[matrix_index(A, r, c)]) {
+                    printf("Error: The column-major copy differs at (%zu, %zu)!\n", r, c);
+                    return 1;
+                }
+            }
+        }
+
+        for (size_t combination = 0; combination < NUM_COMBINATIONS; combination++) {
+
+            Matrix* A_used = (combination & 1) ? A_col : A;
+            Matrix* B_used = (combination & 2) ? B_col : B;
+            Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+            matrix_multithread_mult_9avx(A_used, B_used, C, block_size, NUM_THREADS);
+
+            // The values are integers, so the products have to be exact
+            for (size_t r = 0; r < n; r++) {
+                for (size_t c = 0; c < p; c++) {
+                    double mine = C->values[r * C->stride + c];
+                    double naive = C_naive->values[r * C_naive->stride + c];
+                    if (mine != naive) {
+                        printf("Error: The product of A %s and B %s differs at (%zu, %zu)!\n",
+                               (combination & 1) ? "column-major" : "row-major",
+                               (combination & 2) ? "column-major" : "row-major", r, c);
+                        printf("%-20s %f\n", "My implementation", mine);
+                        printf("%-20s %f\n", "Naive", naive);
+                        return 1;
+                    }
+                }
+            }
+
+            if (matrix_verify_freivalds(A_used, B_used, C, 2, FREIVALDS_DEFAULT_TOLERANCE, seed) != 0) {
+                printf("Error: Freivalds' algorithm rejects the product of combination %zu!\n", combination);
+                return 1;
+            }
+
+            // The tile kernel called directly (outside of a multiplication) with a column-major A
+            if (A_used->layout == MATRIX_COL_MAJOR) {
+                Matrix* C_tile = matrix_create_with(pattern_zero, NULL, n, p);
+                thread_mult_9avx(task_create(A_used, B_used, C_tile, block_size, 0, 0, n, p));
+                for (size_t r = 0; r < n; r++) {
+                    for (size_t c = 0; c < p; c++) {
+                        if (C_tile->values[r * C_tile->stride + c] != C_naive->values[r * C_naive->stride + c]) {
+                            printf("Error: thread_mult_9avx() differs at (%zu, %zu) for combination %zu!\n",
+                                   r, c, combination);
+                            return 1;
+                        }
+                    }
+                }
+                matrix_free(C_tile);
+            }
+
+            matrix_free(C);
+        }
+
+        // Free the allocated data corresponding to this run (B_col does not own its values)
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C_naive);
+        matrix_free(A_col);
+        matrix_free(B_col);
+        matrix_free(B_col_copy);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_layout_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file matrix_mult_oblivious_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_oblivious() against
+ * matrix_mult_naive(). The dimensions range from below the base size of
+ * the recursion to several levels above it, with random thread counts
+ * such that the Morton order split of C is covered as well. C starts
+ * with random values to check that the product is added to C.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_oblivious.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_oblivious_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t NUM_THREADS_MAX = 8;
+
+    // Matrix generation parameters
+    const double MIN = -10.0;
+    const double MAX = 10.0;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 400;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions (the first run is a thin product split over its columns)
+        const size_t n = (i == 0) ? 3 : random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t num_threads = random_between(1, NUM_THREADS_MAX);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, threads %zu)\n", i, n, m, p, num_threads);
+
+        Matrix* A = generate_matrix(MIN, MAX, n, m);
+        Matrix* B = generate_matrix(MIN, MAX, m, p);
+        Matrix* C = generate_matrix(MIN, MAX, n, p);
+        Matrix* C_naive = generate_matrix(MIN, MAX, n, p);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                C_naive->values[r * C_naive->stride + c] = C->values[r * C->stride + c];
+            }
+        }
+
+        if (matrix_multithread_mult_oblivious(A, B, C, num_threads) != 0) {
+            printf("Error: The cache-oblivious multiplication failed\n");
+            return 1;
+        }
+        matrix_mult_naive(A, B, C_naive);
+
+        // The values are integers, so the products have to be exact
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = C->values[r * C->stride + c];
+                double naive = C_naive->values[r * C_naive->stride + c];
+                if (mine != naive) {
+                    printf("Error: The cache-oblivious product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Naive", naive);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(C_naive);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_oblivious_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file matrix_mult_panel_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_9avx() with more threads than
+ * panels of B transposed, where the threads waiting for a panel
+ * transpose its chunks themselves: a single panel (p not larger than
+ * the block size) and two panels with p not a multiple of the block
+ * size, each with many chunks of 64 rows of B. Every product is computed
+ * twice by two concurrent calls, which must not share any panel state.
+ * The results are compared with matrix_mult_naive().
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_9avx.h"
+#include "../../src/shared/matrix_utils.h"
+
+// The rows of B in a chunk of a panel in matrix_multithread_9avx.c
+#define CHUNK_ROWS 64
+
+// The operands of a call to matrix_multithread_mult_9avx() in its own thread
+typedef struct {
+    Matrix* A;
+    Matrix* B;
+    Matrix* C;
+    size_t block_size;
+    size_t num_threads;
+} MultArgs;
+
+void* mult_thread(void* arg) {
+
+    MultArgs* args = (MultArgs*)arg;
+    matrix_multithread_mult_9avx(args->A, args->B, args->C, args->block_size, args->num_threads);
+    return NULL;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_panel_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 8;
+    const size_t NUM_THREADS = 16;
+    const size_t BLOCK_SIZE = 64;
+
+    // Matrix generation parameters
+    const double MIN = -10.0;
+    const double MAX = 10.0;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Even runs have one panel (p <= block size), odd runs two (p not a multiple of it)
+        const size_t n = random_between(BLOCK_SIZE, 300);
+        const size_t m = random_between(4 * CHUNK_ROWS, 12 * CHUNK_ROWS) + 1;
+        const size_t p = (i % 2 == 0) ? (size_t)random_between(1, BLOCK_SIZE)
+                                      : BLOCK_SIZE + random_between(1, BLOCK_SIZE - 1);
+        printf("Iteration %zu (n %zu, m %zu, p %zu)\n", i, n, m, p);
+
+        Matrix* A = generate_matrix(MIN, MAX, n, m);
+        Matrix* B = generate_matrix(MIN, MAX, m, p);
+        Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+        Matrix* C_concurrent = matrix_create_with(pattern_zero, NULL, n, p);
+        Matrix* C_naive = matrix_create_with(pattern_zero, NULL, n, p);
+
+        // Two calls at the same time, each with its own panels of B transposed
+        MultArgs args = {A, B, C_concurrent, BLOCK_SIZE, NUM_THREADS};
+        pthread_t concurrent;
+        if (pthread_create(&concurrent, NULL, mult_thread, &args) != 0) {
+            printf("%s\n", "Error: Creating the concurrent call failed");
+            return 1;
+        }
+        matrix_multithread_mult_9avx(A, B, C, BLOCK_SIZE, NUM_THREADS);
+        pthread_join(concurrent, NULL);
+        matrix_mult_naive(A, B, C_naive);
+
+        // The values are integers, so the products have to be exact
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = C->values[r * C->stride + c];
+                double concurrent_value = C_concurrent->values[r * C_concurrent->stride + c];
+                double naive = C_naive->values[r * C_naive->stride + c];
+                if (mine != naive || concurrent_value != naive) {
+                    printf("Error: The product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Concurrent call", concurrent_value);
+                    printf("%-20s %f\n", "Naive", naive);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(C_concurrent);
+        matrix_free(C_naive);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_panel_verification.c--------");
+
+    return 0;
+}
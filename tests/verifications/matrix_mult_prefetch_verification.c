@@ -0,0 +1,98 @@
+/**
+ * @file matrix_mult_prefetch_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_9avx_prefetch() against
+ * OpenBLAS for every combination of prefetching (including distances
+ * past the block size and past the rows) and streaming stores. The values are integers
+ * small enough for every sum to be exact, so the results have to match
+ * exactly.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_9avx_prefetch.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_prefetch_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t BLOCK_SIZE = 128;
+    const size_t NUM_THREADS = 16;
+    const size_t PREFETCH_DISTANCES[] = {0, 64, 192, 1024};
+    const size_t NUM_DISTANCES = sizeof(PREFETCH_DISTANCES) / sizeof(PREFETCH_DISTANCES[0]);
+    const bool STREAMING_STORES[] = {false, true};
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+6;
+    const double VALUES_MAX = 1e+6;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 700;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        printf("Iteration %zu\n", i);
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+
+        // Generate matrices
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, m, p);
+
+        // Reference result
+        Matrix* C_ref = matrix_create_with(pattern_zero, NULL, n, p);
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    n, p, m, 1.0,
+                    A->values, A->stride,
+                    B->values, B->stride,
+                    0.0, C_ref->values, C_ref->stride);
+
+        for (size_t d = 0; d < NUM_DISTANCES; d++) {
+            for (size_t s = 0; s < 2; s++) {
+
+                Matrix* C = matrix_create_with(pattern_zero, NULL, n, p);
+                matrix_multithread_mult_9avx_prefetch(A, B, C, BLOCK_SIZE, NUM_THREADS,
+                                                      PREFETCH_DISTANCES[d], STREAMING_STORES[s]);
+
+                // Compare result
+                for (size_t j = 0; j < n * C->stride; j++) {
+                    if (C->values[j] != C_ref->values[j]) {
+                        printf("Error: The matrix mult result differs! (distance %zu, streaming %d)\n",
+                               PREFETCH_DISTANCES[d], STREAMING_STORES[s]);
+
+                        matrix_free(A);
+                        matrix_free(B);
+                        matrix_free(C);
+                        matrix_free(C_ref);
+
+                        return 1;
+                    }
+                }
+
+                matrix_free(C);
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C_ref);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_prefetch_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file matrix_mult_semiring_verification.c
+ *
+ * @brief Verifies matrix_multithread_mult_semiring() for every built-in
+ * semiring and a custom (max, min) semiring against a naive triple loop
+ * with the scalar operations of the semiring. The matrices hold the zero
+ * of the semiring at random positions (missing edges), and C starts with
+ * random values such that the accumulation into C is checked as well.
+ * A NaN product has to give the same result in the AVX and in the
+ * residual columns of the min and max semirings.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_semiring.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief The operations of the custom bottleneck (max, min) semiring.
+*/
+double max_op(double x, double y) { return (x > y) ? x : y; }
+double min_op(double x, double y) { return (x < y) ? x : y; }
+
+/**
+ * @brief Generate a Matrix with random values in [0, 100], of which
+ * about one in four is replaced by the given zero.
+*/
+Matrix* generate_semiring_matrix(size_t rows, size_t cols, double zero) {
+
+    Matrix* M = generate_matrix(0, 100, rows, cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (rand() % 4 == 0) {
+                M->values[r * M->stride + c] = zero;
+            }
+        }
+    }
+    return M;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_semiring_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUNS_PER_SEMIRING = 3;
+    const size_t BLOCK_SIZE = 40;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 150;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (SemiringType type = 0; type <= SEMIRING_CUSTOM; type++) {
+
+        Semiring s = semiring_get(type);
+        if (type == SEMIRING_CUSTOM) {
+            s.add = max_op;
+            s.multiply = min_op;
+            s.zero = 0.0;
+            s.one = INFINITY;
+        }
+
+        for (size_t i = 0; i < RUNS_PER_SEMIRING; i++) {
+
+            // Generate Matrix dimensions
+            const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+            const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+            const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+            printf("Semiring %d, iteration %zu (n %zu, m %zu, p %zu)\n", type, i, n, m, p);
+
+            // Generate matrices (C and C_naive start with the same values)
+            Matrix* A = generate_semiring_matrix(n, m, s.zero);
+            Matrix* B = generate_semiring_matrix(m, p, s.zero);
+            Matrix* C = generate_semiring_matrix(n, p, s.zero);
+            Matrix* C_naive = matrix_create_with(pattern_zero, NULL, n, p);
+
+            // The or-and results are 0 or 1, so the initial C has to be too
+            for (size_t r = 0; r < n; r++) {
+                for (size_t c = 0; c < p; c++) {
+                    if (type == SEMIRING_OR_AND) {
+                        C->values[r * C->stride + c] = (C->values[r * C->stride + c] != 0.0);
+                    }
+                    C_naive->values[r * C_naive->stride + c] = C->values[r * C->stride + c];
+                }
+            }
+
+            if (matrix_multithread_mult_semiring(A, B, C, s, BLOCK_SIZE, NUM_THREADS) != 0) {
+                printf("Error: matrix_multithread_mult_semiring() failed\n");
+                return 1;
+            }
+
+            for (size_t r = 0; r < n; r++) {
+                for (size_t c = 0; c < p; c++) {
+
+                    double expected = C_naive->values[r * C_naive->stride + c];
+                    for (size_t k = 0; k < m; k++) {
+                        expected = s.add(expected, s.multiply(A->values[r * A->stride + k], B->values[k * B->stride + c]));
+                    }
+
+                    double mine = C->values[r * C->stride + c];
+                    bool equal = (mine == expected) ||
+                                 fabs(mine - expected) <= APPROXIMATION_THRESHOLD * (1.0 + fabs(expected));
+                    if (!equal) {
+                        printf("Error: The semiring result differs at (%zu, %zu)!\n", r, c);
+                        printf("%-20s %f\n", "My implementation", mine);
+                        printf("%-20s %f\n", "Naive", expected);
+                        return 1;
+                    }
+                }
+            }
+
+            // Free the allocated data corresponding to this run
+            matrix_free(A);
+            matrix_free(B);
+            matrix_free(C);
+            matrix_free(C_naive);
+        }
+    }
+
+    // 8 AVX columns and a residual column, with a NaN in A
+    for (SemiringType type = SEMIRING_MIN_PLUS; type <= SEMIRING_MAX_TIMES; type++) {
+        Semiring s = semiring_get(type);
+        Matrix* A = matrix_create_with(pattern_zero, NULL, 1, 1);
+        Matrix* B = matrix_create_with(pattern_zero, NULL, 1, 9);
+        Matrix* C = matrix_create_with(pattern_zero, NULL, 1, 9);
+        A->values[0] = NAN;
+        for (size_t c = 0; c < 9; c++) {
+            B->values[c] = 1.0;
+            C->values[c] = s.zero;
+        }
+        if (matrix_multithread_mult_semiring(A, B, C, s, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_mult_semiring() failed\n");
+            return 1;
+        }
+        for (size_t c = 0; c < 9; c++) {
+            if (!isnan(C->values[c])) {
+                printf("Error: Semiring %d drops the NaN product in column %zu!\n", type, c);
+                return 1;
+            }
+        }
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_semiring_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file matrix_mult_stride_verification.c
+ *
+ * @brief Verifies that every Matrix multiplication algorithm honors the
+ * row stride when padded rows are enabled (matrix_set_padded_stride()).
+ * The result is compared against OpenBLAS called with the leading
+ * dimensions set to the row strides. The padding of the generated
+ * matrices has to be zero.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_singlethread.h"
+#include "../../src/cpu/matrix_multithread.h"
+#include "../../src/cpu/matrix_multithread_3avx.h"
+#include "../../src/cpu/matrix_multithread_9avx.h"
+#include "../../src/cpu/matrix_multithread_9avx_prefetch.h"
+#include "../../src/shared/matrix_utils.h"
+
+#define NUM_ALGORITHMS 6
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_stride_verification.c--------");
+
+    // Benchmark parameters
+    const size_t BLOCK_SIZE = 64;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+    // Power-of-two and odd dimensions (n = m = p)
+    const size_t DIMENSIONS[] = {7, 64, 100, 512};
+    const size_t NUM_DIMENSIONS = sizeof(DIMENSIONS) / sizeof(DIMENSIONS[0]);
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+    matrix_set_padded_stride(true);
+
+    for (size_t d = 0; d < NUM_DIMENSIONS; d++) {
+
+        const size_t dim = DIMENSIONS[d];
+        printf("Dimension %zu\n", dim);
+
+        // Generate matrices
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, dim, dim);
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, dim, dim);
+        if (A->stride != matrix_row_stride(dim) || A->stride % 8 != 0) {
+            printf("Error: Unexpected stride %zu for dimension %zu\n", A->stride, dim);
+            return 1;
+        }
+
+        // Only the elements are random, the padding is zero
+        for (size_t i = 0; i < dim; i++) {
+            for (size_t j = dim; j < A->stride; j++) {
+                if (A->values[i * A->stride + j] != 0.0 || B->values[i * B->stride + j] != 0.0) {
+                    printf("Error: The padding of row %zu is not zero for dimension %zu\n", i, dim);
+                    return 1;
+                }
+            }
+        }
+
+        // Reference result using the leading dimensions of the padded rows
+        Matrix* C_blas = matrix_create_with(pattern_zero, NULL, dim, dim);
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    dim, dim, dim, 1.0,
+                    A->values, A->stride,
+                    B->values, B->stride,
+                    0.0, C_blas->values, C_blas->stride);
+
+        for (size_t algo = 0; algo < NUM_ALGORITHMS; algo++) {
+
+            Matrix* C = matrix_create_with(pattern_zero, NULL, dim, dim);
+            switch (algo) {
+                case 0: matrix_mult_naive(A, B, C); break;
+                case 1: matrix_singlethread_mult(A, B, C, BLOCK_SIZE); break;
+                case 2: matrix_multithread_mult(A, B, C, BLOCK_SIZE, NUM_THREADS); break;
+                case 3: matrix_multithread_mult_3avx(A, B, C, BLOCK_SIZE, NUM_THREADS); break;
+                case 4: matrix_multithread_mult_9avx(A, B, C, BLOCK_SIZE, NUM_THREADS); break;
+                case 5: matrix_multithread_mult_9avx_prefetch(A, B, C, BLOCK_SIZE, NUM_THREADS, 64, true); break;
+            }
+
+            // Compare result (skipping the padding)
+            for (size_t i = 0; i < dim; i++) {
+                for (size_t j = 0; j < dim; j++) {
+                    double mine = C->values[i * C->stride + j];
+                    double blas = C_blas->values[i * C_blas->stride + j];
+                    if (fabs(mine - blas) > APPROXIMATION_THRESHOLD) {
+                        printf("Error: The matrix mult result differs for algorithm %zu!\n", algo);
+                        printf("%-20s %f\n", "My implementation", mine);
+                        printf("%-20s %f\n", "BLAS implementation", blas);
+                        return 1;
+                    }
+                }
+            }
+
+            matrix_free(C);
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C_blas);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_stride_verification.c--------");
+
+    return 0;
+}
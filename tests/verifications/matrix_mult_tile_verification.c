@@ -0,0 +1,133 @@
+/**
+ * @file matrix_mult_tile_verification.c
+ *
+ * @brief Verifies the tile-major conversions and
+ * matrix_multithread_mult_tile() against matrix_mult_naive(). The
+ * dimensions are not multiples of the tile size, such that the padded
+ * edge tiles are covered. Kernels and converters without tile-major
+ * support have to reject the tile-major matrices.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_tile.h"
+#include "../../src/shared/matrix_csr.h"
+#include "../../src/cpu/matrix_mult_naive.h"
+#include "../../src/cpu/matrix_multithread_tile.h"
+#include "../../src/cpu/matrix_multithread_oblivious.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_mult_tile_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t NUM_THREADS = 4;
+
+    // Matrix generation parameters
+    const double MIN = -10.0;
+    const double MAX = 10.0;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions and a tile size of 8 to 64
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t tile_size = TILE_SIZE_ALIGNMENT * random_between(1, 8);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, tile size %zu)\n", i, n, m, p, tile_size);
+
+        Matrix* A = generate_matrix(MIN, MAX, n, m);
+        Matrix* B = generate_matrix(MIN, MAX, m, p);
+        Matrix* C_initial = generate_matrix(MIN, MAX, n, p);
+        Matrix* C_naive = generate_matrix(MIN, MAX, n, p);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                C_naive->values[r * C_naive->stride + c] = C_initial->values[r * C_initial->stride + c];
+            }
+        }
+
+        Matrix* A_tile = matrix_to_tile_major(A, tile_size, NUM_THREADS);
+        Matrix* B_tile = matrix_to_tile_major(B, tile_size, NUM_THREADS);
+        Matrix* C_tile = matrix_to_tile_major(C_initial, tile_size, NUM_THREADS);
+        if (!A_tile || !B_tile || !C_tile) {
+            printf("Error: The conversion to tile-major failed\n");
+            return 1;
+        }
+
+        // The elements have to be found at matrix_tile_index() and the padding has to be zero
+        size_t num_tiles = (n + tile_size - 1) / tile_size * matrix_tile_num_cols(A_tile);
+        size_t num_non_zero = 0;
+        for (size_t k = 0; k < num_tiles * tile_size * tile_size; k++) {
+            num_non_zero += (A_tile->values[k] != 0.0);
+        }
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < m; c++) {
+                num_non_zero -= (A->values[r * A->stride + c] != 0.0);
+                if (A_tile->values[matrix_tile_index(A_tile, r, c)] != A->values[r * A->stride + c]) {
+                    printf("Error: The tile-major element (%zu, %zu) differs!\n", r, c);
+                    return 1;
+                }
+            }
+        }
+        if (num_non_zero != 0) {
+            printf("Error: The padding of the tiles is not zero!\n");
+            return 1;
+        }
+
+        if (matrix_multithread_mult_tile(A_tile, B_tile, C_tile, NUM_THREADS) != 0) {
+            printf("Error: The tile-major multiplication failed\n");
+            return 1;
+        }
+        matrix_mult_naive(A, B, C_naive);
+
+        // The values are integers, so the products have to be exact
+        Matrix* C = matrix_from_tile_major(C_tile, NUM_THREADS);
+        if (!C) {
+            printf("Error: The conversion from tile-major failed\n");
+            return 1;
+        }
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = C->values[r * C->stride + c];
+                double naive = C_naive->values[r * C_naive->stride + c];
+                if (mine != naive) {
+                    printf("Error: The tile-major product differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Naive", naive);
+                    return 1;
+                }
+            }
+        }
+
+        // Row-major only code has to reject the tile-major matrices
+        if (matrix_multithread_mult_oblivious(A_tile, B_tile, C_tile, NUM_THREADS) != -1 ||
+            matrix_to_csr(A_tile) != NULL) {
+            printf("Error: A tile-major Matrix was not rejected!\n");
+            return 1;
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(C_initial);
+        matrix_free(C_naive);
+        matrix_free(A_tile);
+        matrix_free(B_tile);
+        matrix_free(C_tile);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_mult_tile_verification.c--------");
+
+    return 0;
+}
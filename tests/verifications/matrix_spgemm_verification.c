@@ -0,0 +1,128 @@
+/**
+ * @file matrix_spgemm_verification.c
+ *
+ * @brief Verifies matrix_multithread_spgemm() with both accumulators
+ * against OpenBLAS (cblas_dgemm on the dense forms of A and B). The
+ * result has to be a valid CSR Matrix with strictly increasing columns
+ * per row, whose nonzeros cover every nonzero of the dense product.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_csr.h"
+#include "../../src/cpu/matrix_multithread_spgemm.h"
+#include "../../src/shared/matrix_utils.h"
+
+/**
+ * @brief Generate a dense Matrix where each element is nonzero with the
+ * given percentage, every fifth row being empty.
+ */
+Matrix* generate_sparse(size_t rows, size_t cols, int density) {
+
+    Matrix* M = generate_matrix(-1e+3, 1e+3, rows, cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (r % 5 == 4 || rand() % 100 >= density) {
+                M->values[r * M->stride + c] = 0.0;
+            }
+        }
+    }
+    return M;
+}
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_spgemm_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 200;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        SpgemmAccumulator accumulator = i % SPGEMM_NUM_ACCUMULATORS;
+
+        // Generate Matrix dimensions and the percentage of nonzeros
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const int density = random_between(1, 20);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, density %d%%, accumulator %d)\n", i, n, m, p, density, accumulator);
+
+        Matrix* A_dense = generate_sparse(n, m, density);
+        Matrix* B_dense = generate_sparse(m, p, density);
+        Matrix* C_blas = matrix_create_with(pattern_zero, NULL, n, p);
+        MatrixCSR* A = matrix_to_csr(A_dense);
+        MatrixCSR* B = matrix_to_csr(B_dense);
+
+        MatrixCSR* C = matrix_multithread_spgemm(A, B, accumulator, NUM_THREADS);
+        if (!C) {
+            printf("Error: matrix_multithread_spgemm() failed\n");
+            return 1;
+        }
+
+        // Check the CSR structure
+        if (C->num_rows != n || C->num_cols != p || C->row_ptr[0] != 0 || C->row_ptr[n] != C->nnz) {
+            printf("Error: The CSR result has an invalid shape or row_ptr\n");
+            return 1;
+        }
+        for (size_t r = 0; r < n; r++) {
+            for (size_t index = C->row_ptr[r]; index < C->row_ptr[r + 1]; index++) {
+                if (C->col_indices[index] >= p ||
+                    (index > C->row_ptr[r] && C->col_indices[index - 1] >= C->col_indices[index])) {
+                    printf("Error: The columns of row %zu are not strictly increasing\n", r);
+                    return 1;
+                }
+            }
+        }
+
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    n, p, m, 1.0,
+                    A_dense->values, A_dense->stride,
+                    B_dense->values, B_dense->stride,
+                    0.0, C_blas->values, C_blas->stride);
+
+        // Compare the values (missing entries are zero)
+        Matrix* C_dense = matrix_from_csr(C);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = C_dense->values[r * C_dense->stride + c];
+                double expected = C_blas->values[r * C_blas->stride + c];
+                if (fabs(mine - expected) > APPROXIMATION_THRESHOLD * (1.0 + fabs(expected))) {
+                    printf("Error: The spgemm result differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "OpenBLAS", expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_csr_free(A);
+        matrix_csr_free(B);
+        matrix_csr_free(C);
+        matrix_free(A_dense);
+        matrix_free(B_dense);
+        matrix_free(C_blas);
+        matrix_free(C_dense);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_spgemm_verification.c--------");
+
+    return 0;
+}
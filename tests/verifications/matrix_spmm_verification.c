@@ -0,0 +1,126 @@
+/**
+ * @file matrix_spmm_verification.c
+ *
+ * @brief Verifies the CSR conversions and matrix_multithread_spmm()
+ * against OpenBLAS (cblas_dgemm on the dense form of A). The sparse
+ * matrices have a random density, with some empty rows and one full row
+ * to skew the nonzeros per row.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/shared/matrix_csr.h"
+#include "../../src/cpu/matrix_multithread_spmm.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_spmm_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Generate Matrix dimensions and the percentage of nonzeros (0 for the first run)
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const int density = (i == 0) ? 0 : random_between(1, 30);
+        printf("Iteration %zu (n %zu, m %zu, p %zu, density %d%%)\n", i, n, m, p, density);
+
+        // Generate the sparse A in dense form: every third row is empty, the middle row is full
+        Matrix* A_dense = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < m; c++) {
+                bool keep = (r % 3 != 2) && (rand() % 100 < density);
+                if (density > 0 && r == n / 2) {
+                    keep = true;
+                }
+                if (!keep) {
+                    A_dense->values[r * A_dense->stride + c] = 0.0;
+                }
+            }
+        }
+
+        // Generate B and C (C and C_blas start with the same values)
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, m, p);
+        Matrix* C = generate_matrix(VALUES_MIN, VALUES_MAX, n, p);
+        Matrix* C_blas = matrix_create_with(pattern_zero, NULL, n, p);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                C_blas->values[r * C_blas->stride + c] = C->values[r * C->stride + c];
+            }
+        }
+
+        // The conversion has to be lossless
+        MatrixCSR* A = matrix_to_csr(A_dense);
+        Matrix* A_back = matrix_from_csr(A);
+        if (!A || !A_back) {
+            printf("Error: The CSR conversion failed\n");
+            return 1;
+        }
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < m; c++) {
+                if (A_back->values[r * A_back->stride + c] != A_dense->values[r * A_dense->stride + c]) {
+                    printf("Error: The CSR round trip differs at (%zu, %zu)!\n", r, c);
+                    return 1;
+                }
+            }
+        }
+
+        if (matrix_multithread_spmm(A, B, C, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_spmm() failed\n");
+            return 1;
+        }
+
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    n, p, m, 1.0,
+                    A_dense->values, A_dense->stride,
+                    B->values, B->stride,
+                    1.0, C_blas->values, C_blas->stride);
+
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = C->values[r * C->stride + c];
+                double expected = C_blas->values[r * C_blas->stride + c];
+                if (fabs(mine - expected) > APPROXIMATION_THRESHOLD * (1.0 + fabs(expected))) {
+                    printf("Error: The spmm result differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "OpenBLAS", expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_csr_free(A);
+        matrix_free(A_back);
+        matrix_free(A_dense);
+        matrix_free(B);
+        matrix_free(C);
+        matrix_free(C_blas);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_spmm_verification.c--------");
+
+    return 0;
+}
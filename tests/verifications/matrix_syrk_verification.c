@@ -0,0 +1,106 @@
+/**
+ * @file matrix_syrk_verification.c
+ *
+ * @brief Verifies matrix_multithread_syrk() against OpenBLAS (A * A^T
+ * through cblas_dgemm with B transposed). Without mirroring, the strict
+ * upper triangle of C has to keep its initial values; with mirroring it
+ * has to equal the lower triangle.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_syrk.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_syrk_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 10;
+    const size_t BLOCK_SIZE = 48;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+3;
+    const double VALUES_MAX = 1e+3;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 300;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        bool mirror = (i % 2 == 1);
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t m = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        printf("Iteration %zu (n %zu, m %zu, mirror %d)\n", i, n, m, mirror);
+
+        // Generate matrices (C and C_blas start with the same values)
+        Matrix* A = generate_matrix(VALUES_MIN, VALUES_MAX, n, m);
+        Matrix* C = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+        Matrix* C_blas = matrix_create_with(pattern_zero, NULL, n, n);
+        Matrix* C_initial = matrix_create_with(pattern_zero, NULL, n, n);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < n; c++) {
+                C_blas->values[r * C_blas->stride + c] = C->values[r * C->stride + c];
+                C_initial->values[r * C_initial->stride + c] = C->values[r * C->stride + c];
+            }
+        }
+
+        if (matrix_multithread_syrk(A, C, mirror, BLOCK_SIZE, NUM_THREADS) != 0) {
+            printf("Error: matrix_multithread_syrk() failed\n");
+            return 1;
+        }
+
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                    n, n, m, 1.0,
+                    A->values, A->stride,
+                    A->values, A->stride,
+                    1.0, C_blas->values, C_blas->stride);
+
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < n; c++) {
+
+                // Lower triangle against BLAS, upper triangle against the mirror or the initial value
+                double mine = C->values[r * C->stride + c];
+                double expected;
+                if (c <= r) {
+                    expected = C_blas->values[r * C_blas->stride + c];
+                } else if (mirror) {
+                    expected = C->values[c * C->stride + r];
+                } else {
+                    expected = C_initial->values[r * C_initial->stride + c];
+                }
+
+                if (fabs(mine - expected) > APPROXIMATION_THRESHOLD * (1.0 + fabs(expected))) {
+                    printf("Error: The syrk result differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %f\n", "My implementation", mine);
+                    printf("%-20s %f\n", "Expected", expected);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(A);
+        matrix_free(C);
+        matrix_free(C_blas);
+        matrix_free(C_initial);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_syrk_verification.c--------");
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file matrix_triangular_verification.c
+ *
+ * @brief Verifies matrix_multithread_trmm() and matrix_multithread_trsm()
+ * against cblas_dtrmm and cblas_dtrsm for both triangles, with and
+ * without unit diagonal. The triangle of T that is not used is filled
+ * with random values to verify that it is never read.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <cblas.h>
+#include "../../src/shared/matrix.h"
+#include "../../src/cpu/matrix_multithread_triangular.h"
+#include "../../src/shared/matrix_utils.h"
+
+int main() {
+
+    printf("%s\n", "--------STARTING matrix_triangular_verification.c--------");
+
+    // Benchmark parameters
+    const size_t RUN_COUNT = 16;
+    const size_t BLOCK_SIZE = 40;
+    const size_t NUM_THREADS = 4;
+    // Used if there are different rounding errors between the implementations
+    const double APPROXIMATION_THRESHOLD = 1e-9;
+
+    // Matrix generation parameters
+    const double VALUES_MIN = -1e+1;
+    const double VALUES_MAX = 1e+1;
+    const size_t DIMENSIONS_MIN = 1;
+    const size_t DIMENSIONS_MAX = 250;
+    const int seed = 42;
+
+    // Set the seed for reproducibility
+    srand(seed);
+
+    for (size_t i = 0; i < RUN_COUNT; i++) {
+
+        // Cycle through all combinations
+        bool is_solve = (i % 2 == 1);
+        TriangleType uplo = (i % 4 < 2) ? TRIANGLE_LOWER : TRIANGLE_UPPER;
+        bool unit_diagonal = (i % 8 >= 4);
+
+        // Generate Matrix dimensions
+        const size_t n = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        const size_t p = random_between(DIMENSIONS_MIN, DIMENSIONS_MAX);
+        printf("Iteration %zu (n %zu, p %zu, %s, %s, unit %d)\n", i, n, p,
+               is_solve ? "trsm" : "trmm", (uplo == TRIANGLE_LOWER) ? "lower" : "upper", unit_diagonal);
+
+        // A dominant diagonal keeps the solve well-conditioned
+        Matrix* T = generate_matrix(VALUES_MIN, VALUES_MAX, n, n);
+        for (size_t d = 0; d < n; d++) {
+            T->values[d * T->stride + d] = (d % 2 == 0 ? 1.0 : -1.0) * (VALUES_MAX * n + 1.0);
+        }
+        Matrix* B = generate_matrix(VALUES_MIN, VALUES_MAX, n, p);
+        Matrix* B_blas = matrix_create_with(pattern_zero, NULL, n, p);
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                B_blas->values[r * B_blas->stride + c] = B->values[r * B->stride + c];
+            }
+        }
+
+        int result = is_solve
+            ? matrix_multithread_trsm(T, B, uplo, unit_diagonal, BLOCK_SIZE, NUM_THREADS)
+            : matrix_multithread_trmm(T, B, uplo, unit_diagonal, BLOCK_SIZE, NUM_THREADS);
+        if (result != 0) {
+            printf("Error: The triangular routine failed\n");
+            return 1;
+        }
+
+        CBLAS_UPLO blas_uplo = (uplo == TRIANGLE_LOWER) ? CblasLower : CblasUpper;
+        CBLAS_DIAG blas_diag = unit_diagonal ? CblasUnit : CblasNonUnit;
+        if (is_solve) {
+            cblas_dtrsm(CblasRowMajor, CblasLeft, blas_uplo, CblasNoTrans, blas_diag,
+                        n, p, 1.0, T->values, T->stride, B_blas->values, B_blas->stride);
+        } else {
+            cblas_dtrmm(CblasRowMajor, CblasLeft, blas_uplo, CblasNoTrans, blas_diag,
+                        n, p, 1.0, T->values, T->stride, B_blas->values, B_blas->stride);
+        }
+
+        for (size_t r = 0; r < n; r++) {
+            for (size_t c = 0; c < p; c++) {
+                double mine = B->values[r * B->stride + c];
+                double blas = B_blas->values[r * B_blas->stride + c];
+                if (fabs(mine - blas) > APPROXIMATION_THRESHOLD * (1.0 + fabs(blas))) {
+                    printf("Error: The result differs at (%zu, %zu)!\n", r, c);
+                    printf("%-20s %.17g\n", "My implementation", mine);
+                    printf("%-20s %.17g\n", "BLAS implementation", blas);
+                    return 1;
+                }
+            }
+        }
+
+        // Free the allocated data corresponding to this run
+        matrix_free(T);
+        matrix_free(B);
+        matrix_free(B_blas);
+    }
+
+    printf("%s\n", "All calculations are correct");
+    printf("%s\n", "--------FINISHED matrix_triangular_verification.c--------");
+
+    return 0;
+}